@@ -506,6 +506,7 @@ void GenerateEdges(edgeset& out, LPD3DXMESH mesh)
 	D3DXVECTOR3	p1, p2, p3;
 	D3DXVECTOR3	a, b, n;
 	Edge		e;
+	edgelist	edges;
 	BYTE*		vdata		= 0;
 	WORD*		idata		= 0;
 	size_t		ind;
@@ -526,13 +527,11 @@ void GenerateEdges(edgeset& out, LPD3DXMESH mesh)
 	mesh->LockIndexBuffer(D3DLOCK_READONLY, (LPVOID*)&idata);
 	mesh->LockVertexBuffer(D3DLOCK_READONLY, (LPVOID*)&vdata);
 
-	out.reserve(512);
+	// collect first, then sort once
+	edges.reserve(numindices);
 
 	for( DWORD i = 0; i < numindices; i += 3 )
 	{
-		if( out.capacity() <= out.size() )
-			out.reserve(out.size() + 1024);
-
 		i1 = idata[i + 0];
 		i2 = idata[i + 1];
 		i3 = idata[i + 2];
@@ -555,8 +554,7 @@ void GenerateEdges(edgeset& out, LPD3DXMESH mesh)
 			e.v2 = p2;
 			e.n1 = n;
 
-			if( !out.insert(e).second )
-				std::cout << "Crack in mesh (first triangle)\n";
+			edges.push_back(e);
 		}
 
 		if( i2 < i3 )
@@ -567,8 +565,7 @@ void GenerateEdges(edgeset& out, LPD3DXMESH mesh)
 			e.v2 = p3;
 			e.n1 = n;
 
-			if( !out.insert(e).second )
-				std::cout << "Crack in mesh (first triangle)\n";
+			edges.push_back(e);
 		}
 
 		if( i3 < i1 )
@@ -579,11 +576,15 @@ void GenerateEdges(edgeset& out, LPD3DXMESH mesh)
 			e.v2 = p1;
 			e.n1 = n;
 
-			if( !out.insert(e).second )
-				std::cout << "Crack in mesh (first triangle)\n";
+			edges.push_back(e);
 		}
 	}
 
+	out.assign(edges.begin(), edges.end());
+
+	if( out.size() < edges.size() )
+		std::cout << "Crack in mesh (first triangle): " << edges.size() - out.size() << " duplicate edges\n";
+
 	// find second triangle for each edge
 	for( DWORD i = 0; i < numindices; i += 3 )
 	{
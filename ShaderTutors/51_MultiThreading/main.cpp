@@ -8,6 +8,7 @@
 #pragma comment(lib, "GdiPlus.lib")
 
 #include <iostream>
+#include <cstring>
 
 #define _CRTDBG_MAP_ALLOC
 #include <stdlib.h>
@@ -36,6 +37,11 @@ extern void Window3_Created(Win32Window*);
 extern void Window3_Closing(Win32Window*);
 extern void Window3_Render(Win32Window*, float, float);
 
+// in threadbenchmark.cpp
+extern void ContentionBenchmark();
+extern void JobBenchmark();
+extern void QueueBenchmark();
+
 RECT			workarea;
 LONG			wawidth;
 LONG			waheight;
@@ -96,6 +102,14 @@ void THREAD3_Run()
 
 int main(int argc, char* argv[])
 {
+	if( argc > 1 && strcmp(argv[1], "-benchmark") == 0 )
+	{
+		ContentionBenchmark();
+		JobBenchmark();
+		QueueBenchmark();
+		return 0;
+	}
+
 	SystemParametersInfo(SPI_GETWORKAREA, 0, &workarea, 0);
 
 	wawidth = workarea.right - workarea.left;
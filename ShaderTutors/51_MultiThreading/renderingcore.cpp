@@ -677,29 +677,40 @@ bool RenderingCore::SetupCoreProfile()
 
 void RenderingCore::THREAD_Run()
 {
+	std::vector<IRenderingTask*> batch;
+
 	while( true )
 	{
-		IRenderingTask* action = tasks.pop();
-
-		if( action == 0 ) {
-			// exit call
-			break;
-		} else if( action->GetUniverseID() == -3 ) {
-			// barrier task
-			action->Execute(0);
-		} else if( action->GetUniverseID() == -2 ) {
-			// context creator task
-			action->Execute(privinterf);
-		} else if( privinterf->ActivateContext(action->GetUniverseID()) ) {
-			// rendering task
-			action->Execute(privinterf);
-		}
+		// wait for one, then take everything that is already queued
+		batch.clear();
+		batch.push_back(tasks.pop());
 
-		if( action->IsMarkedForDispose() ) {
-			action->Dispose();
+		tasks.pop_all(batch);
 
-			delete action;
-			action = 0;
+		for( size_t i = 0; i < batch.size(); ++i )
+		{
+			IRenderingTask* action = batch[i];
+
+			if( action == 0 ) {
+				// exit call
+				return;
+			} else if( action->GetUniverseID() == -3 ) {
+				// barrier task
+				action->Execute(0);
+			} else if( action->GetUniverseID() == -2 ) {
+				// context creator task
+				action->Execute(privinterf);
+			} else if( privinterf->ActivateContext(action->GetUniverseID()) ) {
+				// rendering task
+				action->Execute(privinterf);
+			}
+
+			if( action->IsMarkedForDispose() ) {
+				action->Dispose();
+
+				delete action;
+				action = 0;
+			}
 		}
 	}
 }
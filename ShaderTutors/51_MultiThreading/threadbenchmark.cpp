@@ -0,0 +1,469 @@
+
+// also builds without the rest of the sample:
+// g++ -O2 -std=c++11 -pthread threadbenchmark.cpp ../common/thread.cpp ../common/jobsystem.cpp
+
+#include <cstdio>
+#include <cmath>
+#include "../common/blockingqueue.hpp"
+#include "../common/jobsystem.h"
+
+#ifndef _WIN32
+#	include <chrono>
+#endif
+
+#define BENCHMARK_ITEMS		(1 << 20)	// shared by the producers
+#define BENCHMARK_MAX_PAIRS	16			// producer-consumer pairs (so 32 threads)
+#define BENCHMARK_LOCKS		(1 << 20)	// shared by the threads
+#define BENCHMARK_MAX_THREADS	32
+#define BENCHMARK_PARTICLES		(1 << 18)
+#define BENCHMARK_FRAMES		50
+#define PARTICLES_PER_JOB		1024
+
+// the previous implementation (lock + heap node per item), for comparison
+template <typename value_type>
+class lockedqueue
+{
+	struct node
+	{
+		value_type value;
+		node* next;
+	};
+
+private:
+	Guard	guard;
+	Signal	notempty;
+	node	head;
+	node*	last;
+	size_t	mysize;
+
+public:
+	lockedqueue()
+	{
+		head.next	= &head;
+		last		= &head;
+		mysize		= 0;
+
+		notempty.Halt();
+	}
+
+	~lockedqueue()
+	{
+		node* q = head.next;
+		node* p;
+
+		while( q != &head )
+		{
+			p = q->next;
+			delete q;
+			q = p;
+		}
+	}
+
+	void push(const value_type& value)
+	{
+		guard.Lock();
+		{
+			last->next = new node();
+			last->next->value = value;
+
+			last = last->next;
+			last->next = &head;
+
+			++mysize;
+			notempty.Fire();
+		}
+		guard.Unlock();
+	}
+
+	value_type pop()
+	{
+		value_type val;
+		bool popped = false;
+
+		do
+		{
+			notempty.Wait();
+
+			guard.Lock();
+			{
+				if( mysize > 0 )
+				{
+					node* q = head.next;
+					head.next = q->next;
+					val = q->value;
+
+					delete q;
+					--mysize;
+
+					if( mysize == 0 )
+						last = &head;
+
+					popped = true;
+				}
+
+				if( mysize == 0 )
+					notempty.Halt();
+			}
+			guard.Unlock();
+		}
+		while( !popped );
+
+		return val;
+	}
+};
+
+template <typename queue_type>
+class QueueWorker
+{
+public:
+	queue_type*	queue;
+	size_t		count;
+	size_t		sum;
+
+	QueueWorker()
+		: queue(0), count(0), sum(0) {}
+
+	void Produce()
+	{
+		// zero means stop
+		for( size_t i = 1; i <= count; ++i )
+			queue->push(i);
+	}
+
+	void Consume()
+	{
+		size_t value;
+
+		while( (value = queue->pop()) != 0 )
+			sum += value;
+	}
+
+	void ConsumeBatch()
+	{
+		std::vector<size_t> batch;
+		size_t stops = 0;
+
+		while( stops == 0 )
+		{
+			batch.clear();
+			batch.push_back(queue->pop());
+
+			queue->pop_all(batch);
+
+			for( size_t i = 0; i < batch.size(); ++i )
+			{
+				if( batch[i] == 0 )
+					++stops;
+				else
+					sum += batch[i];
+			}
+		}
+
+		// give back the ones meant for other consumers
+		for( size_t i = 1; i < stops; ++i )
+			queue->push(0);
+	}
+};
+
+// simple test-and-set lock, for comparison
+class SpinLock
+{
+private:
+	AtomicSize locked;
+
+public:
+	inline void Lock()
+	{
+		size_t expected = 0;
+
+		while( !locked.CompareExchange(expected, 1) )
+		{
+			expected = 0;
+			Thread::YieldCPU();
+		}
+	}
+
+	inline void Unlock() {
+		locked.Store(0);
+	}
+};
+
+template <typename lock_type>
+class LockWorker
+{
+public:
+	lock_type*	lock;
+	size_t*		counter;
+	size_t		count;
+
+	LockWorker()
+		: lock(0), counter(0), count(0) {}
+
+	void Run()
+	{
+		volatile size_t local = 0;
+
+		for( size_t i = 0; i < count; ++i )
+		{
+			lock->Lock();
+			++(*counter);
+			lock->Unlock();
+
+			// some work outside the lock
+			for( int j = 0; j < 20; ++j )
+				local = local + j;
+		}
+	}
+};
+
+struct BenchmarkParticle
+{
+	float position[4];
+	float velocity[4];
+};
+
+// same kind of work as the light particles in the samples
+static void IntegrateParticles(void* args, size_t begin, size_t end)
+{
+	BenchmarkParticle* particles = (BenchmarkParticle*)args;
+	const float dt = 1.0f / 60.0f;
+
+	for( size_t i = begin; i < end; ++i )
+	{
+		BenchmarkParticle& p = particles[i];
+
+		for( int j = 0; j < 3; ++j )
+		{
+			p.position[j] += p.velocity[j] * dt;
+
+			// bounce off the walls of the box
+			if( fabs(p.position[j]) > 10.0f )
+			{
+				p.position[j] = (p.position[j] > 0 ? 10.0f : -10.0f);
+				p.velocity[j] = -p.velocity[j];
+			}
+		}
+
+		// keep the speed
+		float length = sqrtf(p.velocity[0] * p.velocity[0] + p.velocity[1] * p.velocity[1] + p.velocity[2] * p.velocity[2]);
+		float scale = p.velocity[3] / length;
+
+		p.velocity[0] *= scale;
+		p.velocity[1] *= scale;
+		p.velocity[2] *= scale;
+	}
+}
+
+static double GetSeconds()
+{
+#ifdef _WIN32
+	LARGE_INTEGER freq, now;
+
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+
+	return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+template <typename lock_type>
+static double RunContentionBenchmark(size_t numthreads)
+{
+	typedef LockWorker<lock_type> worker;
+
+	lock_type	lock;
+	worker*		workers = new worker[numthreads];
+	Thread*		threads = new Thread[numthreads];
+	size_t		counter = 0;
+	size_t		expected = 0;
+
+	for( size_t i = 0; i < numthreads; ++i )
+	{
+		workers[i].lock = &lock;
+		workers[i].counter = &counter;
+		workers[i].count = BENCHMARK_LOCKS / numthreads;
+
+		threads[i].Attach(&workers[i], &worker::Run);
+		expected += workers[i].count;
+	}
+
+	double start = GetSeconds();
+
+	for( size_t i = 0; i < numthreads; ++i )
+		threads[i].Start();
+
+	for( size_t i = 0; i < numthreads; ++i )
+		threads[i].Wait();
+
+	double elapsed = GetSeconds() - start;
+
+	if( counter != expected )
+		printf("* Error: lock is broken!\n");
+
+	delete[] threads;
+	delete[] workers;
+
+	// million locks per second
+	return expected / (elapsed * 1e6);
+}
+
+template <typename queue_type>
+static double RunQueueBenchmark(size_t pairs, void (QueueWorker<queue_type>::*consume)())
+{
+	typedef QueueWorker<queue_type> worker;
+
+	queue_type	queue;
+	worker*		producers = new worker[pairs];
+	worker*		consumers = new worker[pairs];
+	Thread*		threads = new Thread[pairs * 2];
+	size_t		expected = 0;
+	size_t		sum = 0;
+
+	for( size_t i = 0; i < pairs; ++i )
+	{
+		producers[i].queue = &queue;
+		producers[i].count = BENCHMARK_ITEMS / pairs;
+
+		consumers[i].queue = &queue;
+
+		threads[i].Attach(&producers[i], &worker::Produce);
+		threads[pairs + i].Attach(&consumers[i], consume);
+
+		expected += producers[i].count * (producers[i].count + 1) / 2;
+	}
+
+	double start = GetSeconds();
+
+	for( size_t i = 0; i < pairs * 2; ++i )
+		threads[i].Start();
+
+	for( size_t i = 0; i < pairs; ++i )
+		threads[i].Wait();
+
+	for( size_t i = 0; i < pairs; ++i )
+		queue.push(0);
+
+	for( size_t i = pairs; i < pairs * 2; ++i )
+		threads[i].Wait();
+
+	double elapsed = GetSeconds() - start;
+
+	for( size_t i = 0; i < pairs; ++i )
+		sum += consumers[i].sum;
+
+	if( sum != expected )
+		printf("* Error: lost items!\n");
+
+	delete[] threads;
+	delete[] consumers;
+	delete[] producers;
+
+	// million items per second
+	return ((BENCHMARK_ITEMS / pairs) * pairs) / (elapsed * 1e6);
+}
+
+void ContentionBenchmark()
+{
+	printf("Lock contention (M locks/s, %d locks)\n\n", BENCHMARK_LOCKS);
+	printf("threads\tGuard\tspinlock\n");
+
+	for( size_t numthreads = 1; numthreads <= BENCHMARK_MAX_THREADS; numthreads *= 2 )
+	{
+		double guard	= RunContentionBenchmark<Guard>(numthreads);
+		double spinlock	= RunContentionBenchmark<SpinLock>(numthreads);
+
+		printf("%u\t%.2f\t%.2f\n", (unsigned int)numthreads, guard, spinlock);
+	}
+
+	printf("\n");
+}
+
+void JobBenchmark()
+{
+	BenchmarkParticle* particles = new BenchmarkParticle[BENCHMARK_PARTICLES];
+	double serial = 0;
+
+	printf("Job system scaling (ms per frame, %d particles)\n\n", BENCHMARK_PARTICLES);
+	printf("threads\tms\tspeedup\n");
+
+	for( size_t numthreads = 1; numthreads <= BENCHMARK_MAX_THREADS; numthreads *= 2 )
+	{
+		for( int i = 0; i < BENCHMARK_PARTICLES; ++i )
+		{
+			BenchmarkParticle& p = particles[i];
+
+			for( int j = 0; j < 3; ++j )
+			{
+				p.position[j] = (float)((i * (j + 7)) % 200) * 0.1f - 10.0f;
+				p.velocity[j] = (float)((i * (j + 3)) % 100) * 0.1f - 5.0f;
+			}
+
+			p.velocity[3] = sqrtf(p.velocity[0] * p.velocity[0] + p.velocity[1] * p.velocity[1] + p.velocity[2] * p.velocity[2]) + 1e-3f;
+		}
+
+		double elapsed;
+
+		if( numthreads == 1 )
+		{
+			// without the job system, but in the same slices
+			double start = GetSeconds();
+
+			for( int i = 0; i < BENCHMARK_FRAMES; ++i )
+			{
+				for( size_t j = 0; j < BENCHMARK_PARTICLES; j += PARTICLES_PER_JOB )
+					IntegrateParticles(particles, j, j + PARTICLES_PER_JOB);
+			}
+
+			elapsed = GetSeconds() - start;
+			serial = elapsed;
+		}
+		else
+		{
+			JobSystem jobsystem(numthreads - 1, true);
+			double start = GetSeconds();
+
+			for( int i = 0; i < BENCHMARK_FRAMES; ++i )
+			{
+				JobCounter counter;
+
+				jobsystem.ParallelFor(&IntegrateParticles, particles, 0, BENCHMARK_PARTICLES, PARTICLES_PER_JOB, &counter);
+				jobsystem.Wait(&counter);
+			}
+
+			elapsed = GetSeconds() - start;
+		}
+
+		printf("%u\t%.3f\t%.2f\n", (unsigned int)numthreads, (elapsed * 1000.0) / BENCHMARK_FRAMES, serial / elapsed);
+	}
+
+	printf("\n");
+	delete[] particles;
+}
+
+void QueueBenchmark()
+{
+	printf("Producer/consumer throughput (M items/s, %d items)\n\n", BENCHMARK_ITEMS);
+	printf("threads\tlocked\tlockfree\tlockfree + pop_all\n");
+
+	for( size_t pairs = 1; pairs <= BENCHMARK_MAX_PAIRS; pairs *= 2 )
+	{
+		double locked	= RunQueueBenchmark<lockedqueue<size_t> >(pairs, &QueueWorker<lockedqueue<size_t> >::Consume);
+		double lockfree	= RunQueueBenchmark<blockingqueue<size_t> >(pairs, &QueueWorker<blockingqueue<size_t> >::Consume);
+		double batched	= RunQueueBenchmark<blockingqueue<size_t> >(pairs, &QueueWorker<blockingqueue<size_t> >::ConsumeBatch);
+
+		printf("%u\t%.2f\t%.2f\t\t%.2f\n", (unsigned int)(pairs * 2), locked, lockfree, batched);
+	}
+}
+
+#ifndef _WIN32
+int main()
+{
+	ContentionBenchmark();
+	JobBenchmark();
+	QueueBenchmark();
+
+	return 0;
+}
+#endif
@@ -4,10 +4,12 @@
 
 #include "../common/vkx.h"
 #include "../common/spectatorcamera.h"
+#include "../common/jobsystem.h"
 
 #define METERS_PER_UNIT					0.01f
 #define NUM_LIGHTS						512
 #define LIGHT_RADIUS					2.0f
+#define PARTICLES_PER_JOB				64
 
 #define UNIFORM_BUFFER_SIZE				2048
 #define GBUFFER_PASS_UNIFORM_OFFSET		0
@@ -57,6 +59,14 @@ struct LightParticle {
 	float		radius;
 };
 
+struct ParticleUpdateArgs {
+	const LightParticle*	readparticles;
+	LightParticle*			writeparticles;
+	float					planes[6][4];
+	float					dt;
+	uint32_t				seed;			// per frame, every slice derives its own from it
+};
+
 VkRenderPass			mainrenderpass		= 0;
 VkFramebuffer*			framebuffers		= 0;
 
@@ -86,6 +96,7 @@ VulkanImage*			supplytexture		= 0;
 VulkanImage*			supplynormalmap		= 0;
 VulkanImage*			ambientcube			= 0;
 VulkanFramePump*		framepump			= 0;
+JobSystem*				jobsystem			= 0;
 VulkanAABox				particlevolume(-13.2f, 2.0f, -5.7f, 13.2f, 14.4f, 5.7f);
 
 SpectatorCamera			camera;
@@ -98,6 +109,7 @@ void InitializeTonemapPass();
 void InitializeFlaresPass();
 
 void GenerateParticles();
+void IntegrateParticles(void* args, size_t begin, size_t end);
 void UpdateParticles(float dt);
 
 bool InitScene()
@@ -118,6 +130,7 @@ bool InitScene()
 	VkResult				res;
 
 	framepump = new VulkanFramePump();
+	jobsystem = new JobSystem();
 
 	// create main render pass
 	VkFormat depthformat = VK_FORMAT_D24_UNORM_S8_UINT;
@@ -680,6 +693,7 @@ void UninitScene()
 		vkDestroyRenderPass(driverinfo.device, mainrenderpass, 0);
 
 	VK_SAFE_DELETE(framepump);
+	VK_SAFE_DELETE(jobsystem);
 }
 
 void GenerateParticles()
@@ -738,36 +752,42 @@ void GenerateParticles()
 	VulkanSubmitTempCommandBuffer(copycmd, false);
 }
 
-void UpdateParticles(float dt)
+static uint32_t ParticleRandom(uint32_t& state)
+{
+	// xorshift, rand() is not thread safe
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+
+	return state;
+}
+
+void IntegrateParticles(void* args, size_t begin, size_t end)
 {
+	ParticleUpdateArgs* update = (ParticleUpdateArgs*)args;
+
 	float vy[3];
 	float vx[3], vz[3];
 	float b[3];
 	float A[16], Ainv[16];
-	float planes[6][4];
 	float denom, energy;
 	float toi, besttoi;
 	float impulse, noise;
 	float (*bestplane)[4];
 	bool pastcollision;
 
-	particlevolume.GetPlanes(planes);
-
-	uint32_t prevphysicsframe = (currentphysicsframe + VK_NUM_QUEUED_FRAMES - 1) % VK_NUM_QUEUED_FRAMES;
-
-	LightParticle* particles = (LightParticle*)lightbuffer->MapContents(0, 0);
-	LightParticle* readparticles = particles + prevphysicsframe * NUM_LIGHTS;
-	LightParticle* writeparticles = particles + currentphysicsframe * NUM_LIGHTS;
+	// depends only on the slice, not on the thread that runs it
+	uint32_t randomstate = (update->seed ^ ((uint32_t)begin * 2654435761u)) | 1;
 
-	for( int i = 0; i < NUM_LIGHTS; ++i ) {
-		const LightParticle& oldp = readparticles[i];
-		LightParticle& newp = writeparticles[i];
+	for( size_t i = begin; i < end; ++i ) {
+		const LightParticle& oldp = update->readparticles[i];
+		LightParticle& newp = update->writeparticles[i];
 
 		VKVec3Assign(newp.velocity, oldp.velocity);
 		VKVec3Assign(newp.previous, oldp.current);
 
 		// integrate
-		VKVec3Mad(newp.current, oldp.current, oldp.velocity, dt);
+		VKVec3Mad(newp.current, oldp.current, oldp.velocity, update->dt);
 
 		// detect collision
 		besttoi = 2;
@@ -776,18 +796,18 @@ void UpdateParticles(float dt)
 
 		for( int j = 0; j < 6; ++j ) {
 			// use radius == 0.5
-			denom = VKVec3Dot(b, planes[j]);
-			pastcollision = (VKVec3Dot(newp.previous, planes[j]) + planes[j][3] < 0.5f);
+			denom = VKVec3Dot(b, update->planes[j]);
+			pastcollision = (VKVec3Dot(newp.previous, update->planes[j]) + update->planes[j][3] < 0.5f);
 
 			if( denom < -1e-4f ) {
-				toi = (0.5f - VKVec3Dot(newp.previous, planes[j]) - planes[j][3]) / denom;
+				toi = (0.5f - VKVec3Dot(newp.previous, update->planes[j]) - update->planes[j][3]) / denom;
 
 				if( ((toi <= 1 && toi >= 0) ||		// normal case
 					(toi < 0 && pastcollision)) &&	// allow past collision
 					toi < besttoi )
 				{
 					besttoi = toi;
-					bestplane = &planes[j];
+					bestplane = &update->planes[j];
 				}
 			}
 		}
@@ -801,7 +821,7 @@ void UpdateParticles(float dt)
 			impulse = -VKVec3Dot(*bestplane, newp.velocity);
 
 			// perturb normal vector
-			noise = ((rand() % 100) / 100.0f) * VK_PI * 0.333333f - VK_PI * 0.166666f; // [-pi/6, pi/6]
+			noise = ((ParticleRandom(randomstate) % 100) / 100.0f) * VK_PI * 0.333333f - VK_PI * 0.166666f; // [-pi/6, pi/6]
 
 			b[0] = cosf(noise + VK_PI * 0.5f);
 			b[1] = cosf(noise);
@@ -832,6 +852,26 @@ void UpdateParticles(float dt)
 			newp.velocity[2] *= energy;
 		}
 	}
+}
+
+void UpdateParticles(float dt)
+{
+	ParticleUpdateArgs	args;
+	JobCounter			counter;
+
+	particlevolume.GetPlanes(args.planes);
+
+	uint32_t prevphysicsframe = (currentphysicsframe + VK_NUM_QUEUED_FRAMES - 1) % VK_NUM_QUEUED_FRAMES;
+
+	LightParticle* particles = (LightParticle*)lightbuffer->MapContents(0, 0);
+
+	args.readparticles = particles + prevphysicsframe * NUM_LIGHTS;
+	args.writeparticles = particles + currentphysicsframe * NUM_LIGHTS;
+	args.dt = dt;
+	args.seed = (uint32_t)rand();
+
+	jobsystem->ParallelFor(&IntegrateParticles, &args, 0, NUM_LIGHTS, PARTICLES_PER_JOB, &counter);
+	jobsystem->Wait(&counter);
 
 	lightbuffer->UnmapContents();
 
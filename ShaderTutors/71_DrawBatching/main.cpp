@@ -5,6 +5,7 @@
 #include "../common/vkx.h"
 #include "../common/basiccamera.h"
 #include "../common/perfmeasure.h"
+#include "../common/jobsystem.h"
 
 // - bufferImageGranularity!!!!!
 // - device lost lehetseges...mi tortenik majd fullscreenben?
@@ -12,6 +13,8 @@
 #define TITLE				"Shader sample 71: Vulkan drawcall batching"
 #define OBJECT_GRID_SIZE	64		// nxn objects
 #define TILE_GRID_SIZE		32		// kxk tiles
+#define TILES_PER_JOB		64
+#define OBJECTS_PER_JOB		512
 #define SPACING				0.4f
 #define CAMERA_SPEED		0.05f
 
@@ -19,9 +22,9 @@
 #define MEASURE_PERF
 
 #ifdef MEASURE_PERF
-#	define MEASURE_POINT(x)		perfmeasure.Measure(x)
+#	define MEASURE_SCOPE(x)		PERF_SCOPE(perfmeasure, x)
 #else
-#	define MEASURE_POINT(x)
+#	define MEASURE_SCOPE(x)
 #endif
 
 extern HWND		hwnd;
@@ -133,11 +136,13 @@ VulkanBasicMesh*		debugmesh			= 0;
 VulkanGraphicsPipeline*	pipeline			= 0;
 VulkanGraphicsPipeline*	debugpipeline		= 0;
 VulkanFramePump*		framepump			= 0;
+JobSystem*				jobsystem			= 0;
 
 SceneObjectPrototype*	prototypes[3]		= { 0, 0, 0 };
 ObjectArray				sceneobjects;
 BatchArray				tiles;
 BatchArray				visibletiles;
+std::vector<uint8_t>	tilevisibility;
 BasicCamera				debugcamera;
 float					debugworld[16];
 float					debugcolor[4];
@@ -161,6 +166,8 @@ bool					animating			= true;
 bool					debugmode			= false;
 
 void FrameFinished(uint32_t frameid);
+void CullTiles(void* args, size_t begin, size_t end);
+void ResetEncoding(void* args, size_t begin, size_t end);
 void UpdateTiles(float* viewproj, uint32_t currentimage);
 
 //*************************************************************************************************************
@@ -380,6 +387,8 @@ bool InitScene()
 	framepump = new VulkanFramePump();
 	framepump->FrameFinished = FrameFinished;
 
+	jobsystem = new JobSystem();
+
 	// create render pass
 	VkFormat depthformat = VK_FORMAT_D24_UNORM_S8_UINT;
 
@@ -603,6 +612,7 @@ bool InitScene()
 	float		tiledepth = totaldepth / TILE_GRID_SIZE;
 
 	tiles.resize(TILE_GRID_SIZE * TILE_GRID_SIZE, 0);
+	tilevisibility.resize(tiles.size(), 0);
 
 	for( size_t i = 0; i < TILE_GRID_SIZE; ++i )
 	{
@@ -718,22 +728,40 @@ bool InitScene()
 	return true;
 }
 
+void CullTiles(void* args, size_t begin, size_t end)
+{
+	float (*planes)[4] = (float (*)[4])args;
+
+	MEASURE_SCOPE("Cull tiles");
+
+	for( size_t i = begin; i < end; ++i )
+		tilevisibility[i] = (VKFrustumIntersect(planes, tiles[i]->GetBoundingBox()) > 0 ? 1 : 0);
+}
+
+void ResetEncoding(void* args, size_t begin, size_t end)
+{
+	MEASURE_SCOPE("Reset encoding");
+
+	for( size_t i = begin; i < end; ++i )
+		sceneobjects[i]->SetEncoded(false);
+}
+
 void UpdateTiles(float* viewproj, uint32_t currentimage)
 {
-	// TODO: make it multithreaded
+	JobCounter counter;
 	float planes[6][4];
 
 	VKFrustumPlanes(planes, viewproj);
 	visibletiles.clear();
 
-	// mark all objects non-encoded
-	for( size_t i = 0; i < sceneobjects.size(); ++i )
-		sceneobjects[i]->SetEncoded(false);
+	// cull tiles and mark all objects non-encoded
+	jobsystem->ParallelFor(&CullTiles, planes, 0, tiles.size(), TILES_PER_JOB, &counter);
+	jobsystem->ParallelFor(&ResetEncoding, 0, 0, sceneobjects.size(), OBJECTS_PER_JOB, &counter);
+	jobsystem->Wait(&counter);
 
+	// NOTE: stays serial, command buffers come from one pool and the encoded flags depend on the order
 	for( size_t i = 0; i < tiles.size(); ++i ) {
-		const VulkanAABox& tilebox = tiles[i]->GetBoundingBox();
-
-		if( VKFrustumIntersect(planes, tilebox) > 0 ) {
+		if( tilevisibility[i] ) {
 			visibletiles.push_back(tiles[i]);
 
 			// mark tile-encoded objects encoded (to avoid double encoding)
@@ -800,6 +828,7 @@ void UninitScene()
 {
 #ifdef MEASURE_PERF
 	perfmeasure.Dump();
+	perfmeasure.ExportTrace("perftrace.json");
 #endif
 
 	vkDeviceWaitIdle(driverinfo.device);
@@ -813,6 +842,9 @@ void UninitScene()
 	visibletiles.clear();
 	visibletiles.swap(BatchArray());
 
+	tilevisibility.clear();
+	tilevisibility.swap(std::vector<uint8_t>());
+
 	for( size_t i = 0; i < sceneobjects.size(); ++i )
 		delete sceneobjects[i];
 
@@ -840,6 +872,7 @@ void UninitScene()
 	vkDestroyRenderPass(driverinfo.device, renderpass, NULL);
 	
 	VK_SAFE_DELETE(framepump);
+	VK_SAFE_DELETE(jobsystem);
 }
 
 void Event_KeyDown(unsigned char keycode)
@@ -914,9 +947,7 @@ void Render(float alpha, float elapsedtime)
 
 	framerate = (int)(1.0f / elapsedtime);
 
-#ifdef MEASURE_PERF
-	perfmeasure.Start();
-#endif
+	MEASURE_SCOPE("Frame");
 
 	// setup transforms
 	float				halfw	= totalwidth * 0.45f;
@@ -982,15 +1013,14 @@ void Render(float alpha, float elapsedtime)
 	barrier.Enlist(commandbuffer);
 
 	// update visible tiles
-	MEASURE_POINT("");
-
-	UpdateTiles(unidata.viewproj, currentimage);
+	{
+		MEASURE_SCOPE("Update tiles");
+		UpdateTiles(unidata.viewproj, currentimage);
+	}
 
 	if( animating )
 		time += elapsedtime;
 
-	MEASURE_POINT("Update tiles");
-
 	if( debugmode )
 	{
 		DebugUniformData* debugunis = (DebugUniformData*)debugmesh->GetUniformBufferPointer();
@@ -1027,10 +1057,10 @@ void Render(float alpha, float elapsedtime)
 	passbegininfo.clearValueCount			= 2;
 	passbegininfo.pClearValues				= clearcolors;
 
-	MEASURE_POINT("");
-
 	vkCmdBeginRenderPass(commandbuffer, &passbegininfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
 	{
+		MEASURE_SCOPE("Encode");
+
 		std::vector<VkCommandBuffer> cmds(visibletiles.size(), 0);
 
 		for( size_t i = 0; i < visibletiles.size(); ++i )
@@ -1110,8 +1140,6 @@ void Render(float alpha, float elapsedtime)
 	}
 	vkCmdEndRenderPass(commandbuffer);
 
-	MEASURE_POINT("Encode");
-
 	// add a barrier for present
 	presentbarrier.sType							= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 	presentbarrier.pNext							= NULL;
@@ -1132,10 +1160,10 @@ void Render(float alpha, float elapsedtime)
 	vkEndCommandBuffer(commandbuffer);
 
 	// present to window
-	MEASURE_POINT("");
-	framepump->Present();
-
-	MEASURE_POINT("Present");
+	{
+		MEASURE_SCOPE("Present");
+		framepump->Present();
+	}
 }
 
 void FrameFinished(uint32_t frameid)
@@ -1,44 +1,77 @@
-
 #ifndef _BLOCKINGQUEUE_HPP_
 #define _BLOCKINGQUEUE_HPP_
 
 #include "thread.h"
 
-#define ASSERT(x) { if( !(x) ) throw 1; }
+#define BLOCKINGQUEUE_DEFAULT_CAPACITY	1024
+#define BLOCKINGQUEUE_SPIN_COUNT		64
 
+/**
+ * \brief Bounded multi-producer multi-consumer queue
+ *
+ * Ring buffer where every cell has a sequence number telling whose turn
+ * it is (producer or consumer), so push and pop only compete for one
+ * atomic position. pop() parks the thread when the queue stays empty.
+ */
 template <typename value_type>
 class blockingqueue
 {
-	struct node
+	struct cell
 	{
-		value_type value;
-		node* next;
+		AtomicSize	sequence;
+		value_type	value;
 	};
 
 private:
-	mutable Guard	guard;
-	Signal	notempty;
-	node	head;
-	node*	last;
-	size_t	mysize;
+	cell*		buffer;
+	size_t		mask;
+	char		pad1[CACHE_LINE_SIZE];
+	AtomicSize	enqueuepos;
+	char		pad2[CACHE_LINE_SIZE];
+	AtomicSize	dequeuepos;
+	char		pad3[CACHE_LINE_SIZE];
+	AtomicSize	sleepers;
+	Guard		guard;
+	Signal		notempty;
+
+	blockingqueue(const blockingqueue&);
+	blockingqueue& operator =(const blockingqueue&);
+
+	void Wake();
 
 public:
-	blockingqueue();
+	blockingqueue(size_t capacity = BLOCKINGQUEUE_DEFAULT_CAPACITY);
 	~blockingqueue();
 
+	bool try_push(const value_type& value);
+	bool try_pop(value_type& value);
+
 	void push(const value_type& value);
 	value_type pop();
 
+	size_t pop_all(std::vector<value_type>& out);
+
 	bool empty() const;
 	size_t size() const;
+
+	inline size_t capacity() const {
+		return mask + 1;
+	}
 };
 
 template <typename value_type>
-blockingqueue<value_type>::blockingqueue()
+blockingqueue<value_type>::blockingqueue(size_t capacity)
 {
-	head.next	= &head;
-	last		= &head;
-	mysize		= 0;
+	size_t count = 2;
+
+	while( count < capacity )
+		count *= 2;
+
+	buffer	= new cell[count];
+	mask	= count - 1;
+
+	for( size_t i = 0; i < count; ++i )
+		buffer[i].sequence.Store(i);
 
 	notempty.Halt();
 }
@@ -46,94 +79,189 @@ blockingqueue<value_type>::blockingqueue()
 template <typename value_type>
 blockingqueue<value_type>::~blockingqueue()
 {
-	node* q = head.next;
-	node* p;
+	delete[] buffer;
+	buffer = 0;
+}
+
+template <typename value_type>
+void blockingqueue<value_type>::Wake()
+{
+	// pairs with the fence in pop(): either we see the sleeper, or it sees the value
+	AtomicSize::Fence();
+
+	if( sleepers.LoadRelaxed() > 0 )
+	{
+		guard.Lock();
+		notempty.Fire();
+		guard.Unlock();
+	}
+}
+
+template <typename value_type>
+bool blockingqueue<value_type>::try_push(const value_type& value)
+{
+	size_t pos = enqueuepos.LoadRelaxed();
+	cell* q;
 
-	while( q != &head )
+	while( true )
 	{
-		p = q->next;
-		delete q;
-		q = p;
+		q = &buffer[pos & mask];
+
+		size_t seq = q->sequence.Load();
+		ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)pos;
+
+		if( diff == 0 )
+		{
+			if( enqueuepos.CompareExchange(pos, pos + 1) )
+				break;
+		}
+		else if( diff < 0 )
+		{
+			// full
+			return false;
+		}
+		else
+			pos = enqueuepos.LoadRelaxed();
 	}
 
-	head.next = &head;
+	q->value = value;
+	q->sequence.Store(pos + 1);
 
-	last = 0;
-	mysize = 0;
+	Wake();
+	return true;
 }
 
 template <typename value_type>
-void blockingqueue<value_type>::push(const value_type& value)
+bool blockingqueue<value_type>::try_pop(value_type& value)
 {
-	guard.Lock();
+	size_t pos = dequeuepos.LoadRelaxed();
+	cell* q;
+
+	while( true )
 	{
-		last->next = new node();
-		last->next->value = value;
+		q = &buffer[pos & mask];
 
-		last = last->next;
-		last->next = &head;
+		size_t seq = q->sequence.Load();
+		ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)(pos + 1);
 
-		++mysize;
-		notempty.Fire();
+		if( diff == 0 )
+		{
+			if( dequeuepos.CompareExchange(pos, pos + 1) )
+				break;
+		}
+		else if( diff < 0 )
+		{
+			// empty
+			return false;
+		}
+		else
+			pos = dequeuepos.LoadRelaxed();
 	}
-	guard.Unlock();
+
+	value = q->value;
+	q->sequence.Store(pos + mask + 1);
+
+	return true;
+}
+
+template <typename value_type>
+void blockingqueue<value_type>::push(const value_type& value)
+{
+	// NOTE: waits for the consumers when full
+	while( !try_push(value) )
+		Thread::YieldCPU();
 }
 
 template <typename value_type>
 value_type blockingqueue<value_type>::pop()
 {
-	value_type val;
-	bool popped = false;
+	value_type value;
 
-	do
+	while( true )
 	{
-		notempty.Wait();
+		for( int i = 0; i < BLOCKINGQUEUE_SPIN_COUNT; ++i )
+		{
+			if( try_pop(value) )
+				return value;
+		}
 
 		guard.Lock();
 		{
-			if( mysize > 0 )
-			{
-				node* q = head.next;
-				head.next = q->next;
-				val = q->value;
+			sleepers.FetchAdd(1);
+			AtomicSize::Fence();
 
-				delete q;
-				--mysize;
-
-				if( mysize == 0 )
-					last = &head;
+			if( try_pop(value) )
+			{
+				sleepers.FetchAdd((size_t)-1);
+				guard.Unlock();
 
-				popped = true;
+				return value;
 			}
 
-			if( mysize == 0 )
-				notempty.Halt();
+			notempty.Halt();
 		}
 		guard.Unlock();
+
+		notempty.Wait();
+		sleepers.FetchAdd((size_t)-1);
+	}
+}
+
+template <typename value_type>
+size_t blockingqueue<value_type>::pop_all(std::vector<value_type>& out)
+{
+	// claims every ready cell with one exchange; doesn't block
+	size_t pos = dequeuepos.LoadRelaxed();
+	size_t count;
+
+	while( true )
+	{
+		count = 0;
+
+		while( count <= mask && buffer[(pos + count) & mask].sequence.Load() == pos + count + 1 )
+			++count;
+
+		if( count == 0 )
+		{
+			ptrdiff_t diff = (ptrdiff_t)buffer[pos & mask].sequence.Load() - (ptrdiff_t)(pos + 1);
+
+			if( diff <= 0 )
+				return 0;
+
+			// another consumer was faster
+			pos = dequeuepos.LoadRelaxed();
+		}
+		else if( dequeuepos.CompareExchange(pos, pos + count) )
+		{
+			break;
+		}
 	}
-	while( !popped );
 
-	return val;
+	for( size_t i = 0; i < count; ++i )
+	{
+		cell* q = &buffer[(pos + i) & mask];
+
+		out.push_back(q->value);
+		q->sequence.Store(pos + i + mask + 1);
+	}
+
+	return count;
 }
 
 template <typename value_type>
 bool blockingqueue<value_type>::empty() const
 {
-	guard.Lock();
-	size_t check = mysize;
-	guard.Unlock();
-
-	return (check == 0);
+	return (size() == 0);
 }
 
 template <typename value_type>
 size_t blockingqueue<value_type>::size() const
 {
-	guard.Lock();
-	size_t check = mysize;
-	guard.Unlock();
+	// NOTE: only a snapshot, also counts pushes that are still in progress
+	size_t first = dequeuepos.Load();
+	size_t last = enqueuepos.Load();
 
-	return check;
+	return (last > first ? last - first : 0);
 }
 
 #endif
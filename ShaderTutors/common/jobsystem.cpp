@@ -0,0 +1,370 @@
+
+#include "jobsystem.h"
+
+#define JOBQUEUE_MASK	(JOBQUEUE_SIZE - 1)
+#define NO_QUEUE		((size_t)-1)
+
+static THREAD_LOCAL JobSystem*		currentsystem = 0;
+static THREAD_LOCAL size_t			currentqueue = 0;
+static THREAD_LOCAL unsigned int	randomstate = 0;
+
+static size_t RandomVictim(size_t count)
+{
+	// xorshift
+	unsigned int x = randomstate;
+
+	if( x == 0 )
+		x = (unsigned int)(size_t)&randomstate | 1;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+
+	randomstate = x;
+	return x % count;
+}
+
+//*************************************************************************************************************
+//
+// JobQueue impl
+//
+//*************************************************************************************************************
+
+bool JobQueue::Push(const Job& job)
+{
+	size_t b = bottom.LoadRelaxed();
+	size_t t = top.Load();
+
+	if( b - t >= JOBQUEUE_SIZE )
+		return false;
+
+	jobs[b & JOBQUEUE_MASK] = job;
+	bottom.Store(b + 1);
+
+	return true;
+}
+
+bool JobQueue::Pop(Job& job)
+{
+	size_t b = bottom.LoadRelaxed() - 1;
+
+	bottom.Store(b);
+	AtomicSize::Fence();
+
+	size_t t = top.LoadRelaxed();
+	ptrdiff_t count = (ptrdiff_t)(b - t);
+
+	if( count < 0 )
+	{
+		// was empty
+		bottom.Store(t);
+		return false;
+	}
+
+	job = jobs[b & JOBQUEUE_MASK];
+
+	if( count > 0 )
+		return true;
+
+	// the last one, thieves might want it too
+	size_t expected = t;
+	bool success = false;
+
+	while( !success && expected == t )
+		success = top.CompareExchange(expected, t + 1);
+
+	bottom.Store(t + 1);
+	return success;
+}
+
+bool JobQueue::Steal(Job& job)
+{
+	size_t t = top.Load();
+	AtomicSize::Fence();
+	size_t b = bottom.Load();
+
+	if( (ptrdiff_t)(b - t) <= 0 )
+		return false;
+
+	job = jobs[t & JOBQUEUE_MASK];
+
+	// NOTE: fails if somebody else was faster, doesn't retry
+	return top.CompareExchange(t, t + 1);
+}
+
+//*************************************************************************************************************
+//
+// JobSystem impl
+//
+//*************************************************************************************************************
+
+void JobSystem::Worker::Run()
+{
+	currentsystem = owner;
+	currentqueue = index;
+
+	Job job;
+	int spins = 0;
+
+	while( owner->running.Load() )
+	{
+		if( owner->FindJob(index, job) )
+		{
+			owner->Execute(index, job);
+			spins = 0;
+		}
+		else if( ++spins < JOBSYSTEM_MAX_SPINS )
+		{
+			Thread::YieldCPU();
+		}
+		else
+		{
+			owner->Idle();
+			spins = 0;
+		}
+	}
+}
+
+JobSystem::JobSystem(size_t workercount, bool mainparticipates)
+{
+	if( workercount == 0 )
+	{
+		workercount = Thread::NumCores();
+
+		if( mainparticipates )
+			--workercount;
+	}
+
+	// somebody has to do the work
+	if( workercount == 0 && !mainparticipates )
+		workercount = 1;
+
+	numworkers	= workercount;
+	participate	= mainparticipates;
+
+	queues	= new JobQueue[numworkers + 1];
+	workers	= new Worker[numworkers];
+	threads	= new Thread[numworkers];
+
+	running.Store(1);
+	jobavailable.Halt();
+
+	currentsystem = this;
+	currentqueue = 0;
+
+	for( size_t i = 0; i < numworkers; ++i )
+	{
+		workers[i].owner = this;
+		workers[i].index = i + 1;
+
+		threads[i].Attach(&workers[i], &Worker::Run);
+		threads[i].Start();
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	// NOTE: doesn't wait for the remaining jobs
+	running.Store(0);
+
+	guard.Lock();
+	jobavailable.Fire();
+	guard.Unlock();
+
+	for( size_t i = 0; i < numworkers; ++i )
+		threads[i].Wait();
+
+	delete[] threads;
+	delete[] workers;
+	delete[] queues;
+
+	if( currentsystem == this )
+		currentsystem = 0;
+}
+
+bool JobSystem::FindJob(size_t index, Job& job)
+{
+	size_t count = numworkers + 1;
+
+	if( index != NO_QUEUE && queues[index].Pop(job) )
+		return true;
+
+	size_t start = RandomVictim(count);
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		size_t victim = (start + i) % count;
+
+		if( victim != index && queues[victim].Steal(job) )
+			return true;
+	}
+
+	return false;
+}
+
+bool JobSystem::HasJobs() const
+{
+	for( size_t i = 0; i <= numworkers; ++i )
+	{
+		if( !queues[i].Empty() )
+			return true;
+	}
+
+	return false;
+}
+
+void JobSystem::Execute(size_t index, Job& job)
+{
+	// keep half of the range, give away the other half
+	while( job.end - job.begin > job.grainsize )
+	{
+		Job half = job;
+
+		half.begin = job.begin + (job.end - job.begin) / 2;
+		job.end = half.begin;
+
+		if( job.counter )
+			job.counter->pending.FetchAdd(1);
+
+		if( index == NO_QUEUE || !queues[index].Push(half) )
+			Execute(index, half);
+		else
+			Wake();
+	}
+
+	job.func(job.args, job.begin, job.end);
+	Finish(job.counter);
+}
+
+void JobSystem::Finish(JobCounter* counter)
+{
+	if( !counter )
+		return;
+
+	// the waiter can't leave (and destroy the counter) until this is done
+	counter->finishing.FetchAdd(1);
+
+	if( counter->pending.FetchAdd((size_t)-1) == 1 )
+	{
+		std::vector<Job> ready;
+
+		counter->guard.Lock();
+		ready.swap(counter->dependents);
+		counter->guard.Unlock();
+
+		for( size_t i = 0; i < ready.size(); ++i )
+			Submit(ready[i]);
+	}
+
+	counter->finishing.FetchAdd((size_t)-1);
+}
+
+void JobSystem::Idle()
+{
+	guard.Lock();
+	{
+		sleepers.FetchAdd(1);
+		AtomicSize::Fence();
+
+		// pairs with the fence in Wake()
+		if( HasJobs() || !running.Load() )
+		{
+			sleepers.FetchAdd((size_t)-1);
+			guard.Unlock();
+
+			return;
+		}
+
+		jobavailable.Halt();
+	}
+	guard.Unlock();
+
+	jobavailable.Wait();
+	sleepers.FetchAdd((size_t)-1);
+}
+
+void JobSystem::Submit(const Job& job)
+{
+	size_t index = (currentsystem == this ? currentqueue : NO_QUEUE);
+
+	if( index == NO_QUEUE || !queues[index].Push(job) )
+	{
+		// from a foreign thread or the queue is full
+		Job copy = job;
+		Execute(index, copy);
+	}
+	else
+	{
+		Wake();
+	}
+}
+
+void JobSystem::Wake()
+{
+	AtomicSize::Fence();
+
+	if( sleepers.LoadRelaxed() > 0 )
+	{
+		guard.Lock();
+		jobavailable.Fire();
+		guard.Unlock();
+	}
+}
+
+void JobSystem::Run(JobFunction func, void* args, JobCounter* counter, JobCounter* dependency)
+{
+	ParallelFor(func, args, 0, 1, 1, counter, dependency);
+}
+
+void JobSystem::ParallelFor(JobFunction func, void* args, size_t begin, size_t end, size_t grainsize, JobCounter* counter, JobCounter* dependency)
+{
+	Job job;
+
+	if( begin >= end )
+		return;
+
+	job.func		= func;
+	job.args		= args;
+	job.begin		= begin;
+	job.end			= end;
+	job.grainsize	= (grainsize > 0 ? grainsize : 1);
+	job.counter		= counter;
+
+	if( counter )
+		counter->pending.FetchAdd(1);
+
+	if( dependency )
+	{
+		bool deferred = false;
+
+		dependency->guard.Lock();
+		{
+			if( dependency->pending.Load() > 0 )
+			{
+				dependency->dependents.push_back(job);
+				deferred = true;
+			}
+		}
+		dependency->guard.Unlock();
+
+		if( deferred )
+			return;
+	}
+
+	Submit(job);
+}
+
+void JobSystem::Wait(JobCounter* counter)
+{
+	size_t index = (currentsystem == this ? currentqueue : NO_QUEUE);
+	bool help = (participate || (index != NO_QUEUE && index > 0));
+	Job job;
+
+	while( !counter->IsDone() )
+	{
+		if( help && FindJob(index, job) )
+			Execute(index, job);
+		else
+			Thread::YieldCPU();
+	}
+}
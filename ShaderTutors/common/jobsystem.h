@@ -0,0 +1,132 @@
+
+#ifndef _JOBSYSTEM_H_
+#define _JOBSYSTEM_H_
+
+#include "thread.h"
+
+#define JOBQUEUE_SIZE		4096	// per thread, must be a power of two
+#define JOBSYSTEM_MAX_SPINS	256		// failed steals before a worker goes to sleep
+
+class JobSystem;
+class JobCounter;
+
+// [begin, end) is a slice of the range given to ParallelFor()
+typedef void (*JobFunction)(void* args, size_t begin, size_t end);
+
+struct Job
+{
+	JobFunction	func;
+	void*		args;
+	size_t		begin;
+	size_t		end;
+	size_t		grainsize;	// split until the range is not larger than this
+	JobCounter*	counter;	// decremented when done, can be NULL
+};
+
+/**
+ * \brief Number of unfinished jobs
+ *
+ * Jobs can depend on a counter, then they are started when it reaches zero.
+ */
+class JobCounter
+{
+	friend class JobSystem;
+
+private:
+	AtomicSize			pending;
+	AtomicSize			finishing;	// threads still touching this
+	Guard				guard;
+	std::vector<Job>	dependents;
+
+	JobCounter(const JobCounter&);
+	JobCounter& operator =(const JobCounter&);
+
+public:
+	JobCounter() {}
+
+	inline bool IsDone() const {
+		return (pending.Load() == 0 && finishing.Load() == 0);
+	}
+};
+
+/**
+ * \brief Work-stealing deque (Chase-Lev)
+ *
+ * Only the owner thread pushes and pops (at the bottom), others steal from the top.
+ */
+class JobQueue
+{
+private:
+	Job			jobs[JOBQUEUE_SIZE];
+	char		pad1[CACHE_LINE_SIZE];
+	AtomicSize	top;
+	char		pad2[CACHE_LINE_SIZE];
+	AtomicSize	bottom;
+	char		pad3[CACHE_LINE_SIZE];
+
+public:
+	bool Push(const Job& job);
+	bool Pop(Job& job);
+	bool Steal(Job& job);
+
+	inline bool Empty() const {
+		return ((ptrdiff_t)(bottom.Load() - top.Load()) <= 0);
+	}
+};
+
+/**
+ * \brief Pool of worker threads that share their jobs
+ *
+ * The thread that creates it gets a queue too, and helps out in Wait() unless told not to.
+ * NOTE: jobs can be added from that thread or from other jobs only.
+ */
+class JobSystem
+{
+	class Worker
+	{
+	public:
+		JobSystem*	owner;
+		size_t		index;
+
+		void Run();
+	};
+
+private:
+	JobQueue*	queues;		// [0] is the creator's
+	Worker*		workers;
+	Thread*		threads;
+	size_t		numworkers;
+	AtomicSize	running;
+	AtomicSize	sleepers;
+	Guard		guard;
+	Signal		jobavailable;
+	bool		participate;
+
+	JobSystem(const JobSystem&);
+	JobSystem& operator =(const JobSystem&);
+
+	bool FindJob(size_t index, Job& job);
+	bool HasJobs() const;
+
+	void Idle();
+
+	void Execute(size_t index, Job& job);
+	void Finish(JobCounter* counter);
+	void Submit(const Job& job);
+	void Wake();
+
+public:
+	// 0 workers means one less than the number of cores (or as many if the creator won't help)
+	JobSystem(size_t workercount = 0, bool mainparticipates = true);
+	~JobSystem();
+
+	void Run(JobFunction func, void* args, JobCounter* counter, JobCounter* dependency = 0);
+	void ParallelFor(JobFunction func, void* args, size_t begin, size_t end, size_t grainsize, JobCounter* counter, JobCounter* dependency = 0);
+	void Wait(JobCounter* counter);
+
+	inline size_t GetNumThreads() const {
+		return numworkers + (participate ? 1 : 0);
+	}
+};
+
+#endif
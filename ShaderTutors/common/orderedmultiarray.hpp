@@ -3,8 +3,9 @@
 #define _ORDEREDMULTIARRAY_HPP_
 
 #include "functional.hpp"
+#include "searchlayout.hpp"
 
-template <typename value_type, typename compare = default_less<value_type> >
+template <typename value_type, typename compare = mystl::default_less<value_type>, typename layout = mystl::sorted_layout>
 class orderedmultiarray
 {
 private:
@@ -12,7 +13,10 @@ private:
 	size_t mycap;
 	size_t mysize;
 
+	mutable typename layout::template index<value_type, compare> myindex;
+
 	size_t _find(const value_type& value) const;
+	size_t _lookup(const value_type& value) const;
 
 public:
 	typedef std::pair<size_t, size_t> pairii;
@@ -26,6 +30,12 @@ public:
 
 	size_t insert(const value_type& value);
 
+	template <typename iterator_type>
+	void assign(iterator_type first, iterator_type last);
+
+	template <typename iterator_type>
+	void insert(iterator_type first, iterator_type last);
+
 	void erase(const value_type& value);
 	void reserve(size_t newcap);
 	void destroy();
@@ -49,16 +59,16 @@ public:
 	}
 };
 
-template <typename value_type, typename compare>
-orderedmultiarray<value_type, compare>::orderedmultiarray()
+template <typename value_type, typename compare, typename layout>
+orderedmultiarray<value_type, compare, layout>::orderedmultiarray()
 {
 	data = 0;
 	mysize = 0;
 	mycap = 0;
 }
 	
-template <typename value_type, typename compare>
-orderedmultiarray<value_type, compare>::orderedmultiarray(const orderedmultiarray& other)
+template <typename value_type, typename compare, typename layout>
+orderedmultiarray<value_type, compare, layout>::orderedmultiarray(const orderedmultiarray& other)
 {
 	data = 0;
 	mysize = 0;
@@ -67,14 +77,14 @@ orderedmultiarray<value_type, compare>::orderedmultiarray(const orderedmultiarra
 	this->operator =(other);
 }
 	
-template <typename value_type, typename compare>
-orderedmultiarray<value_type, compare>::~orderedmultiarray()
+template <typename value_type, typename compare, typename layout>
+orderedmultiarray<value_type, compare, layout>::~orderedmultiarray()
 {
 	destroy();
 }
 	
-template <typename value_type, typename compare>
-size_t orderedmultiarray<value_type, compare>::_find(const value_type& value) const
+template <typename value_type, typename compare, typename layout>
+size_t orderedmultiarray<value_type, compare, layout>::_find(const value_type& value) const
 {
 	size_t low = 0;
 	size_t high = mysize;
@@ -94,12 +104,21 @@ size_t orderedmultiarray<value_type, compare>::_find(const value_type& value) co
 	
 	return low;
 }
+
+template <typename value_type, typename compare, typename layout>
+size_t orderedmultiarray<value_type, compare, layout>::_lookup(const value_type& value) const
+{
+	// same as _find(), but through the search index (if any)
+	size_t i = myindex.search(data, mysize, value, comp);
+	return (i == layout::template index<value_type, compare>::npos ? _find(value) : i);
+}
 	
-template <typename value_type, typename compare>
-size_t orderedmultiarray<value_type, compare>::insert(const value_type& value)
+template <typename value_type, typename compare, typename layout>
+size_t orderedmultiarray<value_type, compare, layout>::insert(const value_type& value)
 {
 	size_t i = 0;
 
+	myindex.invalidate();
 	reserve(mysize + 1);
 
 	if( mysize > 0 )
@@ -122,13 +141,46 @@ size_t orderedmultiarray<value_type, compare>::insert(const value_type& value)
 	return i;
 }
 	
-template <typename value_type, typename compare>
-void orderedmultiarray<value_type, compare>::erase(const value_type& value)
+template <typename value_type, typename compare, typename layout>
+template <typename iterator_type>
+void orderedmultiarray<value_type, compare, layout>::assign(iterator_type first, iterator_type last)
+{
+	// O(N log N) instead of N inserts
+	clear();
+	insert(first, last);
+}
+
+template <typename value_type, typename compare, typename layout>
+template <typename iterator_type>
+void orderedmultiarray<value_type, compare, layout>::insert(iterator_type first, iterator_type last)
+{
+	// NOTE: forward iterators, not into the array; append, sort the new part, then merge
+	size_t oldsize = mysize;
+
+	myindex.invalidate();
+	reserve(mysize + std::distance(first, last));
+
+	for( ; first != last; ++first )
+	{
+		new(data + mysize) value_type(*first);
+		++mysize;
+	}
+
+	std::sort(data + oldsize, data + mysize, comp);
+
+	if( oldsize > 0 )
+		std::inplace_merge(data, data + oldsize, data + mysize, comp);
+}
+	
+template <typename value_type, typename compare, typename layout>
+void orderedmultiarray<value_type, compare, layout>::erase(const value_type& value)
 {
 	pairii p = equal_range(value);
 
 	if( p.first != npos )
 	{
+		myindex.invalidate();
+
 		size_t count = (mysize - p.second);
 
 		for( size_t j = 0; j < count; ++j )
@@ -144,8 +196,8 @@ void orderedmultiarray<value_type, compare>::erase(const value_type& value)
 	}
 }
 	
-template <typename value_type, typename compare>
-void orderedmultiarray<value_type, compare>::reserve(size_t newcap)
+template <typename value_type, typename compare, typename layout>
+void orderedmultiarray<value_type, compare, layout>::reserve(size_t newcap)
 {
 	if( mycap < newcap )
 	{
@@ -168,8 +220,8 @@ void orderedmultiarray<value_type, compare>::reserve(size_t newcap)
 	}
 }
 	
-template <typename value_type, typename compare>
-void orderedmultiarray<value_type, compare>::destroy()
+template <typename value_type, typename compare, typename layout>
+void orderedmultiarray<value_type, compare, layout>::destroy()
 {
 	if( data )
 	{
@@ -182,30 +234,34 @@ void orderedmultiarray<value_type, compare>::destroy()
 	data = 0;
 	mysize = 0;
 	mycap = 0;
+
+	myindex.destroy();
 }
 	
-template <typename value_type, typename compare>
-void orderedmultiarray<value_type, compare>::clear()
+template <typename value_type, typename compare, typename layout>
+void orderedmultiarray<value_type, compare, layout>::clear()
 {
 	for( size_t i = 0; i < mysize; ++i )
 		(data + i)->~value_type();
 
 	mysize = 0;
+	myindex.invalidate();
 }
 	
-template <typename value_type, typename compare>
-void orderedmultiarray<value_type, compare>::pop_back()
+template <typename value_type, typename compare, typename layout>
+void orderedmultiarray<value_type, compare, layout>::pop_back()
 {
 	if( mysize > 0 )
 	{
+		myindex.invalidate();
 		--mysize;
 		(data + mysize)->~value_type();
 	}
 }
 
-template <typename value_type, typename compare>
-typename orderedmultiarray<value_type, compare>::pairii
-orderedmultiarray<value_type, compare>::equal_range(const value_type& value) const
+template <typename value_type, typename compare, typename layout>
+typename orderedmultiarray<value_type, compare, layout>::pairii
+orderedmultiarray<value_type, compare, layout>::equal_range(const value_type& value) const
 {
 	pairii range;
 
@@ -214,7 +270,7 @@ orderedmultiarray<value_type, compare>::equal_range(const value_type& value) con
 
 	if( mysize > 0 )
 	{
-		range.first = _find(value);
+		range.first = _lookup(value);
 
 		if( range.first < mysize )
 		{
@@ -252,20 +308,20 @@ orderedmultiarray<value_type, compare>::equal_range(const value_type& value) con
 	return range;
 }
 	
-template <typename value_type, typename compare>
-size_t orderedmultiarray<value_type, compare>::find(const value_type& value) const
+template <typename value_type, typename compare, typename layout>
+size_t orderedmultiarray<value_type, compare, layout>::find(const value_type& value) const
 {
 	return lower_bound(value);
 }
 	
-template <typename value_type, typename compare>
-size_t orderedmultiarray<value_type, compare>::lower_bound(const value_type& value) const
+template <typename value_type, typename compare, typename layout>
+size_t orderedmultiarray<value_type, compare, layout>::lower_bound(const value_type& value) const
 {
 	// returns the first that is greater or equal
 	if( mysize == 0 )
 		return 0;
 
-	size_t ind = _find(value);
+	size_t ind = _lookup(value);
 
 	if( ind < mysize )
 	{
@@ -293,14 +349,14 @@ size_t orderedmultiarray<value_type, compare>::lower_bound(const value_type& val
 	return npos;
 }
 	
-template <typename value_type, typename compare>
-size_t orderedmultiarray<value_type, compare>::upper_bound(const value_type& value) const
+template <typename value_type, typename compare, typename layout>
+size_t orderedmultiarray<value_type, compare, layout>::upper_bound(const value_type& value) const
 {
 	// returns the first that is greater
 	if( mysize == 0 )
 		return 0;
 
-	size_t ind = _find(value);
+	size_t ind = _lookup(value);
 
 	if( ind < mysize )
 	{
@@ -330,8 +386,8 @@ size_t orderedmultiarray<value_type, compare>::upper_bound(const value_type& val
 	return npos;
 }
 	
-template <typename value_type, typename compare>
-orderedmultiarray<value_type, compare>& orderedmultiarray<value_type, compare>::operator =(const orderedmultiarray& other)
+template <typename value_type, typename compare, typename layout>
+orderedmultiarray<value_type, compare, layout>& orderedmultiarray<value_type, compare, layout>::operator =(const orderedmultiarray& other)
 {
 	if( &other == this )
 		return *this;
@@ -347,8 +403,8 @@ orderedmultiarray<value_type, compare>& orderedmultiarray<value_type, compare>::
 	return *this;
 }
 	
-template <typename value_type, typename compare>
-std::ostream& operator <<(std::ostream& os, orderedmultiarray<value_type, compare>& oa)
+template <typename value_type, typename compare, typename layout>
+std::ostream& operator <<(std::ostream& os, orderedmultiarray<value_type, compare, layout>& oa)
 {
 	for( size_t i = 0; i < oa.size(); ++i )
 		os << oa.data[i] << " ";
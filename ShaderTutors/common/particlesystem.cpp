@@ -134,10 +134,8 @@ void ParticleSystem::Draw(const D3DXMATRIX& world, const D3DXMATRIX& view)
 	
 	if( SUCCEEDED(hr) )
 	{
-		ordered.clear();
-
-		for( size_t i = 0; i < particles.size(); ++i )
-			ordered.insert(particles[i]);
+		// one sort instead of shifting on every insert
+		ordered.assign(particles.begin(), particles.end());
 
 		for( size_t i = 0; i < ordered.size(); ++i )
 		{
@@ -1,71 +1,358 @@
-
 #include "perfmeasure.h"
 
-#include <windows.h>
 #include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <map>
+#include <cstdio>
+
+#ifndef _WIN32
+#	include <chrono>
+#endif
+
+#define PERF_RING_MASK	(PERF_RING_SIZE - 1)
+
+class PerfThreadBuffer
+{
+public:
+	PerfEvent	events[PERF_RING_SIZE];
+	AtomicSize	written;	// total, only the last PERF_RING_SIZE are kept
+	const void*	key;		// identifies the owner thread
+	std::string	name;
+	size_t		tid;
+	int			depth;		// touched only by the owner thread
+};
+
+static THREAD_LOCAL char				threadkey = 0;
+static THREAD_LOCAL size_t				cachedserial = 0;
+static THREAD_LOCAL PerfThreadBuffer*	cachedbuffer = 0;
+
+// constant initialized, so a global PerfMeasure can take a serial before any dynamic init
+#ifdef HAS_STD_ATOMIC
+static std::atomic<size_t>				nextserial(0);
+#else
+static volatile long					nextserial = 0;
+#endif
+
+static size_t NextSerial()
+{
+	// zero is never a valid serial
+#ifdef HAS_STD_ATOMIC
+	return nextserial.fetch_add(1) + 1;
+#else
+	return (size_t)_InterlockedIncrement(&nextserial);
+#endif
+}
+
+static bool CompareByEnd(const PerfEvent& a, const PerfEvent& b)
+{
+	return (a.end > b.end);
+}
+
+static bool CompareByFirst(const PerfMeasure::Statistics& a, const PerfMeasure::Statistics& b)
+{
+	return (a.first < b.first);
+}
 
-static LARGE_INTEGER qwTime;
-static LARGE_INTEGER qwTicksPerSec = { { 0, 0 } };
+static double Percentile(const std::vector<int64_t>& sorted, double p)
+{
+	size_t index = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+	return (double)sorted[index] * 1e-6;
+}
 
-PerfMeasure::Measurement::Measurement()
+static void WriteEscaped(FILE* outfile, const char* str)
 {
-	time = 0;
-	accumtime = 0;
-	count = 0;
+	for( ; *str; ++str )
+	{
+		if( *str == '"' || *str == '\\' )
+			fputc('\\', outfile);
+
+		fputc(*str, outfile);
+	}
 }
 
 PerfMeasure::PerfMeasure()
 {
-	counter = 0;
+	serial = NextSerial();
+	origin = Now();
+}
 
-	data.reserve(10);
-	data.resize(1);
+PerfMeasure::~PerfMeasure()
+{
+	for( size_t i = 0; i < buffers.size(); ++i )
+		delete buffers[i];
 
-	QueryPerformanceFrequency(&qwTicksPerSec);
+	buffers.clear();
 }
 
-void PerfMeasure::Measure(const std::string& id)
+PerfThreadBuffer* PerfMeasure::GetBuffer()
 {
-	if( counter >= data.size() )
+	// a different instance might live at the same address later, hence the serial
+	if( cachedbuffer != 0 && cachedserial == serial )
+		return cachedbuffer;
+
+	PerfThreadBuffer* buffer = 0;
+
+	guard.Lock();
 	{
-		data.resize(counter + 1);
-		data.back().ID = id;
+		// NOTE: a new thread might get the TLS block (and the buffer) of a finished one
+		for( size_t i = 0; i < buffers.size(); ++i )
+		{
+			if( buffers[i]->key == &threadkey )
+			{
+				buffer = buffers[i];
+				break;
+			}
+		}
+
+		if( !buffer )
+		{
+			char name[32];
+
+#ifdef _MSC_VER
+			sprintf_s(name, "thread %u", (unsigned int)buffers.size());
+#else
+			sprintf(name, "thread %u", (unsigned int)buffers.size());
+#endif
+
+			buffer = new PerfThreadBuffer();
+
+			buffer->key		= &threadkey;
+			buffer->name	= name;
+			buffer->tid		= buffers.size();
+			buffer->depth	= 0;
+
+			buffers.push_back(buffer);
+		}
 	}
+	guard.Unlock();
 
-	Measurement& msm = data[counter];
-	const Measurement& prev = data[counter - 1];
+	cachedserial = serial;
+	cachedbuffer = buffer;
 
-	QueryPerformanceCounter(&qwTime);
-	
-	msm.time = qwTime.QuadPart;
-	msm.accumtime += (qwTime.QuadPart - prev.time);
+	return buffer;
+}
 
-	++msm.count;
-	++counter;
+void PerfMeasure::Enter(PerfThreadBuffer* buffer)
+{
+	++buffer->depth;
+}
+
+void PerfMeasure::Leave(PerfThreadBuffer* buffer, const PerfScopeID* id, int64_t start)
+{
+	int64_t end = Now();
+	size_t count = buffer->written.LoadRelaxed();
+	PerfEvent& ev = buffer->events[count & PERF_RING_MASK];
+
+	--buffer->depth;
+
+	ev.id		= id;
+	ev.start	= start;
+	ev.end		= end;
+	ev.depth	= buffer->depth;
+
+	buffer->written.Store(count + 1);
+}
+
+void PerfMeasure::Snapshot(std::vector<PerfEvent>& events, std::vector<size_t>& threads) const
+{
+	events.clear();
+	threads.clear();
+
+	guard.Lock();
+
+	for( size_t i = 0; i < buffers.size(); ++i )
+	{
+		const PerfThreadBuffer* buffer = buffers[i];
+		size_t offset = events.size();
+		size_t end = buffer->written.Load();
+		size_t begin = (end > PERF_RING_SIZE ? end - PERF_RING_SIZE : 0);
+
+		for( size_t j = begin; j < end; ++j )
+			events.push_back(buffer->events[j & PERF_RING_MASK]);
+
+		// the owner might have overwritten some of them while copying (and might be writing the next one)
+		AtomicSize::Fence();
+
+		size_t now = buffer->written.LoadRelaxed();
+		size_t overwritten = (now + 1 > PERF_RING_SIZE ? now + 1 - PERF_RING_SIZE : 0);
+
+		if( overwritten > begin )
+		{
+			size_t count = std::min(overwritten - begin, end - begin);
+			events.erase(events.begin() + offset, events.begin() + offset + count);
+		}
+
+		threads.resize(events.size(), buffer->tid);
+	}
+
+	guard.Unlock();
+}
+
+void PerfMeasure::SetThreadName(const std::string& name)
+{
+	PerfThreadBuffer* buffer = GetBuffer();
+
+	guard.Lock();
+	buffer->name = name;
+	guard.Unlock();
 }
 
 void PerfMeasure::Dump() const
 {
-	double time;
+	typedef std::map<const PerfScopeID*, size_t> IndexMap;
 
-	std::cout << "\n";
+	std::vector<PerfEvent> events;
+	std::vector<size_t> threads;
+	std::vector<Statistics> stats;
+	std::vector<std::vector<int64_t> > samples;
+	IndexMap indices;
 
-	for( size_t i = 1; i < data.size(); ++i )
+	Snapshot(events, threads);
+
+	// the latest ones first
+	std::sort(events.begin(), events.end(), &CompareByEnd);
+
+	for( size_t i = 0; i < events.size(); ++i )
 	{
-		if( data[i].ID.size() > 0 )
+		const PerfEvent& ev = events[i];
+		IndexMap::iterator it = indices.find(ev.id);
+
+		if( it == indices.end() )
 		{
-			time = (double)data[i].accumtime / (double)qwTicksPerSec.QuadPart;
-			std::cout << data[i].ID << ": " << time << " s (" << data[i].count << ")\n";
+			Statistics st;
+
+			st.id		= ev.id;
+			st.first	= ev.start;
+			st.depth	= ev.depth;
+
+			it = indices.insert(IndexMap::value_type(ev.id, stats.size())).first;
+
+			stats.push_back(st);
+			samples.resize(stats.size());
 		}
+
+		std::vector<int64_t>& window = samples[it->second];
+
+		if( window.size() < PERF_WINDOW_SIZE )
+		{
+			Statistics& st = stats[it->second];
+
+			st.first = std::min(st.first, ev.start);
+			st.depth = std::min(st.depth, ev.depth);
+
+			window.push_back(ev.end - ev.start);
+		}
+	}
+
+	for( size_t i = 0; i < stats.size(); ++i )
+	{
+		Statistics& st = stats[i];
+		std::vector<int64_t>& window = samples[i];
+		int64_t sum = 0;
+
+		std::sort(window.begin(), window.end());
+
+		for( size_t j = 0; j < window.size(); ++j )
+			sum += window[j];
+
+		st.count	= window.size();
+		st.average	= ((double)sum / (double)window.size()) * 1e-6;
+		st.minimum	= (double)window.front() * 1e-6;
+		st.maximum	= (double)window.back() * 1e-6;
+		st.p50		= Percentile(window, 0.5);
+		st.p99		= Percentile(window, 0.99);
+	}
+
+	// parents start before their children
+	std::sort(stats.begin(), stats.end(), &CompareByFirst);
+
+	std::cout << "\n" << std::fixed << std::setprecision(3);
+
+	for( size_t i = 0; i < stats.size(); ++i )
+	{
+		const Statistics& st = stats[i];
+
+		std::cout << std::string(st.depth * 2, ' ') << st.id->name << ": "
+			<< st.average << " ms (min " << st.minimum << ", p50 " << st.p50
+			<< ", p99 " << st.p99 << ", max " << st.maximum << ", " << st.count << " samples)\n";
 	}
 
+	std::cout.unsetf(std::ios::floatfield);
 	std::cout << std::endl;
 }
 
-void PerfMeasure::Start()
+bool PerfMeasure::ExportTrace(const std::string& file) const
 {
-	counter = 1;
+	std::vector<PerfEvent> events;
+	std::vector<size_t> threads;
+	std::vector<std::string> names;
+	FILE* outfile = 0;
+
+	Snapshot(events, threads);
+
+	guard.Lock();
+	{
+		for( size_t i = 0; i < buffers.size(); ++i )
+			names.push_back(buffers[i]->name);
+	}
+	guard.Unlock();
+
+#ifdef _MSC_VER
+	fopen_s(&outfile, file.c_str(), "wb");
+#else
+	outfile = fopen(file.c_str(), "wb");
+#endif
+
+	if( !outfile )
+		return false;
+
+	// chrome://tracing format, times are in microseconds
+	fputs("{\"traceEvents\":[\n", outfile);
+
+	for( size_t i = 0; i < names.size(); ++i )
+	{
+		fprintf(outfile, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", (unsigned int)i);
+		WriteEscaped(outfile, names[i].c_str());
+		fputs("\"}},\n", outfile);
+	}
+
+	for( size_t i = 0; i < events.size(); ++i )
+	{
+		const PerfEvent& ev = events[i];
+
+		fputs("{\"name\":\"", outfile);
+		WriteEscaped(outfile, ev.id->name);
+
+		fprintf(outfile, "\",\"cat\":\"perf\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u},\n",
+			(double)(ev.start - origin) * 1e-3, (double)(ev.end - ev.start) * 1e-3, (unsigned int)threads[i]);
+	}
+
+	// so that there is no trailing comma
+	fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"PerfMeasure\"}}\n]}\n", outfile);
+	fclose(outfile);
+
+	return true;
+}
+
+int64_t PerfMeasure::Now()
+{
+#ifdef _WIN32
+	static LARGE_INTEGER qwTicksPerSec = { { 0, 0 } };
+	LARGE_INTEGER qwTime;
+
+	if( qwTicksPerSec.QuadPart == 0 )
+		QueryPerformanceFrequency(&qwTicksPerSec);
 
 	QueryPerformanceCounter(&qwTime);
-	data[0].time = qwTime.QuadPart;
+
+	// split to avoid overflow
+	int64_t seconds = qwTime.QuadPart / qwTicksPerSec.QuadPart;
+	int64_t remainder = qwTime.QuadPart % qwTicksPerSec.QuadPart;
+
+	return seconds * 1000000000LL + (remainder * 1000000000LL) / qwTicksPerSec.QuadPart;
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
 }
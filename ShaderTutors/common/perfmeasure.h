@@ -6,29 +6,108 @@
 #include <string>
 #include <cstdint>
 
-class PerfMeasure
+#include "thread.h"
+
+#define PERF_RING_SIZE		16384	// events kept per thread, must be a power of two
+#define PERF_WINDOW_SIZE	256		// statistics are calculated from this many latest samples
+
+#define PERF_CONCAT_(a, b)	a##b
+#define PERF_CONCAT(a, b)	PERF_CONCAT_(a, b)
+
+// measures the rest of the enclosing block
+#define PERF_SCOPE(measure, name) \
+	static const PerfScopeID PERF_CONCAT(perfid_, __LINE__) = { name }; \
+	PerfScope PERF_CONCAT(perfscope_, __LINE__)(measure, &PERF_CONCAT(perfid_, __LINE__))
+
+class PerfThreadBuffer;
+
+// static, so the address identifies the scope
+struct PerfScopeID
 {
-	struct Measurement {
-		std::string	ID;
-		int64_t		time;
-		int64_t		accumtime;
-		int64_t		count;
+	const char* name;
+};
 
-		Measurement();
-	};
+struct PerfEvent
+{
+	const PerfScopeID*	id;
+	int64_t				start;	// ns
+	int64_t				end;	// ns
+	int					depth;
+};
 
-	typedef std::vector<Measurement> DataArray;
+/**
+ * \brief Timeline of nested scopes on multiple threads
+ *
+ * Every thread writes its own ring buffer without locking, the last PERF_RING_SIZE events
+ * can be dumped as statistics or exported as a trace (chrome://tracing).
+ */
+class PerfMeasure
+{
+	friend class PerfScope;
 
 private:
-	DataArray	data;
-	size_t		counter;
+	std::vector<PerfThreadBuffer*>	buffers;
+	mutable Guard					guard;
+	int64_t							origin;
+	size_t							serial;
+
+	PerfMeasure(const PerfMeasure&);
+	PerfMeasure& operator =(const PerfMeasure&);
+
+	PerfThreadBuffer* GetBuffer();
+
+	void Enter(PerfThreadBuffer* buffer);
+	void Leave(PerfThreadBuffer* buffer, const PerfScopeID* id, int64_t start);
+	void Snapshot(std::vector<PerfEvent>& events, std::vector<size_t>& threads) const;
 
 public:
+	struct Statistics
+	{
+		const PerfScopeID*	id;
+		int64_t				first;
+		int					depth;
+		size_t				count;
+		double				average;	// ms from here
+		double				minimum;
+		double				maximum;
+		double				p50;
+		double				p99;
+	};
+
 	PerfMeasure();
+	~PerfMeasure();
 
-	void Measure(const std::string& id = "");
+	void SetThreadName(const std::string& name);
 	void Dump() const;
-	void Start();
+	bool ExportTrace(const std::string& file) const;
+
+	static int64_t Now();
+};
+
+class PerfScope
+{
+private:
+	PerfMeasure&		measure;
+	PerfThreadBuffer*	buffer;
+	const PerfScopeID*	id;
+	int64_t				start;
+
+	PerfScope(const PerfScope&);
+	PerfScope& operator =(const PerfScope&);
+
+public:
+	PerfScope(PerfMeasure& owner, const PerfScopeID* scopeid)
+		: measure(owner), id(scopeid)
+	{
+		buffer = measure.GetBuffer();
+		measure.Enter(buffer);
+
+		start = PerfMeasure::Now();
+	}
+
+	~PerfScope() {
+		measure.Leave(buffer, id, start);
+	}
 };
 
 #endif
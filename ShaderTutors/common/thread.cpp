@@ -1,6 +1,8 @@
 
 #include "thread.h"
 
+#ifdef _WIN32
+
 size_t SignalCombo::Add(const Signal* sn)
 {
 	handles.push_back(sn->handle);
@@ -30,6 +32,7 @@ Thread::Thread()
 {
 	emi = NULL;
 	handle = INVALID_HANDLE_VALUE;
+	id = 0;
 }
 
 Thread::~Thread()
@@ -38,14 +41,8 @@ Thread::~Thread()
 		Close();
 }
 
-bool Thread::Attach(void (*func)())
+bool Thread::Create()
 {
-	if( emi )
-		delete emi;
-
-	// trick
-	emi = new emitter<Thread>(func);
-
 	handle = CreateThread(
 		NULL, 0, (LPTHREAD_START_ROUTINE)&Thread::Run, emi, CREATE_SUSPENDED, &id);
 
@@ -78,3 +75,253 @@ void Thread::Close()
 		emi = NULL;
 	}
 }
+
+void Thread::Wait()
+{
+	WaitForSingleObject(handle, INFINITE);
+}
+
+void Thread::YieldCPU()
+{
+	SwitchToThread();
+}
+
+size_t Thread::NumCores()
+{
+	SYSTEM_INFO info;
+
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors;
+}
+
+#else
+
+#include <algorithm>
+#include <functional>
+
+void Guard::LockSlow()
+{
+	for( int i = 0; i < GUARD_SPIN_COUNT; ++i )
+	{
+		int expected = 0;
+
+		if( state.load(std::memory_order_relaxed) == 0 &&
+			state.compare_exchange_weak(expected, 1, std::memory_order_acquire) )
+		{
+			return;
+		}
+
+		CPU_PAUSE();
+	}
+
+	std::unique_lock<std::mutex> lock(parkmutex);
+
+	// leaves 2 behind, so the owner will wake us in Unlock()
+	while( state.exchange(2, std::memory_order_acquire) != 0 )
+		parked.wait(lock);
+}
+
+void Guard::UnlockSlow()
+{
+	std::lock_guard<std::mutex> lock(parkmutex);
+	parked.notify_one();
+}
+
+void Signal::Fire()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	state.store(true);
+	fired.notify_all();
+
+	for( size_t i = 0; i < combos.size(); ++i )
+	{
+		std::lock_guard<std::mutex> combolock(combos[i]->mutex);
+		combos[i]->changed.notify_all();
+	}
+}
+
+void Signal::Halt()
+{
+	state.store(false);
+}
+
+void Signal::Wait()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while( !state.load() )
+		fired.wait(lock);
+}
+
+size_t SignalCombo::Add(const Signal* sn)
+{
+	signals.push_back(const_cast<Signal*>(sn));
+	return signals.size() - 1;
+}
+
+void SignalCombo::Register()
+{
+	// NOTE: before checking the states, so a Fire() in between is not lost
+	for( size_t i = 0; i < signals.size(); ++i )
+	{
+		std::lock_guard<std::mutex> lock(signals[i]->mutex);
+		signals[i]->combos.push_back(this);
+	}
+}
+
+void SignalCombo::Unregister()
+{
+	for( size_t i = 0; i < signals.size(); ++i )
+	{
+		std::lock_guard<std::mutex> lock(signals[i]->mutex);
+		std::vector<SignalCombo*>& combos = signals[i]->combos;
+
+		combos.erase(std::find(combos.begin(), combos.end(), this));
+	}
+}
+
+size_t SignalCombo::WaitAny()
+{
+	size_t index = 0;
+
+	Register();
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		while( true )
+		{
+			for( index = 0; index < signals.size(); ++index )
+			{
+				if( signals[index]->state.load() )
+					break;
+			}
+
+			if( index < signals.size() )
+				break;
+
+			changed.wait(lock);
+		}
+	}
+	Unregister();
+
+	return index;
+}
+
+void SignalCombo::WaitAll()
+{
+	Register();
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		size_t count = 0;
+
+		while( count < signals.size() )
+		{
+			for( count = 0; count < signals.size(); ++count )
+			{
+				if( !signals[count]->state.load() )
+					break;
+			}
+
+			if( count < signals.size() )
+				changed.wait(lock);
+		}
+	}
+	Unregister();
+}
+
+void Thread::Run(emitter_base* emi)
+{
+	emi->emit();
+	delete emi;
+}
+
+Thread::Thread()
+{
+	emi = NULL;
+	handle = NULL;
+	id = 0;
+}
+
+Thread::~Thread()
+{
+	Close();
+}
+
+bool Thread::Create()
+{
+	// threads can't be created suspended, Start() does it
+	if( handle )
+	{
+		if( handle->joinable() )
+			handle->detach();
+
+		delete handle;
+		handle = NULL;
+	}
+
+	return true;
+}
+
+void Thread::Start()
+{
+	if( emi && !handle )
+	{
+		handle = new std::thread(&Thread::Run, emi);
+		id = (unsigned long)std::hash<std::thread::id>()(handle->get_id());
+		emi = NULL;
+	}
+}
+
+void Thread::Stop()
+{
+	// NOTE: threads can't be suspended, they have to return on their own
+}
+
+void Thread::Close()
+{
+	if( handle )
+	{
+		// keeps running if it didn't finish yet (like CloseHandle)
+		if( handle->joinable() )
+			handle->detach();
+
+		delete handle;
+		handle = NULL;
+	}
+
+	if( emi )
+	{
+		delete emi;
+		emi = NULL;
+	}
+}
+
+void Thread::Wait()
+{
+	if( handle && handle->joinable() )
+		handle->join();
+}
+
+void Thread::YieldCPU()
+{
+	std::this_thread::yield();
+}
+
+size_t Thread::NumCores()
+{
+	size_t count = std::thread::hardware_concurrency();
+	return (count > 0 ? count : 1);
+}
+
+#endif
+
+bool Thread::Attach(void (*func)())
+{
+	if( emi )
+		delete emi;
+
+	// trick
+	emi = new emitter<Thread>(func);
+	return Create();
+}
@@ -2,17 +2,143 @@
 #ifndef _THREAD_H_
 #define _THREAD_H_
 
-#include <Windows.h>
+#ifdef _WIN32
+#	include <Windows.h>
+#else
+#	include <thread>
+#	include <mutex>
+#	include <condition_variable>
+#endif
+
 #include <vector>
 
+#if !defined(_MSC_VER) || (_MSC_VER >= 1700)
+#	include <atomic>
+#	define HAS_STD_ATOMIC
+#else
+#	include <intrin.h>
+#endif
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#	include <emmintrin.h>
+#	define CPU_PAUSE()		_mm_pause()
+#else
+#	define CPU_PAUSE()
+#endif
+
+#ifdef _MSC_VER
+#	define THREAD_LOCAL		__declspec(thread)
+#else
+#	define THREAD_LOCAL		__thread
+#endif
+
+#define CACHE_LINE_SIZE		64
+#define GUARD_SPIN_COUNT	1000	// tries before a Guard puts the thread to sleep
+
+/**
+ * \brief Lock-free counter
+ *
+ * Loads acquire, stores release, read-modify-write operations are full barriers.
+ * VC10 has no <atomic>, there volatile accesses and interlocked intrinsics do the same.
+ */
+class AtomicSize
+{
+private:
+#ifdef HAS_STD_ATOMIC
+	std::atomic<size_t> value;
+#else
+	volatile size_t value;
+#endif
+
+	AtomicSize(const AtomicSize&);
+	AtomicSize& operator =(const AtomicSize&);
+
+public:
+	AtomicSize(size_t initial = 0)
+		: value(initial) {}
+
+#ifdef HAS_STD_ATOMIC
+	inline size_t Load() const {
+		return value.load(std::memory_order_acquire);
+	}
+
+	inline size_t LoadRelaxed() const {
+		return value.load(std::memory_order_relaxed);
+	}
+
+	inline void Store(size_t newvalue) {
+		value.store(newvalue, std::memory_order_release);
+	}
+
+	inline bool CompareExchange(size_t& expected, size_t desired) {
+		// on failure expected is updated to the current value
+		return value.compare_exchange_weak(expected, desired);
+	}
+
+	inline size_t FetchAdd(size_t amount) {
+		return value.fetch_add(amount);
+	}
+
+	static inline void Fence() {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+#else
+	inline size_t Load() const {
+		return value;
+	}
+
+	inline size_t LoadRelaxed() const {
+		return value;
+	}
+
+	inline void Store(size_t newvalue) {
+		value = newvalue;
+	}
+
+	inline bool CompareExchange(size_t& expected, size_t desired)
+	{
+#	ifdef _WIN64
+		size_t current = (size_t)_InterlockedCompareExchange64((volatile __int64*)&value, (__int64)desired, (__int64)expected);
+#	else
+		size_t current = (size_t)_InterlockedCompareExchange((volatile long*)&value, (long)desired, (long)expected);
+#	endif
+
+		if( current == expected )
+			return true;
+
+		expected = current;
+		return false;
+	}
+
+	inline size_t FetchAdd(size_t amount)
+	{
+#	ifdef _WIN64
+		return (size_t)_InterlockedExchangeAdd64((volatile __int64*)&value, (__int64)amount);
+#	else
+		return (size_t)_InterlockedExchangeAdd((volatile long*)&value, (long)amount);
+#	endif
+	}
+
+	static inline void Fence() {
+		MemoryBarrier();
+	}
+#endif
+};
+
+#ifdef _WIN32
+
+// critical sections already spin before they block
 class Guard
 {
 private:
 	CRITICAL_SECTION critsec;
 
+	Guard(const Guard&);
+	Guard& operator =(const Guard&);
+
 public:
 	Guard() {
-		InitializeCriticalSection(&critsec);
+		InitializeCriticalSectionAndSpinCount(&critsec, GUARD_SPIN_COUNT);
 	}
 
 	~Guard() {
@@ -37,7 +163,7 @@ private:
 
 public:
 	Signal() {
-		handle = CreateEvent(NULL, TRUE, FALSE, NULL); 
+		handle = CreateEvent(NULL, TRUE, FALSE, NULL);
 	}
 
 	~Signal() {
@@ -82,6 +208,111 @@ public:
 	void WaitAll();
 };
 
+#else
+
+/**
+ * \brief Adaptive mutex
+ *
+ * Uncontended Lock() and Unlock() are one atomic operation each. Under contention
+ * the thread spins for a while, then sleeps until an Unlock() wakes it up.
+ */
+class Guard
+{
+private:
+	std::atomic<int>		state;	// 0: free, 1: locked, 2: locked and somebody might sleep
+	std::mutex				parkmutex;
+	std::condition_variable	parked;
+
+	Guard(const Guard&);
+	Guard& operator =(const Guard&);
+
+	void LockSlow();
+	void UnlockSlow();
+
+public:
+	Guard()
+		: state(0) {}
+
+	inline void Lock()
+	{
+		int expected = 0;
+
+		if( !state.compare_exchange_strong(expected, 1, std::memory_order_acquire) )
+			LockSlow();
+	}
+
+	inline void Unlock()
+	{
+		if( state.exchange(0, std::memory_order_release) == 2 )
+			UnlockSlow();
+	}
+};
+
+class SignalCombo;
+
+// manual reset event, like on Windows
+class Signal
+{
+	friend class SignalCombo;
+
+private:
+	std::mutex					mutex;
+	std::condition_variable		fired;
+	std::vector<SignalCombo*>	combos;	// the ones waiting on this right now
+	std::atomic<bool>			state;
+
+	Signal(const Signal&);
+	Signal& operator =(const Signal&);
+
+public:
+	Signal()
+		: state(false) {}
+
+	~Signal() {
+		Close();
+	}
+
+	void Fire();
+	void Halt();
+	void Wait();
+
+	inline void Close() {
+		// nothing to release
+	}
+};
+
+class SignalCombo
+{
+	friend class Signal;
+
+private:
+	std::vector<Signal*>	signals;
+	std::mutex				mutex;
+	std::condition_variable	changed;
+
+	SignalCombo(const SignalCombo&);
+	SignalCombo& operator =(const SignalCombo&);
+
+	void Register();
+	void Unregister();
+
+public:
+	SignalCombo() {
+		signals.reserve(10);
+	}
+
+	~SignalCombo() {
+		signals.clear();
+	}
+
+	size_t Add(const Signal* sn);
+	size_t WaitAny();
+
+	void WaitAll();
+};
+
+#endif
+
 class Thread
 {
 	class emitter_base
@@ -124,11 +355,24 @@ class Thread
 	};
 
 private:
+#ifdef _WIN32
 	HANDLE			handle;
 	emitter_base*	emi;
 	unsigned long	id;
-	
+
 	static unsigned long __stdcall Run(void* param);
+#else
+	std::thread*	handle;
+	emitter_base*	emi;	// owned by the thread after Start()
+	unsigned long	id;
+
+	static void Run(emitter_base* emi);
+#endif
+
+	Thread(const Thread&);
+	Thread& operator =(const Thread&);
+
+	bool Create();
 
 public:
 	Thread();
@@ -141,18 +385,20 @@ public:
 	void Start();
 	void Stop();
 	void Close();
+	void Wait();
 
-	inline void Wait() {
-		WaitForSingleObject(handle, INFINITE);
-	}
+	static void YieldCPU();
+	static size_t NumCores();
 
 	inline int GetID() const {
 		return id;
 	}
 
+#ifdef _WIN32
 	inline HANDLE GetHandle() const {
 		return handle;
 	}
+#endif
 };
 
 template <typename callable_type>
@@ -162,11 +408,7 @@ bool Thread::Attach(callable_type* obj, void (callable_type::*memfunc)())
 		delete emi;
 
 	emi = new emitter<callable_type>(obj, memfunc);
-
-	handle = CreateThread(
-		NULL, 0, (LPTHREAD_START_ROUTINE)&Thread::Run, emi, CREATE_SUSPENDED, &id);
-
-	return (handle != INVALID_HANDLE_VALUE);
+	return Create();
 }
 
 #endif
@@ -0,0 +1,72 @@
+
+#include "arena.hpp"
+#include <cstdlib>
+
+#define ARENA_ALIGNMENT		(2 * sizeof(void*))
+#define ARENA_ALIGN(x)		(((x) + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1))
+
+arena::arena(size_t blocksize)
+{
+	this->blocks = 0;
+	this->objects = 0;
+	this->blocksize = blocksize;
+	this->count = 0;
+}
+
+arena::~arena()
+{
+	clear();
+
+	if( blocks )
+	{
+		free(blocks);
+		blocks = 0;
+	}
+}
+
+void* arena::allocate(size_t size)
+{
+	size = ARENA_ALIGN(size);
+
+	if( !blocks || blocks->used + size > blocks->size )
+	{
+		size_t datasize = (size > blocksize ? size : blocksize);
+		block* newblock = (block*)malloc(ARENA_ALIGN(sizeof(block)) + datasize);
+
+		if( !newblock )
+			throw std::bad_alloc();
+
+		newblock->next = blocks;
+		newblock->size = datasize;
+		newblock->used = 0;
+
+		blocks = newblock;
+	}
+
+	char* ret = (char*)blocks + ARENA_ALIGN(sizeof(block)) + blocks->used;
+	blocks->used += size;
+
+	return ret;
+}
+
+void arena::clear()
+{
+	// newest first
+	for( header* hdr = objects; hdr != 0; hdr = hdr->next )
+		hdr->destroy(hdr + 1);
+
+	objects = 0;
+	count = 0;
+
+	// keep the last block for the next round
+	while( blocks && blocks->next )
+	{
+		block* next = blocks->next;
+
+		free(blocks);
+		blocks = next;
+	}
+
+	if( blocks )
+		blocks->used = 0;
+}
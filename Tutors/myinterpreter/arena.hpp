@@ -0,0 +1,63 @@
+
+#ifndef _ARENA_HPP_
+#define _ARENA_HPP_
+
+#include <new>
+#include <cstddef>
+
+// bump pointer allocator, objects are destroyed all at once in clear()
+class arena
+{
+	struct block
+	{
+		block*	next;
+		size_t	size;
+		size_t	used;
+	};
+
+	struct header
+	{
+		header*	next;
+		void	(*destroy)(void*);
+	};
+
+	template <typename value_type>
+	static void destroy(void* ptr) {
+		static_cast<value_type*>(ptr)->~value_type();
+	}
+
+private:
+	block*	blocks;
+	header*	objects;
+	size_t	blocksize;
+	size_t	count;
+
+	void* allocate(size_t size);
+
+public:
+	arena(size_t blocksize = 65536);
+	~arena();
+
+	void clear();
+
+	template <typename value_type>
+	value_type* construct() {
+		header* hdr = (header*)allocate(sizeof(header) + sizeof(value_type));
+		value_type* ret = new(hdr + 1) value_type();
+
+		// link it only when the constructor succeeded
+		hdr->destroy = &arena::destroy<value_type>;
+		hdr->next = objects;
+
+		objects = hdr;
+		++count;
+
+		return ret;
+	}
+
+	inline size_t size() const {
+		return count;
+	}
+};
+
+#endif
@@ -1,101 +1,253 @@
 
 #include "bytestream.h"
+#include <algorithm>
 #include <cstring>
 
+#define MIN_SEGMENT_SIZE	256
+#define MAX_SPLICE_COPY		64	// smaller streams are copied instead of moved
+
 bytestream::bytestream()
 {
 	mysize = 0;
-	mycap = 0;
-	mydata = 0;
 }
 
 bytestream::bytestream(const bytestream& other)
 {
 	mysize = 0;
-	mycap = 0;
-	mydata = 0;
-
 	operator =(other);
 }
 
 bytestream::~bytestream()
 {
-	if( mydata )
+	for( size_t i = 0; i < segments.size(); ++i )
+		delete[] segments[i].data;
+
+	segments.clear();
+}
+
+void bytestream::grow(size_t extra)
+{
+	if( !segments.empty() )
 	{
-		delete[] mydata;
-		mydata = 0;
+		segment& last = segments.back();
+
+		if( last.size + extra <= last.cap )
+			return;
+
+		if( segments.size() == 1 )
+		{
+			// contiguous, grow geometrically
+			reserve(std::max<size_t>(last.cap * 2, last.size + extra));
+			return;
+		}
 	}
+
+	// new segment proportional to the total size
+	segment seg;
+
+	seg.cap = std::max<size_t>(std::max<size_t>(MIN_SEGMENT_SIZE, mysize / 2), extra);
+	seg.data = new char[seg.cap];
+	seg.size = 0;
+
+	segments.push_back(seg);
+}
+
+void bytestream::write(const void* data, size_t size)
+{
+	grow(size);
+
+	segment& last = segments.back();
+
+	memcpy(last.data + last.size, data, size);
+
+	last.size += size;
+	mysize += size;
 }
 
 void bytestream::clear()
 {
+	// keep the first buffer
+	for( size_t i = 1; i < segments.size(); ++i )
+		delete[] segments[i].data;
+
+	if( segments.size() > 1 )
+		segments.resize(1);
+
+	if( !segments.empty() )
+		segments[0].size = 0;
+
+	relocs.clear();
+	marks.clear();
 	mysize = 0;
 }
 
+void bytestream::flatten()
+{
+	if( segments.size() < 2 )
+		return;
+
+	segment seg;
+
+	seg.cap = std::max<size_t>(MIN_SEGMENT_SIZE, mysize);
+	seg.data = new char[seg.cap];
+	seg.size = 0;
+
+	for( size_t i = 0; i < segments.size(); ++i )
+	{
+		memcpy(seg.data + seg.size, segments[i].data, segments[i].size);
+		seg.size += segments[i].size;
+
+		delete[] segments[i].data;
+	}
+
+	segments.resize(1);
+	segments[0] = seg;
+}
+
 void bytestream::reserve(size_t newcap)
 {
-	if( mycap >= newcap )
+	flatten();
+
+	if( !segments.empty() && segments[0].cap >= newcap )
 		return;
 
-	char* newdata = new char[newcap];
+	segment seg;
+
+	seg.cap = std::max<size_t>(MIN_SEGMENT_SIZE, newcap);
+	seg.data = new char[seg.cap];
+	seg.size = mysize;
+
+	if( !segments.empty() )
+	{
+		memcpy(seg.data, segments[0].data, mysize);
+		delete[] segments[0].data;
 
-	if( mydata && mysize > 0 )
-		memcpy(newdata, mydata, mysize);
+		segments[0] = seg;
+	}
+	else
+		segments.push_back(seg);
+}
 
-	if( mydata )
-		delete[] mydata;
+void bytestream::swap(bytestream& other)
+{
+	segments.swap(other.segments);
+	relocs.swap(other.relocs);
+	marks.swap(other.marks);
 
-	mydata = newdata;
-	mycap = newcap;
+	std::swap(mysize, other.mysize);
 }
 
-void bytestream::replace(void* what, void* with, size_t size)
+void bytestream::clear_relocations()
 {
-	size_t start = 0;
+	relocs.clear();
+}
 
-	// bruteforce...
-	while( (start + size) <= mysize )
+bytestream& bytestream::splice(bytestream& other)
+{
+	if( &other == this || other.mysize == 0 )
+		return *this;
+
+	if( mysize == 0 )
 	{
-		if( memcmp(mydata + start, what, size) == 0 )
-		{
-			memcpy(mydata + start, with, size);
-			start += size;
-		}
+		// take everything, other gets the empty buffer
+		swap(other);
+
+		// our marks were at the start
+		marks.insert(marks.begin(), other.marks.begin(), other.marks.end());
+		other.marks.clear();
+
+		return *this;
+	}
+
+	if( other.mysize <= MAX_SPLICE_COPY || segments.back().size + other.mysize <= segments.back().cap )
+	{
+		operator <<(other);
+		other.clear();
+
+		return *this;
+	}
+
+	// move the segments
+	for( size_t i = 0; i < other.relocs.size(); ++i )
+		relocs.push_back(mysize + other.relocs[i]);
+
+	for( size_t i = 0; i < other.marks.size(); ++i )
+		marks.push_back(std::make_pair(mysize + other.marks[i].first, other.marks[i].second));
+
+	for( size_t i = 0; i < other.segments.size(); ++i )
+	{
+		if( other.segments[i].size > 0 )
+			segments.push_back(other.segments[i]);
 		else
-			++start;
+			delete[] other.segments[i].data;
 	}
+
+	mysize += other.mysize;
+
+	other.segments.clear();
+	other.relocs.clear();
+	other.marks.clear();
+	other.mysize = 0;
+
+	return *this;
 }
 
-bytestream& bytestream::operator <<(unsigned char value)
+bytestream& bytestream::relocate()
 {
-	if( (mysize + sizeof(unsigned char)) > mycap )
-		reserve(mysize + 1024);
+	// the next entry will be patched
+	relocs.push_back(mysize);
+	return *this;
+}
+
+void bytestream::mark(size_t off, int line)
+{
+	// code from 'off' comes from this line, until a later (or inner) mark
+	linetable::iterator it = marks.end();
+
+	while( it != marks.begin() && (it - 1)->first >= off )
+		--it;
 
-	*((unsigned char*)(mydata + mysize)) = value;
-	mysize += sizeof(unsigned char);
+	marks.insert(it, std::make_pair(off, line));
+}
 
+bytestream& bytestream::operator <<(unsigned char value)
+{
+	write(&value, sizeof(unsigned char));
 	return *this;
 }
 
 bytestream& bytestream::operator <<(int value)
 {
-	if( (mysize + sizeof(int)) > mycap )
-		reserve(mysize + 1024);
-
-	*((int*)(mydata + mysize)) = value;
-	mysize += sizeof(int);
-
+	write(&value, sizeof(int));
 	return *this;
 }
 
 bytestream& bytestream::operator <<(const bytestream& other)
 {
-	if( other.mydata && other.mysize > 0 )
+	if( &other == this )
 	{
-		if( (mysize + other.mysize) > mycap )
-			reserve(mysize + other.mysize + 512);
+		bytestream tmp(other);
+		return splice(tmp);
+	}
+
+	for( size_t i = 0; i < other.relocs.size(); ++i )
+		relocs.push_back(mysize + other.relocs[i]);
+
+	for( size_t i = 0; i < other.marks.size(); ++i )
+		marks.push_back(std::make_pair(mysize + other.marks[i].first, other.marks[i].second));
+
+	if( other.mysize > 0 )
+	{
+		grow(other.mysize);
+
+		segment& last = segments.back();
+
+		for( size_t i = 0; i < other.segments.size(); ++i )
+		{
+			memcpy(last.data + last.size, other.segments[i].data, other.segments[i].size);
+			last.size += other.segments[i].size;
+		}
 
-		memcpy(mydata + mysize, other.mydata, other.mysize);
 		mysize += other.mysize;
 	}
 
@@ -106,11 +258,8 @@ bytestream& bytestream::operator =(const bytestream& other)
 {
 	if( &other != this )
 	{
-		if( mycap < other.mycap )
-			reserve(other.mycap);
-
-		memcpy(mydata, other.mydata, other.mysize);
-		mysize = other.mysize;
+		clear();
+		operator <<(other);
 	}
 
 	return *this;
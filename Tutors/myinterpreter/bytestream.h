@@ -2,12 +2,32 @@
 #ifndef _BYTESTREAM_H_
 #define _BYTESTREAM_H_
 
+#include <vector>
+#include <utility>
+
+// NOTE: a list of segments; splice() moves them, data() flattens
 class bytestream
 {
+	struct segment
+	{
+		char*	data;
+		size_t	size;
+		size_t	cap;
+	};
+
+	typedef std::vector<segment> segmentlist;
+
+public:
+	typedef std::vector<size_t> relocationlist;
+	typedef std::vector<std::pair<size_t, int> > linetable;
+
 private:
-	char* mydata;
+	segmentlist segments;
+	relocationlist relocs;	// offsets of entries the linker has to patch
+	linetable marks;		// (offset, source line) where a line starts
 	size_t mysize;
-	size_t mycap;
+
+	void grow(size_t extra);
 
 public:
 	bytestream();
@@ -15,8 +35,16 @@ public:
 	~bytestream();
 
 	void clear();
+	void flatten();
 	void reserve(size_t newcap);
-	void replace(void* what, void* with, size_t size);
+	void swap(bytestream& other);
+	void clear_relocations();
+
+	void write(const void* data, size_t size);
+
+	bytestream& splice(bytestream& other);
+	bytestream& relocate();
+	void mark(size_t off, int line);
 
 	bytestream& operator <<(unsigned char value);
 	bytestream& operator <<(int value);
@@ -28,16 +56,27 @@ public:
 		return mysize;
 	}
 
+	inline const relocationlist& relocations() const {
+		return relocs;
+	}
+
+	inline const linetable& lines() const {
+		return marks;
+	}
+
 	inline char* data() {
-		return mydata;
+		if( segments.size() > 1 )
+			flatten();
+
+		return (segments.empty() ? 0 : segments[0].data);
 	}
 
 	inline char* seek_set(size_t off) {
-		return (mydata + off);
+		return (data() + off);
 	}
 
 	inline char* seek_end(size_t off) {
-		return (mydata + (mysize - off));
+		return (data() + (mysize - off));
 	}
 };
 
@@ -0,0 +1,321 @@
+
+#ifdef _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <windows.h>
+#	include <direct.h>
+#else
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+#include "interpreter.h"
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+
+#define IMAGE_MAGIC		0x4349424d	// 'MBIC'
+#define IMAGE_VERSION	4
+
+#define FNV_OFFSET		2166136261u
+#define FNV_PRIME		16777619u
+
+// precompiled image: header, code, (length, characters) for each string, then the line table
+struct image_header
+{
+	unsigned int magic;
+	unsigned int version;
+	unsigned int entrysize;		// images are not portable between 32/64 bit
+	unsigned int numregisters;
+	unsigned int hash;			// of the source
+	int entry;
+	unsigned int codesize;
+	unsigned int numstrings;
+	unsigned int numlines;		// (offset, line) pairs for the profiler
+};
+
+struct mapped_file
+{
+	const char* data;
+	size_t size;
+
+#ifdef _WIN32
+	HANDLE file;
+	HANDLE mapping;
+#endif
+};
+
+static bool Map_File(mapped_file& out, const std::string& file)
+{
+	out.data = 0;
+	out.size = 0;
+
+#ifdef _WIN32
+	out.file = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	out.mapping = 0;
+
+	if( out.file == INVALID_HANDLE_VALUE )
+		return false;
+
+	out.size = (size_t)GetFileSize(out.file, 0);
+
+	if( out.size > 0 )
+		out.mapping = CreateFileMappingA(out.file, 0, PAGE_READONLY, 0, 0, 0);
+
+	if( out.mapping )
+		out.data = (const char*)MapViewOfFile(out.mapping, FILE_MAP_READ, 0, 0, 0);
+
+	if( !out.data )
+	{
+		if( out.mapping )
+			CloseHandle(out.mapping);
+
+		CloseHandle(out.file);
+		return false;
+	}
+#else
+	int fd = open(file.c_str(), O_RDONLY);
+	struct stat st;
+
+	if( fd == -1 )
+		return false;
+
+	if( fstat(fd, &st) == 0 && st.st_size > 0 )
+	{
+		void* mem = mmap(0, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if( mem != MAP_FAILED )
+		{
+			out.data = (const char*)mem;
+			out.size = (size_t)st.st_size;
+		}
+	}
+
+	// the mapping stays valid
+	close(fd);
+
+	if( !out.data )
+		return false;
+#endif
+
+	return true;
+}
+
+static void Unmap_File(mapped_file& file)
+{
+#ifdef _WIN32
+	UnmapViewOfFile(file.data);
+	CloseHandle(file.mapping);
+	CloseHandle(file.file);
+#else
+	munmap((void*)file.data, file.size);
+#endif
+
+	file.data = 0;
+	file.size = 0;
+}
+
+unsigned int Interpreter::Hash(const void* data, size_t size, unsigned int seed)
+{
+	// FNV-1a, seed 0 means a new hash
+	const unsigned char* bytes = (const unsigned char*)data;
+	unsigned int hash = (seed == 0 ? FNV_OFFSET : seed);
+
+	for( size_t i = 0; i < size; ++i )
+	{
+		hash ^= bytes[i];
+		hash *= FNV_PRIME;
+	}
+
+	return hash;
+}
+
+bool Interpreter::Save(const std::string& file)
+{
+	assert(false, "Interpreter::Save(): Nothing to save", program.size() > 0);
+	assert(false, "Interpreter::Save(): Program is not linked", functions.empty() && program.relocations().empty());
+
+#ifdef _MSC_VER
+	FILE* outfile = NULL;
+	fopen_s(&outfile, file.c_str(), "wb");
+#else
+	FILE* outfile = fopen(file.c_str(), "wb");
+#endif
+
+	assert(false, "Interpreter::Save(): Could not create file", outfile);
+
+	image_header header;
+
+	header.magic = IMAGE_MAGIC;
+	header.version = IMAGE_VERSION;
+	header.entrysize = ENTRY_SIZE;
+	header.numregisters = (unsigned int)numregisters;
+	header.hash = sourcehash;
+	header.entry = entry;
+	header.codesize = (unsigned int)program.size();
+	header.numstrings = (unsigned int)strings.size();
+	header.numlines = (unsigned int)program.lines().size();
+
+	fwrite(&header, sizeof(image_header), 1, outfile);
+	fwrite(program.data(), 1, program.size(), outfile);
+
+	for( size_t i = 0; i < strings.size(); ++i )
+	{
+		unsigned int length = (unsigned int)strings[i].length();
+
+		fwrite(&length, sizeof(unsigned int), 1, outfile);
+		fwrite(strings[i].data(), 1, length, outfile);
+	}
+
+	for( size_t i = 0; i < program.lines().size(); ++i )
+	{
+		unsigned int mark[2] = { (unsigned int)program.lines()[i].first, (unsigned int)program.lines()[i].second };
+		fwrite(mark, sizeof(unsigned int), 2, outfile);
+	}
+
+	bool ok = (ferror(outfile) == 0);
+	fclose(outfile);
+
+	assert(false, "Interpreter::Save(): Could not write file", ok);
+	return true;
+}
+
+bool Interpreter::Load(const std::string& file, unsigned int hash)
+{
+	// NOTE: a loaded image has no symbols, so it can't be appended to
+	mapped_file image;
+	image_header header;
+
+	if( !Map_File(image, file) )
+		return false;
+
+	if( image.size < sizeof(image_header) )
+	{
+		Unmap_File(image);
+		return false;
+	}
+
+	memcpy(&header, image.data, sizeof(image_header));
+
+	bool valid = (
+		header.magic == IMAGE_MAGIC &&
+		header.version == IMAGE_VERSION &&
+		header.entrysize == ENTRY_SIZE &&
+		(hash == 0 || header.hash == hash) &&
+		header.codesize > 0 &&
+		(header.codesize % ENTRY_SIZE) == 0 &&
+		header.entry >= 0 && (unsigned int)header.entry < header.codesize &&
+		header.codesize <= image.size - sizeof(image_header));
+
+	std::vector<std::string> table;
+	size_t off = sizeof(image_header) + header.codesize;
+
+	for( unsigned int i = 0; valid && i < header.numstrings; ++i )
+	{
+		unsigned int length;
+
+		if( image.size - off < sizeof(unsigned int) )
+		{
+			valid = false;
+			break;
+		}
+
+		memcpy(&length, image.data + off, sizeof(unsigned int));
+		off += sizeof(unsigned int);
+
+		if( image.size - off < length )
+		{
+			valid = false;
+			break;
+		}
+
+		table.push_back(std::string(image.data + off, length));
+		off += length;
+	}
+
+	if( valid && (image.size - off) / (2 * sizeof(unsigned int)) < header.numlines )
+		valid = false;
+
+	if( !valid )
+	{
+		Unmap_File(image);
+		return false;
+	}
+
+	Cleanup();
+
+	program.clear();
+	program.write(image.data + sizeof(image_header), header.codesize);
+
+	for( unsigned int i = 0; i < header.numlines; ++i )
+	{
+		unsigned int mark[2];
+
+		memcpy(mark, image.data + off + i * sizeof(mark), sizeof(mark));
+		program.mark(mark[0], (int)mark[1]);
+	}
+
+	Unmap_File(image);
+
+	functions.clear();
+	strings.swap(table);
+
+	progname = file;
+	sourcehash = header.hash;
+	entry = header.entry;
+
+	if( header.numregisters > numregisters )
+		SetRegisterCount(header.numregisters);
+
+	Invalidate();
+	return true;
+}
+
+bool Interpreter::CompileCached(const std::string& file, const std::string& cachedir)
+{
+	// images are named after the hash of the source
+	mapped_file source;
+
+	if( !Map_File(source, file) )
+		return Compile(file);
+
+	unsigned int hash = Hash(source.data, source.size, 0);
+	Unmap_File(source);
+
+	std::stringstream ss;
+	ss << cachedir << "/" << std::hex << std::setw(8) << std::setfill('0') << hash << ".pbc";
+
+	std::string image = ss.str();
+
+	if( Load(image, hash) )
+	{
+		std::cout << "Loaded '" << file << "' from '" << image << "'\n";
+		progname = file;
+
+		return true;
+	}
+
+	if( !Compile(file) )
+		return false;
+
+	AllocateRegisters();
+	Inline();
+	Optimize();
+
+	// an unlinked image can't be run, don't cache it
+	if( !Link() )
+		return false;
+
+#ifdef _WIN32
+	_mkdir(cachedir.c_str());
+#else
+	mkdir(cachedir.c_str(), 0755);
+#endif
+
+	if( !Save(image) )
+		warn("Interpreter::CompileCached(): Could not cache '" << file << "'");
+
+	return true;
+}
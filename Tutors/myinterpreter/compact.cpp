@@ -0,0 +1,439 @@
+
+#include "interpreter.h"
+#include <cstring>
+
+// compact entry: [opcode:8][a:4][b:4][imm:16], b holds flags if it's not a register
+#define C_OPCODE(w)		((w) & 0xff)
+#define C_REGA(w)		(((w) >> 8) & 0xf)
+#define C_REGB(w)		(((w) >> 12) & 0xf)
+#define C_POOLED		0x1000	// imm is a constant pool index
+#define C_IMM(w)		(((w) & C_POOLED) ? constants[(w) >> 16].i : (int)(short)((w) >> 16))
+#define C_EXT()			((int)code[(registers[EIP] += 4) / 4 - 1])
+#define C_STACK_INT(o)	*((int*)(stack + o))
+
+// executes the setcc part, then the jz that follows it
+#define C_SET_JZ(cond) \
+	{ \
+		rega = (cond); \
+		word = code[registers[EIP] / 4]; \
+		registers[EIP] += 4; \
+		if( rega == 0 ) \
+			registers[EIP] += C_IMM(word); \
+	}
+
+enum operand_kind
+{
+	Kind_None = 0,	// opcode only
+	Kind_Reg,		// a = arg1
+	Kind_RegReg,	// a = arg1, b = arg2
+	Kind_RegImm,	// a = arg1, imm = arg2
+	Kind_ImmReg,	// imm = arg1, a = arg2
+	Kind_Imm,		// imm = arg1
+	Kind_ImmImm,	// imm = arg1, next word = arg2
+	Kind_Special	// imm = pool index of arg1 (arg2 follows it in the pool)
+};
+
+static operand_kind Operand_Kind(unsigned char opcode)
+{
+	if( opcode < 0x20 )
+		return Kind_Special;
+
+	if( (opcode >= OP_SETL_RS && opcode <= OP_SETNE_RR) || (opcode >= OP_SETL_JZ_RS && opcode <= OP_SETNE_JZ_RR) ||
+		(opcode >= OP_FSUB_RS && opcode <= OP_FDIV_RR) || (opcode >= OP_FSETL_RS && opcode <= OP_FSETNE_RR) )
+		return ((opcode & 1) ? Kind_RegReg : Kind_RegImm);
+
+	switch( opcode )
+	{
+	case OP_PUSH:
+	case OP_POP:
+	case OP_NOT:
+	case OP_NEG:
+	case OP_FNEG:
+	case OP_CVT_IF:
+	case OP_CVT_FI:
+		return Kind_Reg;
+
+	case OP_MOV_RR:
+	case OP_AND_RR:
+	case OP_OR_RR:
+	case OP_SUB_RR:
+	case OP_ADD_RR:
+	case OP_MUL_RR:
+	case OP_DIV_RR:
+	case OP_MOD_RR:
+		return Kind_RegReg;
+
+	case OP_PUSHADD:
+	case OP_MOV_RS:
+	case OP_MOV_RM:
+	case OP_AND_RS:
+	case OP_OR_RS:
+	case OP_SUB_RS:
+	case OP_ADD_RS:
+	case OP_MUL_RS:
+	case OP_DIV_RS:
+	case OP_MOD_RS:
+	case OP_JZ:
+	case OP_JNZ:
+		return Kind_RegImm;
+
+	case OP_MOV_MR:
+		return Kind_ImmReg;
+
+	case OP_JMP:
+		return Kind_Imm;
+
+	case OP_MOV_MM:
+	case OP_MOV_MS:
+	case OP_ADD_MS:
+		return Kind_ImmImm;
+
+	default:
+		break;
+	}
+
+	return Kind_None;
+}
+
+static bool Fits_Compact(operand_kind kind, int arg1, int arg2)
+{
+	// register fields are 4 bits wide
+	if( (kind == Kind_Reg || kind == Kind_RegReg || kind == Kind_RegImm) && (arg1 < 0 || arg1 > 15) )
+		return false;
+
+	if( (kind == Kind_RegReg || kind == Kind_ImmReg) && (arg2 < 0 || arg2 > 15) )
+		return false;
+
+	return true;
+}
+
+unsigned int Interpreter::Compact_Imm(int value)
+{
+	if( value >= -32768 && value <= 32767 )
+		return ((unsigned int)(value & 0xffff) << 16);
+
+	operand op;
+	op.i = value;
+
+	constants.push_back(op);
+	return ((unsigned int)(constants.size() - 1) << 16) | C_POOLED;
+}
+
+size_t Interpreter::Compact()
+{
+	codelist code;
+	std::vector<size_t> position;
+	size_t count;
+
+	compact.clear();
+	constants.clear();
+
+	if( !Decode(code) || code.empty() )
+		return 0;
+
+	count = code.size();
+	position.resize(count + 1);
+	position[0] = 0;
+
+	// calculate new addresses first (needed by jumps)
+	for( size_t i = 0; i < count; ++i )
+		position[i + 1] = position[i] + (Operand_Kind(code[i].opcode) == Kind_ImmImm ? 2 : 1);
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		const code_entry& e = code[i];
+		operand_kind kind = Operand_Kind(e.opcode);
+		unsigned int word = e.opcode;
+		int arg1 = e.arg1;
+		int arg2 = e.arg2;
+
+		if( e.target >= 0 )
+		{
+			// relative to the next entry, in bytes
+			int off = (int)(position[e.target] - position[i + 1]) * 4;
+
+			if( e.opcode == OP_JMP )
+				arg1 = off;
+			else
+				arg2 = off;
+		}
+		else if( e.opcode == OP_JMP )
+		{
+			compact.clear();
+			nassert(0, "Interpreter::Compact(): Program is not linked", true);
+		}
+
+		if( !Fits_Compact(kind, arg1, arg2) )
+		{
+			compact.clear();
+			nassert(0, "Interpreter::Compact(): Register index does not fit in 4 bits", true);
+		}
+
+		switch( kind )
+		{
+		case Kind_Reg:
+			word |= (arg1 << 8);
+			break;
+
+		case Kind_RegReg:
+			word |= (arg1 << 8) | (arg2 << 12);
+			break;
+
+		case Kind_RegImm:
+			word |= (arg1 << 8) | Compact_Imm(arg2);
+			break;
+
+		case Kind_ImmReg:
+			word |= (arg2 << 8) | Compact_Imm(arg1);
+			break;
+
+		case Kind_Imm:
+		case Kind_ImmImm:
+			word |= Compact_Imm(arg1);
+			break;
+
+		case Kind_Special: {
+			// both operands go to the pool
+			operand op1, op2;
+
+			op1.i = arg1;
+			op2.i = arg2;
+
+			word |= ((unsigned int)constants.size() << 16) | C_POOLED;
+
+			constants.push_back(op1);
+			constants.push_back(op2);
+			} break;
+
+		default:
+			break;
+		}
+
+		compact.push_back(word);
+
+		if( kind == Kind_ImmImm )
+			compact.push_back((unsigned int)arg2);
+	}
+
+	if( constants.size() > 0xffff )
+	{
+		compact.clear();
+		nassert(0, "Interpreter::Compact(): Constant pool is too large", true);
+	}
+
+	compactentry = (int)position[entry / ENTRY_SIZE] * 4;
+
+	std::cout << "Compact encoding: " << program.size() << " bytes -> " << compact.size() * 4 << " bytes + " <<
+		constants.size() << " constants\n";
+
+	return compact.size() * 4;
+}
+
+bool Interpreter::Run_Compact(vm_context& ctx)
+{
+	int* registers = ctx.registers;
+	char* stack = ctx.stack;
+
+	// first run compacts, the others wait for it
+	prepareguard.Lock();
+
+	bool ready = (!compact.empty() || Compact() > 0);
+
+	if( !ready )
+		compact.clear();
+
+	prepareguard.Unlock();
+
+	if( !ready )
+	{
+		warn("Interpreter::Run(): Could not compact program, falling back to switch dispatch");
+		return Run_Switch(ctx);
+	}
+
+	memset(registers, 0, numregisters * sizeof(int));
+
+	registers[EBP] = STACK_SIZE;
+	registers[ESP] = STACK_SIZE;
+	registers[EIP] = compactentry;
+
+	const unsigned int* code = &compact[0];
+	size_t bytesize = compact.size() * 4;
+	size_t stackdepth = 0;
+	unsigned int word;
+	int value;
+
+	while( (size_t)registers[EIP] < bytesize )
+	{
+		word = code[registers[EIP] / 4];
+		registers[EIP] += 4;
+
+		int& rega = registers[C_REGA(word)];
+		int& regb = registers[C_REGB(word)];
+
+		switch( C_OPCODE(word) )
+		{
+		case OP_PRINT_R:
+		case OP_PRINT_M:
+		case OP_PRINT_F: {
+			const operand* args = &constants[word >> 16];
+			(*op_special[C_OPCODE(word)])(args[0].i, args[1].i);
+			} break;
+
+		case OP_PUSH:
+		case OP_PUSHADD: {
+			int& esp = registers[ESP];
+
+			value = (C_OPCODE(word) == OP_PUSH ? rega : rega + C_IMM(word));
+			esp -= 4;
+
+			nassert(false, "EXCEPTION: Stack overflow", esp < 0);
+
+			C_STACK_INT(esp) = value;
+			++stackdepth;
+			} break;
+
+		case OP_POP: {
+			int& esp = registers[ESP];
+
+			nassert(false, "EXCEPTION: Stack underflow", stackdepth == 0);
+
+			rega = C_STACK_INT(esp);
+			esp += 4;
+
+			--stackdepth;
+			} break;
+
+		case OP_MOV_RS:
+			rega = C_IMM(word);
+			break;
+
+		case OP_MOV_RR:
+			rega = regb;
+			break;
+
+		case OP_MOV_RM:
+			rega = C_STACK_INT(registers[EBP] + C_IMM(word));
+			break;
+
+		case OP_MOV_MR:
+			C_STACK_INT(registers[EBP] + C_IMM(word)) = rega;
+			break;
+
+		case OP_MOV_MM:
+			value = C_IMM(word);
+			C_STACK_INT(registers[EBP] + value) = C_STACK_INT(registers[EBP] + C_EXT());
+			break;
+
+		case OP_MOV_MS:
+			value = C_IMM(word);
+			C_STACK_INT(registers[EBP] + value) = C_EXT();
+			break;
+
+		case OP_ADD_MS:
+			value = C_IMM(word);
+			C_STACK_INT(registers[EBP] + value) += C_EXT();
+			break;
+
+		case OP_AND_RS:	rega = (rega && C_IMM(word));	break;
+		case OP_AND_RR:	rega = (rega && regb);			break;
+		case OP_OR_RS:	rega = (rega || C_IMM(word));	break;
+		case OP_OR_RR:	rega = (rega || regb);			break;
+		case OP_NOT:	rega = (rega == 0);				break;
+		case OP_NEG:	rega = -rega;					break;
+
+		case OP_SUB_RS:	rega -= C_IMM(word);	break;
+		case OP_SUB_RR:	rega -= regb;			break;
+		case OP_ADD_RS:	rega += C_IMM(word);	break;
+		case OP_ADD_RR:	rega += regb;			break;
+		case OP_MUL_RS:	rega *= C_IMM(word);	break;
+		case OP_MUL_RR:	rega *= regb;			break;
+
+		case OP_DIV_RS:
+		case OP_MOD_RS:
+		case OP_DIV_RR:
+		case OP_MOD_RR:
+			// the RS variants are odd
+			value = ((word & 1) ? C_IMM(word) : regb);
+			nassert(false, "EXCEPTION: Division by zero", value == 0);
+
+			if( C_OPCODE(word) == OP_DIV_RS || C_OPCODE(word) == OP_DIV_RR )
+				rega /= value;
+			else
+				rega %= value;
+
+			break;
+
+		case OP_SETL_RS:	rega = (rega < C_IMM(word));	break;
+		case OP_SETL_RR:	rega = (rega < regb);			break;
+		case OP_SETLE_RS:	rega = (rega <= C_IMM(word));	break;
+		case OP_SETLE_RR:	rega = (rega <= regb);			break;
+		case OP_SETG_RS:	rega = (rega > C_IMM(word));	break;
+		case OP_SETG_RR:	rega = (rega > regb);			break;
+		case OP_SETGE_RS:	rega = (rega >= C_IMM(word));	break;
+		case OP_SETGE_RR:	rega = (rega >= regb);			break;
+		case OP_SETE_RS:	rega = (rega == C_IMM(word));	break;
+		case OP_SETE_RR:	rega = (rega == regb);			break;
+		case OP_SETNE_RS:	rega = (rega != C_IMM(word));	break;
+		case OP_SETNE_RR:	rega = (rega != regb);			break;
+
+		case OP_SETL_JZ_RS:		C_SET_JZ(rega < C_IMM(word));	break;
+		case OP_SETL_JZ_RR:		C_SET_JZ(rega < regb);			break;
+		case OP_SETLE_JZ_RS:	C_SET_JZ(rega <= C_IMM(word));	break;
+		case OP_SETLE_JZ_RR:	C_SET_JZ(rega <= regb);			break;
+		case OP_SETG_JZ_RS:		C_SET_JZ(rega > C_IMM(word));	break;
+		case OP_SETG_JZ_RR:		C_SET_JZ(rega > regb);			break;
+		case OP_SETGE_JZ_RS:	C_SET_JZ(rega >= C_IMM(word));	break;
+		case OP_SETGE_JZ_RR:	C_SET_JZ(rega >= regb);			break;
+		case OP_SETE_JZ_RS:		C_SET_JZ(rega == C_IMM(word));	break;
+		case OP_SETE_JZ_RR:		C_SET_JZ(rega == regb);			break;
+		case OP_SETNE_JZ_RS:	C_SET_JZ(rega != C_IMM(word));	break;
+		case OP_SETNE_JZ_RR:	C_SET_JZ(rega != regb);			break;
+
+		case OP_FSUB_RS:	rega = FLOAT_OP(rega, -, C_IMM(word));	break;
+		case OP_FSUB_RR:	rega = FLOAT_OP(rega, -, regb);			break;
+		case OP_FADD_RS:	rega = FLOAT_OP(rega, +, C_IMM(word));	break;
+		case OP_FADD_RR:	rega = FLOAT_OP(rega, +, regb);			break;
+		case OP_FMUL_RS:	rega = FLOAT_OP(rega, *, C_IMM(word));	break;
+		case OP_FMUL_RR:	rega = FLOAT_OP(rega, *, regb);			break;
+		case OP_FDIV_RS:	rega = FLOAT_OP(rega, /, C_IMM(word));	break;
+		case OP_FDIV_RR:	rega = FLOAT_OP(rega, /, regb);			break;
+		case OP_FNEG:		rega ^= INT_MIN;						break;
+		case OP_CVT_IF:		rega = Float_To_Bits((float)rega);		break;
+		case OP_CVT_FI:		rega = (int)Bits_To_Float(rega);		break;
+
+		case OP_FSETL_RS:	rega = FLOAT_CMP(rega, <, C_IMM(word));		break;
+		case OP_FSETL_RR:	rega = FLOAT_CMP(rega, <, regb);			break;
+		case OP_FSETLE_RS:	rega = FLOAT_CMP(rega, <=, C_IMM(word));	break;
+		case OP_FSETLE_RR:	rega = FLOAT_CMP(rega, <=, regb);			break;
+		case OP_FSETG_RS:	rega = FLOAT_CMP(rega, >, C_IMM(word));		break;
+		case OP_FSETG_RR:	rega = FLOAT_CMP(rega, >, regb);			break;
+		case OP_FSETGE_RS:	rega = FLOAT_CMP(rega, >=, C_IMM(word));	break;
+		case OP_FSETGE_RR:	rega = FLOAT_CMP(rega, >=, regb);			break;
+		case OP_FSETE_RS:	rega = FLOAT_CMP(rega, ==, C_IMM(word));	break;
+		case OP_FSETE_RR:	rega = FLOAT_CMP(rega, ==, regb);			break;
+		case OP_FSETNE_RS:	rega = FLOAT_CMP(rega, !=, C_IMM(word));	break;
+		case OP_FSETNE_RR:	rega = FLOAT_CMP(rega, !=, regb);			break;
+
+		case OP_JZ:
+			if( rega == 0 )
+				registers[EIP] += C_IMM(word);
+
+			break;
+
+		case OP_JNZ:
+			if( rega != 0 )
+				registers[EIP] += C_IMM(word);
+
+			break;
+
+		case OP_JMP:
+			registers[EIP] += C_IMM(word);
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	return true;
+}
@@ -1,61 +1,18 @@
-
 #include "interpreter.h"
-#include "parser.hpp"
-
-extern int yyflex();
-extern char* yytext;
-extern Interpreter* interpreter;
-
-std::string& replace(std::string& out, const std::string& what, const std::string& with, const std::string& instr)
-{
-	size_t pos = instr.find(what);
-	out = instr;
-
-	while( pos != std::string::npos )
-	{
-		out.replace(pos, what.length(), with);
-		pos = out.find(what, pos + with.length());
-	}
-
-	return out;
-}
-
-std::string tostring(int value)
-{
-	char rem = 0;
-	bool sign = value < 0;
-
-	std::string str("");
-	value = abs(value);
-
-	if( value == 0 )
-		return "0";
-
-	while( value > 0 )
-	{
-		rem = value % 10;
-		value /= 10;
-
-		str.insert(str.begin(), rem + 0x30);
-	}
-
-	if( sign )
-		str.insert(str.begin(), '-');
-
-	return str;
-}
+#include "lexer.cpp"
+#include "parser.cpp"
 
 void Interpreter::Const_Add(expression_desc* expr1, expression_desc* expr2, int type)
 {
 	switch( type )
 	{
-	case Type_Integer: {
-		int a = atoi(expr1->value.c_str());
-		int b = atoi(expr2->value.c_str());
-		
-		a += b;
-		expr1->value = tostring(a);
-		} break;
+	case Type_Integer:
+		expr1->value += expr2->value;
+		break;
+
+	case Type_Float:
+		expr1->value = FLOAT_OP(expr1->value, +, expr2->value);
+		break;
 
 	default:
 		nassert(, "Interpreter::Const_Add(): Unknown type", true);
@@ -67,13 +24,13 @@ void Interpreter::Const_Sub(expression_desc* expr1, expression_desc* expr2, int
 {
 	switch( type )
 	{
-	case Type_Integer: {
-		int a = atoi(expr1->value.c_str());
-		int b = atoi(expr2->value.c_str());
-		
-		a -= b;
-		expr1->value = tostring(a);
-		} break;
+	case Type_Integer:
+		expr1->value -= expr2->value;
+		break;
+
+	case Type_Float:
+		expr1->value = FLOAT_OP(expr1->value, -, expr2->value);
+		break;
 
 	default:
 		nassert(, "Interpreter::Const_Sub(): Unknown type", true);
@@ -85,13 +42,13 @@ void Interpreter::Const_Mul(expression_desc* expr1, expression_desc* expr2, int
 {
 	switch( type )
 	{
-	case Type_Integer: {
-		int a = atoi(expr1->value.c_str());
-		int b = atoi(expr2->value.c_str());
-		
-		a *= b;
-		expr1->value = tostring(a);
-		} break;
+	case Type_Integer:
+		expr1->value *= expr2->value;
+		break;
+
+	case Type_Float:
+		expr1->value = FLOAT_OP(expr1->value, *, expr2->value);
+		break;
 
 	default:
 		nassert(, "Interpreter::Const_Mul(): Unknown type", true);
@@ -103,15 +60,15 @@ void Interpreter::Const_Div(expression_desc* expr1, expression_desc* expr2, int
 {
 	switch( type )
 	{
-	case Type_Integer: {
-		int a = atoi(expr1->value.c_str());
-		int b = atoi(expr2->value.c_str());
-		
-		nassert(, "Interpreter::Const_Div(): Division by zero", b == 0);
+	case Type_Integer:
+		nassert(, "Interpreter::Const_Div(): Division by zero", expr2->value == 0);
+		expr1->value /= expr2->value;
+		break;
 
-		a /= b;
-		expr1->value = tostring(a);
-		} break;
+	case Type_Float:
+		// same as at runtime (no exception)
+		expr1->value = FLOAT_OP(expr1->value, /, expr2->value);
+		break;
 
 	default:
 		nassert(, "Interpreter::Const_Div(): Unknown type", true);
@@ -120,21 +77,99 @@ void Interpreter::Const_Div(expression_desc* expr1, expression_desc* expr2, int
 }
 
 void Interpreter::Const_Mod(expression_desc* expr1, expression_desc* expr2, int type)
+{
+	switch( type )
+	{
+	case Type_Integer:
+		nassert(, "Interpreter::Const_Mod(): Division by zero", expr2->value == 0);
+		expr1->value %= expr2->value;
+		break;
+
+	default:
+		nassert(, "Interpreter::Const_Mod(): Unknown type", true);
+		break;
+	}
+}
+
+void Interpreter::Const_Compare(expression_desc* expr1, expression_desc* expr2, unsigned char op, int type)
 {
 	switch( type )
 	{
 	case Type_Integer: {
-		int a = atoi(expr1->value.c_str());
-		int b = atoi(expr2->value.c_str());
-		
-		a %= b;
-		expr1->value = tostring(a);
+		int a = expr1->value;
+		int b = expr2->value;
+
+		switch( op )
+		{
+		case OP_SETL_RR:	expr1->value = (a < b);		break;
+		case OP_SETLE_RR:	expr1->value = (a <= b);	break;
+		case OP_SETG_RR:	expr1->value = (a > b);		break;
+		case OP_SETGE_RR:	expr1->value = (a >= b);	break;
+		case OP_SETE_RR:	expr1->value = (a == b);	break;
+		case OP_SETNE_RR:	expr1->value = (a != b);	break;
+		case OP_AND_RR:		expr1->value = (a && b);	break;
+		case OP_OR_RR:		expr1->value = (a || b);	break;
+
+		default:
+			break;
+		}
+		} break;
+
+	case Type_Float: {
+		int a = expr1->value;
+		int b = expr2->value;
+
+		switch( op )
+		{
+		case OP_SETL_RR:	expr1->value = FLOAT_CMP(a, <, b);	break;
+		case OP_SETLE_RR:	expr1->value = FLOAT_CMP(a, <=, b);	break;
+		case OP_SETG_RR:	expr1->value = FLOAT_CMP(a, >, b);	break;
+		case OP_SETGE_RR:	expr1->value = FLOAT_CMP(a, >=, b);	break;
+		case OP_SETE_RR:	expr1->value = FLOAT_CMP(a, ==, b);	break;
+		case OP_SETNE_RR:	expr1->value = FLOAT_CMP(a, !=, b);	break;
+
+		default:
+			break;
+		}
 		} break;
 
 	default:
-		nassert(, "Interpreter::Const_Mod(): Unknown type", true);
+		nassert(, "Interpreter::Const_Compare(): Unknown type", true);
 		break;
 	}
+
+	// the result of a relation is always an integer
+	expr1->type = Type_Integer;
+}
+
+expression_desc* Interpreter::Logic_Expr(expression_desc* expr1, expression_desc* expr2, unsigned char op)
+{
+	// one side is known: x && 1 is (x != 0), x && 0 is 0 (if x has no side effects)
+	expression_desc* known = (expr1->constexpr ? expr1 : expr2);
+	expression_desc* other = (expr1->constexpr ? expr2 : expr1);
+	bool absorbing = ((op == OP_AND_RR) == (known->value == 0));
+
+	if( absorbing )
+	{
+		if( other->bytecode.size() > 0 )
+			return 0;
+
+		known->value = (op == OP_OR_RR ? 1 : 0);
+		known->type = Type_Integer;
+
+		Deallocate(other);
+		return known;
+	}
+
+	if( other->address != UNKNOWN_ADDR )
+		other->bytecode << OP(OP_MOV_RM) << REG(EAX) << other->address;
+
+	other->bytecode << OP(OP_SETNE_RS) << REG(EAX) << (int)0;
+	other->address = UNKNOWN_ADDR;
+	other->type = Type_Integer;
+
+	Deallocate(known);
+	return other;
 }
 
 int Interpreter::Sizeof(int t)
@@ -144,6 +179,9 @@ int Interpreter::Sizeof(int t)
 	case Type_Integer:
 		return sizeof(int);
 
+	case Type_Float:
+		return sizeof(float);
+
 	case Type_String:
 		return sizeof(std::string*);
 
@@ -154,11 +192,114 @@ int Interpreter::Sizeof(int t)
 	return 0;
 }
 
+static unsigned char Float_Opcode(unsigned char op)
+{
+	// the _RR variant, so op - 1 still works
+	switch( op )
+	{
+	case OP_SUB_RR:		return OP_FSUB_RR;
+	case OP_ADD_RR:		return OP_FADD_RR;
+	case OP_MUL_RR:		return OP_FMUL_RR;
+	case OP_DIV_RR:		return OP_FDIV_RR;
+	case OP_SETL_RR:	return OP_FSETL_RR;
+	case OP_SETLE_RR:	return OP_FSETLE_RR;
+	case OP_SETG_RR:	return OP_FSETG_RR;
+	case OP_SETGE_RR:	return OP_FSETGE_RR;
+	case OP_SETE_RR:	return OP_FSETE_RR;
+	case OP_SETNE_RR:	return OP_FSETNE_RR;
+
+	default:
+		break;
+	}
+
+	return op;
+}
+
+expression_desc* Interpreter::Convert(expression_desc* expr, int type)
+{
+	// only int <-> float is implicit, the rest is checked by the caller
+	if( expr->type == type || (type != Type_Float && type != Type_Integer) ||
+		(expr->type != Type_Float && expr->type != Type_Integer) )
+	{
+		return expr;
+	}
+
+	if( expr->constexpr )
+	{
+		if( type == Type_Float )
+			expr->value = Float_To_Bits((float)expr->value);
+		else
+			expr->value = (int)Bits_To_Float(expr->value);
+	}
+	else
+	{
+		if( expr->address != UNKNOWN_ADDR )
+			expr->bytecode << OP(OP_MOV_RM) << REG(EAX) << expr->address;
+
+		expr->bytecode << OP(type == Type_Float ? OP_CVT_IF : OP_CVT_FI) << REG(EAX) << NIL;
+		expr->address = UNKNOWN_ADDR;
+	}
+
+	expr->type = type;
+	return expr;
+}
+
+expression_desc* Interpreter::Condition(expression_desc* expr)
+{
+	// truth value of a float is (x != 0.0f), which is an int
+	if( expr->type != Type_Float )
+		return expr;
+
+	if( expr->constexpr )
+	{
+		expr->value = (Bits_To_Float(expr->value) != 0);
+	}
+	else
+	{
+		if( expr->address != UNKNOWN_ADDR )
+			expr->bytecode << OP(OP_MOV_RM) << REG(EAX) << expr->address;
+
+		expr->bytecode << OP(OP_FSETNE_RS) << REG(EAX) << Float_To_Bits(0.0f);
+		expr->address = UNKNOWN_ADDR;
+	}
+
+	expr->type = Type_Integer;
+	return expr;
+}
+
 expression_desc* Interpreter::Arithmetic_Expr(expression_desc* expr1, expression_desc* expr2, unsigned char op)
 {
 	assert(0, "Interpreter::Arithmetic_Expr(): NULL == expr1", expr1);
 	assert(0, "Interpreter::Arithmetic_Expr(): NULL == expr2", expr2);
 
+	bool logic = (op == OP_AND_RR || op == OP_OR_RR);
+	bool relation = (op >= OP_SETL_RR && op <= OP_SETNE_RR);
+
+	if( logic )
+	{
+		Condition(expr1);
+		Condition(expr2);
+	}
+	else if( expr1->type == Type_Float || expr2->type == Type_Float )
+	{
+		// mixed operands are promoted, then it's a float instruction
+		nassert(0, "In function '" << current_func->name << "': Invalid operands to '%'", op == OP_MOD_RR);
+
+		Convert(expr1, Type_Float);
+		Convert(expr2, Type_Float);
+	}
+
+	unsigned char instr = (expr1->type == Type_Float ? Float_Opcode(op) : op);
+	int type = (relation || logic ? (int)Type_Integer : std::max(expr1->type, expr2->type));
+
+	if( logic && expr1->constexpr != expr2->constexpr )
+	{
+		expression_desc* result = Logic_Expr(expr1, expr2, op);
+
+		if( result )
+			return result;
+	}
+
 	if( expr1->constexpr )
 	{
 		if( expr2->constexpr )
@@ -190,16 +331,13 @@ expression_desc* Interpreter::Arithmetic_Expr(expression_desc* expr1, expression
 
 			case OP_AND_RR:
 			case OP_OR_RR:
-				nassert(0, "Interpreter::Arithmetic_Expr(): Constant logic expressions not yet implemented", true);
-				break;
-
 			case OP_SETL_RR:
 			case OP_SETLE_RR:
 			case OP_SETG_RR:
 			case OP_SETGE_RR:
 			case OP_SETE_RR:
 			case OP_SETNE_RR:
-				nassert(0, "Interpreter::Arithmetic_Expr(): Constant relations not yet implemented", true);
+				Const_Compare(expr1, expr2, op, expr1->type);
 				break;
 
 			default:
@@ -217,17 +355,17 @@ expression_desc* Interpreter::Arithmetic_Expr(expression_desc* expr1, expression
 
 			switch( expr2->type )
 			{
-			case Type_Integer: {
-				int a = atoi(expr2->value.c_str());
-				expr1->bytecode << OP(OP_MOV_RS) << REG(EAX) << a;
-				} break;
+			case Type_Integer:
+			case Type_Float:
+				expr1->bytecode << OP(OP_MOV_RS) << REG(EAX) << expr2->value;
+				break;
 
 			default:
 				nassert(0, "Interpreter::Arithmetic_Expr(): Unknown type", true);
 				break;
 			}
 
-			expr1->bytecode << OP(op) << REG(EAX) << REG(EBX);
+			expr1->bytecode << OP(instr) << REG(EAX) << REG(EBX);
 			expr1->address = UNKNOWN_ADDR;
 			expr1->constexpr = false;
 		}
@@ -239,17 +377,17 @@ expression_desc* Interpreter::Arithmetic_Expr(expression_desc* expr1, expression
 
 			switch( expr2->type )
 			{
-			case Type_Integer: {
-				int a = atoi(expr2->value.c_str());
-				expr1->bytecode << OP(OP_MOV_RS) << REG(EAX) << a;
-				} break;
+			case Type_Integer:
+			case Type_Float:
+				expr1->bytecode << OP(OP_MOV_RS) << REG(EAX) << expr2->value;
+				break;
 
 			default:
 				nassert(0, "Interpreter::Arithmetic_Expr(): Unknown type", true);
 				break;
 			}
 
-			expr1->bytecode << OP(op) << REG(EAX) << REG(EBX);
+			expr1->bytecode << OP(instr) << REG(EAX) << REG(EBX);
 			expr1->address = UNKNOWN_ADDR;
 			expr1->constexpr = false;
 		}
@@ -261,10 +399,10 @@ expression_desc* Interpreter::Arithmetic_Expr(expression_desc* expr1, expression
 			// expr1 in EAX, expr2 constexpr
 			switch( expr2->type )
 			{
-			case Type_Integer: {
-				int a = atoi(expr2->value.c_str());
-				expr1->bytecode << OP(op - 1) << REG(EAX) << a;
-				} break;
+			case Type_Integer:
+			case Type_Float:
+				expr1->bytecode << OP(instr - 1) << REG(EAX) << expr2->value;
+				break;
 
 			default:
 				nassert(0, "Interpreter::Arithmetic_Expr(): Unknown type", true);
@@ -278,11 +416,11 @@ expression_desc* Interpreter::Arithmetic_Expr(expression_desc* expr1, expression
 		{
 			// both in EAX
 			expr1->bytecode << OP(OP_PUSH) << REG(EAX) << NIL;
-			expr1->bytecode << expr2->bytecode;
+			expr1->bytecode.splice(expr2->bytecode);
 			expr1->bytecode << OP(OP_MOV_RR) << REG(EBX) << REG(EAX);
 			expr1->bytecode << OP(OP_POP) << REG(EAX) << NIL;
 
-			expr1->bytecode << OP(op) << REG(EAX) << REG(EBX);
+			expr1->bytecode << OP(instr) << REG(EAX) << REG(EBX);
 			expr1->address = UNKNOWN_ADDR;
 			expr1->constexpr = false;
 		}
@@ -290,11 +428,11 @@ expression_desc* Interpreter::Arithmetic_Expr(expression_desc* expr1, expression
 		{
 			// expr1 in EAX, expr2 on the stack
 			expr1->bytecode << OP(OP_PUSH) << REG(EAX) << NIL;
-			expr1->bytecode << expr2->bytecode;
+			expr1->bytecode.splice(expr2->bytecode);
 			expr1->bytecode << OP(OP_MOV_RM) << REG(EBX) << expr2->address;
 			expr1->bytecode << OP(OP_POP) << REG(EAX) << NIL;
 
-			expr1->bytecode << OP(op) << REG(EAX) << REG(EBX);
+			expr1->bytecode << OP(instr) << REG(EAX) << REG(EBX);
 			expr1->address = UNKNOWN_ADDR;
 			expr1->constexpr = false;
 		}
@@ -308,10 +446,10 @@ expression_desc* Interpreter::Arithmetic_Expr(expression_desc* expr1, expression
 
 			switch( expr2->type )
 			{
-			case Type_Integer: {
-				int a = atoi(expr2->value.c_str());
-				expr1->bytecode << OP(op - 1) << REG(EAX) << a;
-				} break;
+			case Type_Integer:
+			case Type_Float:
+				expr1->bytecode << OP(instr - 1) << REG(EAX) << expr2->value;
+				break;
 
 			default:
 				nassert(0, "Interpreter::Arithmetic_Expr(): Unknown type", true);
@@ -324,28 +462,30 @@ expression_desc* Interpreter::Arithmetic_Expr(expression_desc* expr1, expression
 		else if( expr2->address == UNKNOWN_ADDR )
 		{
 			// expr1 on stack, expr2 in EAX
-			expr1->bytecode << expr2->bytecode;
+			expr1->bytecode.splice(expr2->bytecode);
 			expr1->bytecode << OP(OP_MOV_RR) << REG(EBX) << REG(EAX);
 			expr1->bytecode << OP(OP_MOV_RM) << REG(EAX) << expr1->address;
 
-			expr1->bytecode << OP(op) << REG(EAX) << REG(EBX);
+			expr1->bytecode << OP(instr) << REG(EAX) << REG(EBX);
 			expr1->address = UNKNOWN_ADDR;
 			expr1->constexpr = false;
 		}
 		else
 		{
 			// both on stack
-			expr1->bytecode << expr2->bytecode;
+			expr1->bytecode.splice(expr2->bytecode);
 			expr1->bytecode << OP(OP_MOV_RM) << REG(EAX) << expr1->address;
 			expr1->bytecode << OP(OP_MOV_RM) << REG(EBX) << expr2->address;
 
-			expr1->bytecode << OP(op) << REG(EAX) << REG(EBX);
+			expr1->bytecode << OP(instr) << REG(EAX) << REG(EBX);
 			expr1->address = UNKNOWN_ADDR;
 			expr1->constexpr = false;
 		}
 	}
 	
-	interpreter->Deallocate(expr2);
+	expr1->type = type;
+
+	Deallocate(expr2);
 	return expr1;
 }
 
@@ -354,57 +494,62 @@ expression_desc* Interpreter::Unary_Expr(expression_desc* expr, unary_expr type)
 	switch( type )
 	{
 	case Expr_Inc:
-		nassert(0, "In function '" << interpreter->current_func->name <<
+		nassert(0, "In function '" << current_func->name <<
 			"': '++' requires lvalue", expr->constexpr || (expr->address == UNKNOWN_ADDR));
 
 		// "returns with" the new value
 		expr->bytecode << OP(OP_MOV_RM) << REG(EAX) << expr->address;
-		expr->bytecode << OP(OP_ADD_RS) << REG(EAX) << (int)1;
+
+		if( expr->type == Type_Float )
+			expr->bytecode << OP(OP_FADD_RS) << REG(EAX) << Float_To_Bits(1.0f);
+		else
+			expr->bytecode << OP(OP_ADD_RS) << REG(EAX) << (int)1;
+
 		expr->bytecode << OP(OP_MOV_MR) << expr->address << REG(EAX);
 		break;
 
 	case Expr_Dec:
-		nassert(0, "In function '" << interpreter->current_func->name <<
+		nassert(0, "In function '" << current_func->name <<
 			"': '--' requires lvalue", expr->constexpr || (expr->address == UNKNOWN_ADDR));
 
 		// "returns with" the new value
 		expr->bytecode << OP(OP_MOV_RM) << REG(EAX) << expr->address;
-		expr->bytecode << OP(OP_SUB_RS) << REG(EAX) << (int)1;
+
+		if( expr->type == Type_Float )
+			expr->bytecode << OP(OP_FSUB_RS) << REG(EAX) << Float_To_Bits(1.0f);
+		else
+			expr->bytecode << OP(OP_SUB_RS) << REG(EAX) << (int)1;
+
 		expr->bytecode << OP(OP_MOV_MR) << expr->address << REG(EAX);
 		break;
 
-	case Expr_Neg:
+	case Expr_Neg: {
+		unsigned char op = (expr->type == Type_Float ? OP_FNEG : OP_NEG);
+
 		if( expr->constexpr )
 		{
-			int val = atoi(expr->value.c_str());
-
-			if( val < 0 )
-				expr->value = expr->value.substr(1);
-			else
-				expr->value = "-" + expr->value;
+			// flipping the sign bit negates a float
+			expr->value = (expr->type == Type_Float ? (expr->value ^ INT_MIN) : -expr->value);
 		}
 		else if( expr->address == UNKNOWN_ADDR )
 		{
-			expr->bytecode << OP(OP_NEG) << REG(EAX) << NIL;
+			expr->bytecode << OP(op) << REG(EAX) << NIL;
 		}
 		else
 		{
 			expr->bytecode << OP(OP_MOV_RM) << REG(EAX) << expr->address;
-			expr->bytecode << OP(OP_NEG) << REG(EAX) << NIL;
+			expr->bytecode << OP(op) << REG(EAX) << NIL;
 			expr->address = UNKNOWN_ADDR;
 		}
 
-		break;
+		} break;
 
 	case Expr_Not:
+		Condition(expr);
+
 		if( expr->constexpr )
 		{
-			int val = atoi(expr->value.c_str());
-
-			if( val == 0 )
-				expr->value = "1";
-			else
-				expr->value = "0";
+			expr->value = (expr->value == 0);
 		}
 		else if( expr->address == UNKNOWN_ADDR )
 		{
@@ -425,17 +570,18 @@ expression_desc* Interpreter::Unary_Expr(expression_desc* expr, unary_expr type)
 	return expr;
 }
 
-int yylex()
+int yylex(YYSTYPE* lvalp, YYLTYPE* llocp, void* scanner)
 {
-	int ret = yyflex();
+	int ret = yyflex(lvalp, llocp, scanner);
 
 	switch( ret )
 	{
 	case NUMBER:
+	case REAL:
 	case IDENTIFIER:
 	case STRING: {
-		yylval.text_t = interpreter->Allocate<std::string>();
-		replace(*yylval.text_t, "\\n", "\n", yytext);
+		lvalp->text_t = yyget_extra(scanner)->Allocate<std::string>();
+		replace(*lvalp->text_t, "\\n", "\n", yyget_text(scanner));
 		} break;
 
 	default:
@@ -445,7 +591,25 @@ int yylex()
 	return ret;
 }
 
-void yyerror(const char *s)
+void yyerror(YYLTYPE* llocp, Interpreter* interpreter, void* scanner, const char* s)
 {
-	std::cout << "* ERROR: ln " << yylloc.first_line << ": " << s << "\n";
+	std::cout << "* ERROR: ln " << llocp->first_line << ": " << s << "\n";
+}
+
+int Interpreter::Parse_Buffer(char* buffer, size_t size)
+{
+	// every compile has its own scanner, so they can run in parallel
+	yyscan_t scanner = 0;
+
+	nassert(1, "Interpreter::Parse_Buffer(): Could not create scanner", yylex_init_extra(this, &scanner) != 0);
+
+	YY_BUFFER_STATE state = yy_scan_buffer(buffer, size, scanner);
+	yyset_lineno(1, scanner);
+
+	int ret = yyparse(this, scanner);
+
+	yy_delete_buffer(state, scanner);
+	yylex_destroy(scanner);
+
+	return ret;
 }
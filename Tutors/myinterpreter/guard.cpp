@@ -0,0 +1,67 @@
+
+#ifdef _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#else
+#	include <pthread.h>
+#endif
+
+#include "guard.h"
+
+#ifdef _WIN32
+
+Guard::Guard()
+{
+	CRITICAL_SECTION* critsec = new CRITICAL_SECTION;
+
+	InitializeCriticalSection(critsec);
+	handle = critsec;
+}
+
+Guard::~Guard()
+{
+	CRITICAL_SECTION* critsec = (CRITICAL_SECTION*)handle;
+
+	DeleteCriticalSection(critsec);
+	delete critsec;
+}
+
+void Guard::Lock()
+{
+	EnterCriticalSection((CRITICAL_SECTION*)handle);
+}
+
+void Guard::Unlock()
+{
+	LeaveCriticalSection((CRITICAL_SECTION*)handle);
+}
+
+#else
+
+Guard::Guard()
+{
+	pthread_mutex_t* mutex = new pthread_mutex_t;
+
+	pthread_mutex_init(mutex, 0);
+	handle = mutex;
+}
+
+Guard::~Guard()
+{
+	pthread_mutex_t* mutex = (pthread_mutex_t*)handle;
+
+	pthread_mutex_destroy(mutex);
+	delete mutex;
+}
+
+void Guard::Lock()
+{
+	pthread_mutex_lock((pthread_mutex_t*)handle);
+}
+
+void Guard::Unlock()
+{
+	pthread_mutex_unlock((pthread_mutex_t*)handle);
+}
+
+#endif
@@ -0,0 +1,22 @@
+
+#ifndef _GUARD_H_
+#define _GUARD_H_
+
+// critical section (the handle hides the platform header)
+class Guard
+{
+private:
+	void* handle;
+
+	Guard(const Guard&);
+	Guard& operator =(const Guard&);
+
+public:
+	Guard();
+	~Guard();
+
+	void Lock();
+	void Unlock();
+};
+
+#endif
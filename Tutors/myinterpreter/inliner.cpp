@@ -0,0 +1,303 @@
+
+#include "interpreter.h"
+#include <algorithm>
+
+#define MAX_INLINE_SIZE		24	// entries (with prologue and epilogue)
+#define MAX_INLINE_ROUNDS	3	// leaves can make new leaves
+
+struct function_range
+{
+	symbol_desc* func;
+	int start;
+	int end;
+	int body;		// first entry after the prologue (-1 if nonstandard)
+	int numsaved;	// callee saved registers
+	bool leaf;		// calls nothing
+	bool recursive;	// calls itself
+	bool closed;	// doesn't jump outside
+};
+
+typedef std::vector<function_range> rangelist;
+
+static bool Sort_By_Start(const function_range& a, const function_range& b)
+{
+	return (a.start < b.start);
+}
+
+static symbol_desc* Callee_Of(const referencelist& refs, const code_entry& e)
+{
+	// unlinked call site: jmp UNKNOWN_ADDR, index of the reference
+	if( e.opcode != OP_JMP || e.arg1 != UNKNOWN_ADDR )
+		return 0;
+
+	return refs[e.arg2].func;
+}
+
+static bool Is_Call(const codelist& code, const referencelist& refs, int i, int end)
+{
+	return (code[i].opcode == OP_PUSHADD && code[i].arg1 == EIP && i + 1 < end && Callee_Of(refs, code[i + 1]) != 0);
+}
+
+static void Analyze_Function(const codelist& code, const referencelist& refs, function_range& f)
+{
+	int i = f.start;
+
+	f.body = -1;
+	f.numsaved = 0;
+	f.leaf = true;
+	f.recursive = false;
+	f.closed = true;
+
+	// push saved registers, push EBP, mov EBP, ESP
+	while( i < f.end && code[i].opcode == OP_PUSH && code[i].arg1 >= FIRST_VREG )
+	{
+		++f.numsaved;
+		++i;
+	}
+
+	if( i + 1 < f.end && code[i].opcode == OP_PUSH && code[i].arg1 == EBP &&
+		code[i + 1].opcode == OP_MOV_RR && code[i + 1].arg1 == EBP && code[i + 1].arg2 == ESP )
+	{
+		f.body = i + 2;
+	}
+
+	for( i = f.start; i < f.end; ++i )
+	{
+		const code_entry& e = code[i];
+		symbol_desc* callee = Callee_Of(refs, e);
+
+		if( callee || (e.opcode == OP_PUSHADD && e.arg1 == EIP) )
+			f.leaf = false;
+
+		if( callee == f.func )
+			f.recursive = true;
+
+		if( e.target >= 0 && (e.target < f.start || e.target >= f.end) && !(e.opcode == OP_PUSHADD && e.arg1 == EIP) )
+			f.closed = false;
+	}
+}
+
+static int Tail_Call(const codelist& code, const referencelist& refs, int i, const function_range& f)
+{
+	// pushadd EIP + jmp self + pop EDX (args) + epilogue, returns the number of args
+	if( !Is_Call(code, refs, i, f.end) || Callee_Of(refs, code[i + 1]) != f.func )
+		return -1;
+
+	int j = i + 2;
+
+	while( j < f.end && code[j].opcode == OP_POP && code[j].arg1 == EDX )
+		++j;
+
+	int numargs = j - (i + 2);
+
+	if( j + 1 >= f.end ||
+		!(code[j].opcode == OP_MOV_RR && code[j].arg1 == ESP && code[j].arg2 == EBP) ||
+		!(code[j + 1].opcode == OP_POP && code[j + 1].arg1 == EBP) )
+	{
+		return -1;
+	}
+
+	for( j += 2; j < f.end && code[j].opcode == OP_POP && code[j].arg1 >= FIRST_VREG; ++j )
+		;
+
+	if( j >= f.end || code[j].opcode != OP_POP || code[j].arg1 != EIP )
+		return -1;
+
+	return numargs;
+}
+
+static void Shift_Arguments(code_entry& e, int shift)
+{
+	// positive offsets are above EBP
+	switch( e.opcode )
+	{
+	case OP_MOV_RM:
+		if( e.arg2 > 0 )
+			e.arg2 += shift;
+
+		break;
+
+	case OP_MOV_MM:
+		if( e.arg2 > 0 )
+			e.arg2 += shift;
+
+		if( e.arg1 > 0 )
+			e.arg1 += shift;
+
+		break;
+
+	case OP_MOV_MR:
+	case OP_MOV_MS:
+	case OP_ADD_MS:
+		if( e.arg1 > 0 )
+			e.arg1 += shift;
+
+		break;
+
+	default:
+		break;
+	}
+}
+
+size_t Interpreter::Inline()
+{
+	// NOTE: call it after AllocateRegisters() (it would see the inlined frames), before Link()
+	size_t inlined = 0;
+	size_t tailcalls = 0;
+	bool changed = true;
+
+	for( int round = 0; changed && round < MAX_INLINE_ROUNDS; ++round )
+	{
+		codelist code;
+		codelist result;
+		rangelist funcs;
+
+		changed = false;
+
+		if( !Decode(code) || code.empty() )
+			break;
+
+		int count = (int)code.size();
+		int label = count + 1;
+		int size = count;
+
+		// build the call graph
+		for( symboltable::iterator it = scopes[0].begin(); it != scopes[0].end(); ++it )
+		{
+			if( !it->second->isfunc || (size_t)it->second->address / ENTRY_SIZE >= (size_t)count )
+				continue;
+
+			function_range f;
+
+			f.func = it->second;
+			f.start = it->second->address / ENTRY_SIZE;
+
+			funcs.push_back(f);
+		}
+
+		std::sort(funcs.begin(), funcs.end(), Sort_By_Start);
+
+		for( size_t i = 0; i < funcs.size(); ++i )
+		{
+			funcs[i].end = (i + 1 < funcs.size() ? funcs[i + 1].start : count);
+			Analyze_Function(code, references, funcs[i]);
+		}
+
+		std::map<symbol_desc*, size_t> index;
+
+		for( size_t i = 0; i < funcs.size(); ++i )
+			index[funcs[i].func] = i;
+
+		result.reserve(count);
+
+		if( !funcs.empty() )
+			result.insert(result.end(), code.begin(), code.begin() + funcs[0].start);
+
+		for( size_t n = 0; n < funcs.size(); ++n )
+		{
+			const function_range& f = funcs[n];
+
+			for( int i = f.start; i < f.end; ++i )
+			{
+				int numargs = (f.recursive && f.body >= 0 ? Tail_Call(code, references, i, f) : -1);
+
+				if( numargs >= 0 )
+				{
+					// overwrite the arguments and start over
+					result.push_back(code[i]);
+					result.back().removed = true;
+
+					result.push_back(code[i + 1]);
+					result.back().removed = true;
+
+					for( int j = 0; j < numargs; ++j )
+					{
+						result.push_back(code[i + 2 + j]);
+						result.back().arg1 = EAX;
+
+						result.push_back(code_entry(OP_MOV_MR, 8 + 4 * (f.numsaved + j), EAX));
+					}
+
+					result.push_back(code_entry(OP_MOV_RR, ESP, EBP));
+					result.push_back(code_entry(OP_JMP, 0, NIL));
+					result.back().target = f.body;
+
+					// the epilogue is unreachable now
+					i += 1 + numargs;
+					++tailcalls;
+					changed = true;
+
+					continue;
+				}
+
+				if( !Is_Call(code, references, i, f.end) )
+				{
+					result.push_back(code[i]);
+					continue;
+				}
+
+				std::map<symbol_desc*, size_t>::iterator callee = index.find(Callee_Of(references, code[i + 1]));
+
+				if( callee == index.end() )
+				{
+					result.push_back(code[i]);
+					continue;
+				}
+
+				const function_range& g = funcs[callee->second];
+				int length = g.end - g.start;
+
+				if( &g == &f || !g.leaf || !g.closed || g.body < 0 || g.func->name == "main" ||
+					length > MAX_INLINE_SIZE || (size + length) * (int)ENTRY_SIZE >= CODE_SIZE )
+				{
+					result.push_back(code[i]);
+					continue;
+				}
+
+				// labels of the call flow to the first inlined entry
+				result.push_back(code[i]);
+				result.back().removed = true;
+
+				result.push_back(code[i + 1]);
+				result.back().removed = true;
+
+				for( int k = g.start; k < g.end; ++k )
+				{
+					code_entry e = code[k];
+
+					e.label = label + (k - g.start);
+					e.barrier = false;
+
+					if( e.target >= 0 )
+						e.target = label + (e.target - g.start);
+
+					if( e.opcode == OP_POP && e.arg1 == EIP )
+					{
+						// return to the entry after the call
+						e.opcode = OP_JMP;
+						e.arg1 = 0;
+						e.arg2 = NIL;
+						e.target = code[i].target;
+					}
+
+					// there is no return address between the saved registers and the arguments
+					Shift_Arguments(e, -4);
+					result.push_back(e);
+				}
+
+				label += length;
+				size += length - 2;
+
+				++i;
+				++inlined;
+				changed = true;
+			}
+		}
+
+		if( changed )
+			Encode(result);
+	}
+
+	std::cout << "Inliner: " << inlined << " calls inlined, " << tailcalls << " tail calls eliminated\n";
+	return inlined + tailcalls;
+}
@@ -1,42 +1,152 @@
 
 #include "interpreter.h"
-#include "lexer.cpp"
-#include "parser.cpp"
 
 #include <cstdarg>
+#include <algorithm>
+
+std::string& replace(std::string& out, const std::string& what, const std::string& with, const std::string& instr)
+{
+	size_t pos = instr.find(what);
+	out = instr;
+
+	while( pos != std::string::npos )
+	{
+		out.replace(pos, what.length(), with);
+		pos = out.find(what, pos + with.length());
+	}
+
+	return out;
+}
+
+std::string tostring(int value)
+{
+	char rem = 0;
+	bool sign = value < 0;
+
+	std::string str("");
+	value = abs(value);
+
+	if( value == 0 )
+		return "0";
+
+	while( value > 0 )
+	{
+		rem = value % 10;
+		value /= 10;
+
+		str.insert(str.begin(), rem + 0x30);
+	}
+
+	if( sign )
+		str.insert(str.begin(), '-');
+
+	return str;
+}
 
 Interpreter::stm_ptr Interpreter::op_special[NUM_SPECIAL] =
 {
 	&Interpreter::Print_Reg,
-	&Interpreter::Print_Memory
+	&Interpreter::Print_Memory,
+	&Interpreter::Print_Float
 };
 
-Interpreter::Interpreter()
+THREAD_LOCAL vm_context* Interpreter::running = 0;
+
+vm_context::vm_context()
 {
-	interpreter = this;
+	program = 0;
+	registers = 0;
 	stack = 0;
-
-	scopes.resize(5);
+	numregisters = 0;
 }
 
-Interpreter::~Interpreter()
+vm_context::~vm_context()
 {
 	if( stack )
 	{
 		free(stack);
 		stack = 0;
 	}
+
+	if( registers )
+	{
+		free(registers);
+		registers = 0;
+	}
+}
+
+void vm_context::Reserve(size_t count)
+{
+	if( !stack )
+		stack = (char*)malloc(STACK_SIZE);
+
+	if( numregisters < count )
+	{
+		numregisters = count;
+		registers = (int*)realloc(registers, numregisters * sizeof(int));
+	}
+}
+
+Interpreter::Interpreter()
+{
+	native = 0;
+	nativesize = 0;
+	compactentry = 0;
+	sourcehash = 0;
+	mode = Exec_Switch;
+	verified = Verify_Pending;
+	stackneed = STACK_SIZE;
+
+	profile.interval = SAMPLE_INTERVAL;
+	numregisters = NUM_REGISTERS;
+	scopes.resize(5);
+}
+
+Interpreter::~Interpreter()
+{
+	ReleaseNative();
+	Cleanup();
 }
 
 void Interpreter::Cleanup()
 {
+	// everything the parser allocated goes away here
+	if( !scopes.empty() )
+	{
+		// functions stay until now, Append() can call them
+		for( symboltable::iterator it = scopes[0].begin(); it != scopes[0].end(); ++it )
+			Deallocate(it->second);
+	}
+
 	for( size_t i = 0; i < scopes.size(); ++i )
 		scopes[i].clear();
 
-	scopes.clear();
+#ifdef LEAK_CHECK
+	if( garbage.size() > 0 )
+		warn("Interpreter::Cleanup(): " << garbage.size() << " objects were not deallocated");
+#endif
+
+	garbage.clear();
 }
 
-bool Interpreter::Compile(const std::string& file)
+void Interpreter::Invalidate()
+{
+	// the program changed
+	decoded.clear();
+	compact.clear();
+	constants.clear();
+	ReleaseNative();
+
+	verified = Verify_Pending;
+
+	// offsets are meaningless now
+	profile_desc empty;
+
+	empty.interval = profile.interval;
+	std::swap(profile, empty);
+}
+
+bool Interpreter::Parse(const std::string& file, bool append)
 {
 #ifdef _MSC_VER
 	FILE* infile = NULL;
@@ -64,92 +174,303 @@ bool Interpreter::Compile(const std::string& file)
 	fclose(infile);
 
 	std::cout << "Compiling \'" << file << "\'\n";
-	yy_scan_buffer(buffer, length + 2);
 
-	if( !stack )
-		stack = (char*)malloc(STACK_SIZE);
+	if( !append )
+	{
+		// strings and symbols of the previous program are still referenced until now
+		Cleanup();
+
+		progname = file;
+		program.clear();
+		functions.clear();
+		references.clear();
+		strings.clear();
+		entry = -1;
+		sourcehash = 0;
+	}
+	else
+	{
+		// the new file can have its own entry point
+		symboltable::iterator it = scopes[0].find("main");
+
+		if( it != scopes[0].end() )
+		{
+			Deallocate(it->second);
+			scopes[0].erase(it);
+		}
+	}
+
+	// appended files extend the hash
+	sourcehash = Hash(buffer, length, sourcehash);
 
-	progname = file;
+	Invalidate();
 	current_scope = 0;
 	current_func = 0;
 	alloc_addr = 0;
 
 	// run lexer and parser
-	int ret = yyparse();
+	int ret = Parse_Buffer(buffer, length + 2);
 
-	yy_delete_buffer(YY_CURRENT_BUFFER);
 	free(buffer);
 
-	Cleanup();
-
 	nassert(false, "Interpreter::Compile(): Parser error", ret != 0);
+
+	// functions were spliced in, copy them together once
+	program.flatten();
+
 	return true;
 }
 
+bool Interpreter::Compile(const std::string& file)
+{
+	return Parse(file, false);
+}
+
+bool Interpreter::Append(const std::string& file)
+{
+	// NOTE: the new file can call functions compiled so far
+	assert(false, "Interpreter::Append(): Nothing to append to", program.size() > 0);
+	assert(false, "Interpreter::Append(): Link the program first", functions.empty());
+
+	return Parse(file, true);
+}
+
 bool Interpreter::Link()
 {
-	size_t off = 0;
-	size_t bytesize = program.size();
+	// only the sites recorded since the last Link() are patched
+	const bytestream::relocationlist& relocs = program.relocations();
+	size_t off;
 	int arg1;
 
 	char* bytecode = program.data();
 	char* ptr;
 	
 	unsigned char opcode;
-	unresolved_reference* ref;
+	int index;
 	bytestream tmp;
 
-	std::set<symbol_desc*> junk;
-
-	while( off < bytesize )
+	for( size_t i = 0; i < relocs.size(); ++i )
 	{
-		ptr = (bytecode + off);
-		off += ENTRY_SIZE;
+		ptr = (bytecode + relocs[i]);
+		off = relocs[i] + ENTRY_SIZE;
 
 		opcode = *((unsigned char*)ptr);
 		arg1 = ARG1_INT(ptr);
 
-		if( opcode == OP_JMP && arg1 == UNKNOWN_ADDR )
-		{
-			ref = reinterpret_cast<unresolved_reference*>(ARG2_PTR(ptr));
-			assert(false, "Linker internal error", ref);
+		assert(false, "Linker internal error", opcode == OP_JMP && arg1 == UNKNOWN_ADDR);
 
-			if( ref->func )
-			{
-				nassert(false, "Unresolved external '" << ref->func->name << "'",
-					ref->func->address == UNKNOWN_ADDR);
+		index = ARG2_INT(ptr);
+		assert(false, "Linker internal error", index >= 0 && (size_t)index < references.size());
 
-				tmp << OP(OP_JMP) << (ref->func->address - (int)off) << NIL;
-				memcpy(ptr, tmp.data(), tmp.size());
+		const unresolved_reference& ref = references[index];
 
-				junk.insert(ref->func);
-			}
-			else
-			{
-				// nothing for now
-			}
+		if( ref.func )
+		{
+			nassert(false, "Unresolved external '" << ref.func->name << "'",
+				ref.func->address == UNKNOWN_ADDR);
 
-			tmp.clear();
-			Deallocate(ref);
+			tmp << OP(OP_JMP) << (ref.func->address - (int)off) << NIL;
+			memcpy(ptr, tmp.data(), tmp.size());
 		}
+		else
+		{
+			// nothing for now
+		}
+
+		tmp.clear();
 	}
 
-	for( std::set<symbol_desc*>::iterator it = junk.begin(); it != junk.end(); ++it )
-		Deallocate(*it);
+	program.clear_relocations();
+	references.clear();
+	functions.clear();
+	Invalidate();
 
 	return true;
 }
 
+void Interpreter::SetExecutionMode(execution_mode newmode)
+{
+	mode = newmode;
+}
+
+void Interpreter::SetSampleInterval(unsigned int interval)
+{
+	// used by Exec_Profile
+	profile.interval = interval;
+}
+
+void Interpreter::SetRegisterCount(size_t count)
+{
+	// must be called before AllocateRegisters()
+	numregisters = std::max<size_t>(count, FIRST_VREG);
+}
+
 bool Interpreter::Run()
 {
+	return Run(context);
+}
+
+OutputSink& Interpreter::Output()
+{
+	// redirects the prints of Run()
+	return context.output;
+}
+
+bool Interpreter::Run(vm_context& ctx)
+{
+	// NOTE: threads can run the same program, each with its own context
 	if( program.size() == 0 )
 		return false;
 
+	std::cout << "Executing program '" << progname << "'...\n";
+
+	vm_context* prev = running;
+	bool ret;
+
+	ctx.Reserve(numregisters);
+	ctx.program = this;
+
+	running = &ctx;
+
+	if( mode == Exec_Threaded )
+		ret = Run_Threaded(ctx);
+	else if( mode == Exec_Native )
+		ret = Run_Native(ctx);
+	else if( mode == Exec_Compact )
+		ret = Run_Compact(ctx);
+	else if( mode == Exec_Profile )
+		ret = Run_Profile(ctx);
+	else
+		ret = Run_Switch(ctx);
+
+	ctx.output.Flush();
+
+	running = prev;
+	return ret;
+}
+
+// executes the setcc part, then the jz that follows it
+#define SET_JZ(cond) \
+	{ \
+		int& reg = registers[ARG1_INT(ptr)]; \
+		reg = (cond); \
+		ptr += ENTRY_SIZE; \
+		registers[EIP] += ENTRY_SIZE; \
+		if( reg == 0 ) \
+			registers[EIP] += ARG2_INT(ptr); \
+	}
+
+static inline void Profile_Step(profile_desc& prof, unsigned char opcode, int off, int arg1)
+{
+	size_t index = off / ENTRY_SIZE;
+
+	++prof.opcodes[opcode];
+	++prof.entries[index];
+	++prof.instructions;
+
+	// calls are pushadd EIP + jmp, returns are pop EIP
+	if( prof.calling && opcode == OP_JMP )
+		prof.frames.push_back(off + (int)ENTRY_SIZE + arg1);
+	else if( opcode == OP_POP && arg1 == EIP && prof.frames.size() > 1 )
+		prof.frames.pop_back();
+
+	prof.calling = (opcode == OP_PUSHADD && arg1 == EIP);
+
+	if( --prof.countdown == 0 )
+	{
+		prof.countdown = prof.interval;
+
+		++prof.samples[index];
+		++prof.stacks[prof.frames];
+		++prof.numsamples;
+	}
+}
+
+bool Interpreter::Run_Switch(vm_context& ctx)
+{
+	// first run verifies, the others wait for it
+	prepareguard.Lock();
+
+	if( verified == Verify_Pending )
+		Verify();
+
+	prepareguard.Unlock();
+
+	if( verified == Verify_Passed )
+		return Run_Loop<false, false>(ctx, 0);
+
+	assert(false, "Interpreter::Run(): Invalid bytecode", verified == Verify_Checked);
+	return Run_Loop<false, true>(ctx, 0);
+}
+
+bool Interpreter::Run_Profile(vm_context& ctx)
+{
+	// counts into its own copy, threads can profile the same program
+	profile_desc prof;
+
+	prof.opcodes.resize(256, 0);
+	prof.entries.resize(program.size() / ENTRY_SIZE + 1, 0);
+	prof.samples.resize(prof.entries.size(), 0);
+	prof.frames.push_back(entry);
+	prof.interval = prof.countdown = std::max<unsigned int>(profile.interval, 1);
+
+	prepareguard.Lock();
+
+	if( verified == Verify_Pending )
+		Verify();
+
+	prepareguard.Unlock();
+
+	assert(false, "Interpreter::Run(): Invalid bytecode", verified != Verify_Failed);
+
+	// counters are exact either way, so measure the checked loop
+	bool ret = Run_Loop<true, true>(ctx, &prof);
+
+	prepareguard.Lock();
+
+	if( profile.entries.size() != prof.entries.size() )
+	{
+		profile.opcodes.resize(prof.opcodes.size(), 0);
+		profile.entries.resize(prof.entries.size(), 0);
+		profile.samples.resize(prof.samples.size(), 0);
+	}
+
+	for( size_t i = 0; i < prof.opcodes.size(); ++i )
+		profile.opcodes[i] += prof.opcodes[i];
+
+	for( size_t i = 0; i < prof.entries.size(); ++i )
+	{
+		profile.entries[i] += prof.entries[i];
+		profile.samples[i] += prof.samples[i];
+	}
+
+	for( profile_desc::stackmap::iterator it = prof.stacks.begin(); it != prof.stacks.end(); ++it )
+		profile.stacks[it->first] += it->second;
+
+	profile.instructions += prof.instructions;
+	profile.numsamples += prof.numsamples;
+
+	prepareguard.Unlock();
+	return ret;
+}
+
+// checked: guard stack and frame accesses, otherwise the verifier proved them
+#define CHECK_STACK(o) \
+	if( checked && ((o) < 0 || (o) > STACK_SIZE - 4) ) \
+		nassert(false, "EXCEPTION: Access violation", true);
+
+template <bool profiling, bool checked>
+bool Interpreter::Run_Loop(vm_context& ctx, profile_desc* prof)
+{
+	// <false, false> is the plain switch dispatch
+	int* registers = ctx.registers;
+	char* stack = ctx.stack;
+
 	stm_ptr stm;
 	unsigned char opcode;
 	char* ptr;
 
-	memset(registers, 0, sizeof(registers));
+	memset(registers, 0, numregisters * sizeof(int));
 
 	registers[EBP] = STACK_SIZE;
 	registers[ESP] = STACK_SIZE;
@@ -159,20 +480,22 @@ bool Interpreter::Run()
 	size_t bytesize = program.size();
 	size_t stackdepth = 0;
 
-	std::cout << "Executing program '" << progname << "'...\n";
-
 	while( (size_t)registers[EIP] < bytesize )
 	{
 		ptr = (bytecode + registers[EIP]);
 
 		opcode = *((unsigned char*)ptr);
+
+		if( profiling )
+			Profile_Step(*prof, opcode, registers[EIP], ARG1_INT(ptr));
+
 		registers[EIP] += ENTRY_SIZE;
 
 		// 20 special statements reserved
 		if( opcode < 0x20 )
 		{
 			stm = op_special[opcode];
-			(*stm)(ARG1_PTR(ptr), ARG2_PTR(ptr));
+			(*stm)(ARG1_INT(ptr), ARG2_INT(ptr));
 		}
 		else
 		{
@@ -182,35 +505,43 @@ bool Interpreter::Run()
 			case OP_PUSH: {
 				int& esp = registers[ESP];
 
+				if( checked && (esp < 4 || esp > STACK_SIZE) )
+					nassert(false, "EXCEPTION: Stack overflow", true);
+
 				esp -= 4;
 				*((int*)(stack + esp)) = registers[ARG1_INT(ptr)];
 
-				if( esp < 0 )
-					nassert(false, "EXCEPTION: Stack overflow", true);
-
-				++stackdepth;
+				if( checked )
+					++stackdepth;
 				} break;
 
 			case OP_PUSHADD: {
 				int& esp = registers[ESP];
 
+				// verified code only checks calls: the callee's frame must fit
+				if( checked ? (esp < 4 || esp > STACK_SIZE) : (esp < stackneed) )
+					nassert(false, "EXCEPTION: Stack overflow", true);
+
 				esp -= 4;
 				*((int*)(stack + esp)) = registers[ARG1_INT(ptr)] + ARG2_INT(ptr);
 
-				if( esp < 0 )
-					nassert(false, "EXCEPTION: Stack overflow", true);
-
-				++stackdepth;
+				if( checked )
+					++stackdepth;
 				} break;
 
 			case OP_POP: {
 				int& esp = registers[ESP];
-	
+
+				if( checked )
+				{
+					nassert(false, "EXCEPTION: Stack underflow", stackdepth == 0);
+					CHECK_STACK(esp);
+
+					--stackdepth;
+				}
+
 				registers[ARG1_INT(ptr)] = *((int*)(stack + esp));
 				esp += 4;
-				
-				nassert(false, "EXCEPTION: Stack underflow", stackdepth == 0);
-				--stackdepth;
 				} break;
 
 			case OP_MOV_RS:
@@ -222,17 +553,31 @@ bool Interpreter::Run()
 				break;
 
 			case OP_MOV_RM:
+				CHECK_STACK(registers[EBP] + ARG2_INT(ptr));
 				registers[ARG1_INT(ptr)] = STACK_INT(registers[EBP] + ARG2_INT(ptr));
 				break;
 
 			case OP_MOV_MR:
+				CHECK_STACK(registers[EBP] + ARG1_INT(ptr));
 				STACK_INT(registers[EBP] + ARG1_INT(ptr)) = registers[ARG2_INT(ptr)];
 				break;
 
 			case OP_MOV_MM:
+				CHECK_STACK(registers[EBP] + ARG1_INT(ptr));
+				CHECK_STACK(registers[EBP] + ARG2_INT(ptr));
 				STACK_INT(registers[EBP] + ARG1_INT(ptr)) = STACK_INT(registers[EBP] + ARG2_INT(ptr));
 				break;
 
+			case OP_MOV_MS:
+				CHECK_STACK(registers[EBP] + ARG1_INT(ptr));
+				STACK_INT(registers[EBP] + ARG1_INT(ptr)) = ARG2_INT(ptr);
+				break;
+
+			case OP_ADD_MS:
+				CHECK_STACK(registers[EBP] + ARG1_INT(ptr));
+				STACK_INT(registers[EBP] + ARG1_INT(ptr)) += ARG2_INT(ptr);
+				break;
+
 			case OP_AND_RS:
 				registers[ARG1_INT(ptr)] = (registers[ARG1_INT(ptr)] && ARG2_INT(ptr));
 				break;
@@ -278,7 +623,7 @@ bool Interpreter::Run()
 				break;
 
 			case OP_DIV_RS:
-				if( ARG2_INT(ptr) == 0 )
+				if( checked && ARG2_INT(ptr) == 0 )
 					nassert(false, "EXCEPTION: Division by zero", true);
 
 				registers[ARG1_INT(ptr)] /= ARG2_INT(ptr);
@@ -292,10 +637,16 @@ bool Interpreter::Run()
 				break;
 
 			case OP_MOD_RS:
+				if( checked && ARG2_INT(ptr) == 0 )
+					nassert(false, "EXCEPTION: Division by zero", true);
+
 				registers[ARG1_INT(ptr)] %= ARG2_INT(ptr);
 				break;
 
 			case OP_MOD_RR:
+				if( registers[ARG2_INT(ptr)] == 0 )
+					nassert(false, "EXCEPTION: Division by zero", true);
+
 				registers[ARG1_INT(ptr)] %= registers[ARG2_INT(ptr)];
 				break;
 
@@ -358,7 +709,7 @@ bool Interpreter::Run()
 				break;
 
 			case OP_JNZ:
-				if( registers[ARG2_INT(ptr)] == 0 )
+				if( registers[ARG1_INT(ptr)] != 0 )
 					registers[EIP] += ARG2_INT(ptr);
 
 				break;
@@ -366,6 +717,147 @@ bool Interpreter::Run()
 			case OP_JMP:
 				registers[EIP] += ARG1_INT(ptr);
 				break;
+
+			case OP_SETL_JZ_RS:
+				SET_JZ(reg < ARG2_INT(ptr));
+				break;
+
+			case OP_SETL_JZ_RR:
+				SET_JZ(reg < registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_SETLE_JZ_RS:
+				SET_JZ(reg <= ARG2_INT(ptr));
+				break;
+
+			case OP_SETLE_JZ_RR:
+				SET_JZ(reg <= registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_SETG_JZ_RS:
+				SET_JZ(reg > ARG2_INT(ptr));
+				break;
+
+			case OP_SETG_JZ_RR:
+				SET_JZ(reg > registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_SETGE_JZ_RS:
+				SET_JZ(reg >= ARG2_INT(ptr));
+				break;
+
+			case OP_SETGE_JZ_RR:
+				SET_JZ(reg >= registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_SETE_JZ_RS:
+				SET_JZ(reg == ARG2_INT(ptr));
+				break;
+
+			case OP_SETE_JZ_RR:
+				SET_JZ(reg == registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_SETNE_JZ_RS:
+				SET_JZ(reg != ARG2_INT(ptr));
+				break;
+
+			case OP_SETNE_JZ_RR:
+				SET_JZ(reg != registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_FSUB_RS:
+				registers[ARG1_INT(ptr)] = FLOAT_OP(registers[ARG1_INT(ptr)], -, ARG2_INT(ptr));
+				break;
+
+			case OP_FSUB_RR:
+				registers[ARG1_INT(ptr)] = FLOAT_OP(registers[ARG1_INT(ptr)], -, registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_FADD_RS:
+				registers[ARG1_INT(ptr)] = FLOAT_OP(registers[ARG1_INT(ptr)], +, ARG2_INT(ptr));
+				break;
+
+			case OP_FADD_RR:
+				registers[ARG1_INT(ptr)] = FLOAT_OP(registers[ARG1_INT(ptr)], +, registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_FMUL_RS:
+				registers[ARG1_INT(ptr)] = FLOAT_OP(registers[ARG1_INT(ptr)], *, ARG2_INT(ptr));
+				break;
+
+			case OP_FMUL_RR:
+				registers[ARG1_INT(ptr)] = FLOAT_OP(registers[ARG1_INT(ptr)], *, registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_FDIV_RS:
+				// IEEE rules, no exception
+				registers[ARG1_INT(ptr)] = FLOAT_OP(registers[ARG1_INT(ptr)], /, ARG2_INT(ptr));
+				break;
+
+			case OP_FDIV_RR:
+				registers[ARG1_INT(ptr)] = FLOAT_OP(registers[ARG1_INT(ptr)], /, registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_FNEG:
+				registers[ARG1_INT(ptr)] ^= INT_MIN;
+				break;
+
+			case OP_CVT_IF:
+				registers[ARG1_INT(ptr)] = Float_To_Bits((float)registers[ARG1_INT(ptr)]);
+				break;
+
+			case OP_CVT_FI:
+				registers[ARG1_INT(ptr)] = (int)Bits_To_Float(registers[ARG1_INT(ptr)]);
+				break;
+
+			case OP_FSETL_RS:
+				registers[ARG1_INT(ptr)] = FLOAT_CMP(registers[ARG1_INT(ptr)], <, ARG2_INT(ptr));
+				break;
+
+			case OP_FSETL_RR:
+				registers[ARG1_INT(ptr)] = FLOAT_CMP(registers[ARG1_INT(ptr)], <, registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_FSETLE_RS:
+				registers[ARG1_INT(ptr)] = FLOAT_CMP(registers[ARG1_INT(ptr)], <=, ARG2_INT(ptr));
+				break;
+
+			case OP_FSETLE_RR:
+				registers[ARG1_INT(ptr)] = FLOAT_CMP(registers[ARG1_INT(ptr)], <=, registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_FSETG_RS:
+				registers[ARG1_INT(ptr)] = FLOAT_CMP(registers[ARG1_INT(ptr)], >, ARG2_INT(ptr));
+				break;
+
+			case OP_FSETG_RR:
+				registers[ARG1_INT(ptr)] = FLOAT_CMP(registers[ARG1_INT(ptr)], >, registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_FSETGE_RS:
+				registers[ARG1_INT(ptr)] = FLOAT_CMP(registers[ARG1_INT(ptr)], >=, ARG2_INT(ptr));
+				break;
+
+			case OP_FSETGE_RR:
+				registers[ARG1_INT(ptr)] = FLOAT_CMP(registers[ARG1_INT(ptr)], >=, registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_FSETE_RS:
+				registers[ARG1_INT(ptr)] = FLOAT_CMP(registers[ARG1_INT(ptr)], ==, ARG2_INT(ptr));
+				break;
+
+			case OP_FSETE_RR:
+				registers[ARG1_INT(ptr)] = FLOAT_CMP(registers[ARG1_INT(ptr)], ==, registers[ARG2_INT(ptr)]);
+				break;
+
+			case OP_FSETNE_RS:
+				registers[ARG1_INT(ptr)] = FLOAT_CMP(registers[ARG1_INT(ptr)], !=, ARG2_INT(ptr));
+				break;
+
+			case OP_FSETNE_RR:
+				registers[ARG1_INT(ptr)] = FLOAT_CMP(registers[ARG1_INT(ptr)], !=, registers[ARG2_INT(ptr)]);
+				break;
 			
 			default:
 				break;
@@ -391,16 +883,18 @@ void Interpreter::Disassemble()
 	int arg1, arg2;
 	char buff[7];
 	
-	const char* reg[] =
-	{
-		"EBP",
-		"ESP",
-		"EAX",
-		"EBX",
-		"ECX",
-		"EDX",
-		"EIP"
-	};
+	std::vector<std::string> reg(numregisters);
+
+	reg[EBP] = "EBP";
+	reg[ESP] = "ESP";
+	reg[EAX] = "EAX";
+	reg[EBX] = "EBX";
+	reg[ECX] = "ECX";
+	reg[EDX] = "EDX";
+	reg[EIP] = "EIP";
+
+	for( size_t i = FIRST_VREG; i < numregisters; ++i )
+		reg[i] = "R" + tostring((int)i);
 
 	std::cout << "Disassembly:\n";
 
@@ -462,6 +956,20 @@ void Interpreter::Disassemble()
 				std::cout << "], [EBP+" << arg2 << "]\n";
 			break;
 
+		case OP_MOV_MS:
+			if( arg1 < 0 )
+				std::cout << buff << "mov [EBP" << arg1 << "], " << arg2 << "\n";
+			else
+				std::cout << buff << "mov [EBP+" << arg1 << "], " << arg2 << "\n";
+			break;
+
+		case OP_ADD_MS:
+			if( arg1 < 0 )
+				std::cout << buff << "add [EBP" << arg1 << "], " << arg2 << "\n";
+			else
+				std::cout << buff << "add [EBP+" << arg1 << "], " << arg2 << "\n";
+			break;
+
 		case OP_AND_RS:
 			std::cout << buff << "and " << reg[arg1] << ", " << arg2 << "\n";
 			break;
@@ -586,12 +1094,156 @@ void Interpreter::Disassemble()
 			std::cout << buff << "jmp " << (off + arg1 + ENTRY_SIZE) << "\n";
 			break;
 
+		case OP_SETL_JZ_RS:
+			std::cout << buff << "setl+jz " << reg[arg1] << ", " << arg2 << "\n";
+			break;
+
+		case OP_SETL_JZ_RR:
+			std::cout << buff << "setl+jz " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_SETLE_JZ_RS:
+			std::cout << buff << "setle+jz " << reg[arg1] << ", " << arg2 << "\n";
+			break;
+
+		case OP_SETLE_JZ_RR:
+			std::cout << buff << "setle+jz " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_SETG_JZ_RS:
+			std::cout << buff << "setg+jz " << reg[arg1] << ", " << arg2 << "\n";
+			break;
+
+		case OP_SETG_JZ_RR:
+			std::cout << buff << "setg+jz " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_SETGE_JZ_RS:
+			std::cout << buff << "setge+jz " << reg[arg1] << ", " << arg2 << "\n";
+			break;
+
+		case OP_SETGE_JZ_RR:
+			std::cout << buff << "setge+jz " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_SETE_JZ_RS:
+			std::cout << buff << "sete+jz " << reg[arg1] << ", " << arg2 << "\n";
+			break;
+
+		case OP_SETE_JZ_RR:
+			std::cout << buff << "sete+jz " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_SETNE_JZ_RS:
+			std::cout << buff << "setne+jz " << reg[arg1] << ", " << arg2 << "\n";
+			break;
+
+		case OP_SETNE_JZ_RR:
+			std::cout << buff << "setne+jz " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_FSUB_RS:
+			std::cout << buff << "fsub " << reg[arg1] << ", " << Bits_To_Float(arg2) << "\n";
+			break;
+
+		case OP_FSUB_RR:
+			std::cout << buff << "fsub " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_FADD_RS:
+			std::cout << buff << "fadd " << reg[arg1] << ", " << Bits_To_Float(arg2) << "\n";
+			break;
+
+		case OP_FADD_RR:
+			std::cout << buff << "fadd " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_FMUL_RS:
+			std::cout << buff << "fmul " << reg[arg1] << ", " << Bits_To_Float(arg2) << "\n";
+			break;
+
+		case OP_FMUL_RR:
+			std::cout << buff << "fmul " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_FDIV_RS:
+			std::cout << buff << "fdiv " << reg[arg1] << ", " << Bits_To_Float(arg2) << "\n";
+			break;
+
+		case OP_FDIV_RR:
+			std::cout << buff << "fdiv " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_FNEG:
+			std::cout << buff << "fneg " << reg[arg1] << "\n";
+			break;
+
+		case OP_CVT_IF:
+			std::cout << buff << "cvtif " << reg[arg1] << "\n";
+			break;
+
+		case OP_CVT_FI:
+			std::cout << buff << "cvtfi " << reg[arg1] << "\n";
+			break;
+
+		case OP_FSETL_RS:
+			std::cout << buff << "fsetl " << reg[arg1] << ", " << Bits_To_Float(arg2) << "\n";
+			break;
+
+		case OP_FSETL_RR:
+			std::cout << buff << "fsetl " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_FSETLE_RS:
+			std::cout << buff << "fsetle " << reg[arg1] << ", " << Bits_To_Float(arg2) << "\n";
+			break;
+
+		case OP_FSETLE_RR:
+			std::cout << buff << "fsetle " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_FSETG_RS:
+			std::cout << buff << "fsetg " << reg[arg1] << ", " << Bits_To_Float(arg2) << "\n";
+			break;
+
+		case OP_FSETG_RR:
+			std::cout << buff << "fsetg " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_FSETGE_RS:
+			std::cout << buff << "fsetge " << reg[arg1] << ", " << Bits_To_Float(arg2) << "\n";
+			break;
+
+		case OP_FSETGE_RR:
+			std::cout << buff << "fsetge " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_FSETE_RS:
+			std::cout << buff << "fsete " << reg[arg1] << ", " << Bits_To_Float(arg2) << "\n";
+			break;
+
+		case OP_FSETE_RR:
+			std::cout << buff << "fsete " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
+		case OP_FSETNE_RS:
+			std::cout << buff << "fsetne " << reg[arg1] << ", " << Bits_To_Float(arg2) << "\n";
+			break;
+
+		case OP_FSETNE_RR:
+			std::cout << buff << "fsetne " << reg[arg1] << ", " << reg[arg2] << "\n";
+			break;
+
 		case OP_PRINT_R:
 			std::cout << buff << "print " << reg[arg1] << "\n";
 			break;
 
+		case OP_PRINT_F:
+			std::cout << buff << "print (float)" << reg[arg1] << "\n";
+			break;
+
 		case OP_PRINT_M:
-			std::cout << buff << "print <addr>\n";
+			std::cout << buff << "print <string " << arg1 << ">\n";
 			break;
 
 		default:
@@ -12,38 +12,66 @@
 #include "bytestream.h"
 #include "types.h"
 #include "variadic_pointer_set.hpp"
+#include "arena.hpp"
+#include "guard.h"
+#include "output.h"
 
 // TODO:
-// - konstans relcik/logikai kifek
 // - atoikat egy fv wrappelje (mert lehet atof is ksbb)
 // - break s constexpr ciklus
 
 #define lexer_out(x)	  //{ std::cout << "* LEXER: " << x << "\n"; }
 #define parser_out(x)	 //{ std::cout << "* PARSER: " << x << "\n"; }
-#define assert(r, e, x)   { if( !(x) ) { std::cout << "* ERROR: " << e << "!\n"; return r; } }
-#define nassert(r, e, x)  { if( x ) { std::cout << "* ERROR: " << e << "!\n"; return r; } }
-#define warn(e)		   std::cout << "* WARNING: " << e << "!\n";
+//#define LEAK_CHECK		// track every node in a set (slow, but reports what wasn't deallocated)
+#define assert(r, e, x)   { if( !(x) ) { Interpreter::Flush_Output(); std::cout << "* ERROR: " << e << "!\n"; return r; } }
+#define nassert(r, e, x)  { if( x ) { Interpreter::Flush_Output(); std::cout << "* ERROR: " << e << "!\n"; return r; } }
+#define warn(e)		   { Interpreter::Flush_Output(); std::cout << "* WARNING: " << e << "!\n"; }
+
+#ifdef _MSC_VER
+#	define THREAD_LOCAL	__declspec(thread)
+#else
+#	define THREAD_LOCAL	__thread
+#endif
 
 #define CODE_SIZE		 65536
 #define STACK_SIZE		131072
-#define ENTRY_SIZE		(1 + 2 * sizeof(void*))
-#define NUM_SPECIAL	   2
+#define ENTRY_SIZE		(1 + 2 * sizeof(int))
+#define NUM_SPECIAL	   3
+#define NUM_REGISTERS	 16
 #define UNKNOWN_ADDR	  INT_MAX
+#define SAMPLE_INTERVAL   1000	// instructions between profiler samples
 
 #define OP(x)			 (unsigned char)(x)
 #define REG(x)			(int)(x)
-#define ADDR(x)		   reinterpret_cast<int>(x)
 #define NIL			   (int)0
 
 #define ARG1_INT(p)	   *((int*)(p + 1))
 #define ARG2_INT(p)	   *((int*)(p + 1 + sizeof(int)))
-#define ARG1_PTR(p)	   *((void**)(p + 1))
-#define ARG2_PTR(p)	   *((void**)(p + 1 + sizeof(int)))
 #define STACK_INT(o)	  *((int*)(stack + o))
+#define FLOAT_OP(a, op, b)	Float_To_Bits(Bits_To_Float(a) op Bits_To_Float(b))
+#define FLOAT_CMP(a, op, b)	(Bits_To_Float(a) op Bits_To_Float(b))
+
+// floats live in the int registers and stack slots, bit for bit
+inline float Bits_To_Float(int bits)
+{
+	union { int i; float f; } u;
+
+	u.i = bits;
+	return u.f;
+}
+
+inline int Float_To_Bits(float value)
+{
+	union { int i; float f; } u;
+
+	u.f = value;
+	return u.i;
+}
 
 // special opcodes
 #define OP_PRINT_R		0x0  // std::cout << reg[arg1];
-#define OP_PRINT_M		0x1  // std::cout << *arg1;
+#define OP_PRINT_M		0x1  // std::cout << strings[arg1];
+#define OP_PRINT_F		0x2  // std::cout << (float)reg[arg1];
 
 // common instructions
 #define OP_PUSH		   0x20  // push reg[arg1]
@@ -55,6 +83,8 @@
 #define OP_MOV_RM		 0x27  // mov reg[arg1], [EBP - arg2]
 #define OP_MOV_MR		 0x28  // mov [EBP - arg1], reg[arg2]
 #define OP_MOV_MM		 0x29  // mov [EBP - arg1], [EBP - arg2]
+#define OP_MOV_MS		 0x2a  // mov [EBP - arg1], arg2
+#define OP_ADD_MS		 0x2b  // add [EBP - arg1], arg2
 
 #define OP_AND_RS		 0x30  // and reg[arg1], arg2
 #define OP_AND_RR		 0x31  // and reg[arg1], reg[arg2]
@@ -92,6 +122,49 @@
 #define OP_JNZ			0x51  // if( reg[arg1] != 0 ) jmp arg2
 #define OP_JMP			0x52  // jmp arg1
 
+// fused compare-and-branch, the next entry MUST be a jz on the same register
+#define OP_SETL_JZ_RS	 0x60  // setl reg[arg1], arg2 + jz
+#define OP_SETL_JZ_RR	 0x61  // setl reg[arg1], reg[arg2] + jz
+#define OP_SETLE_JZ_RS	0x62  // setle reg[arg1], arg2 + jz
+#define OP_SETLE_JZ_RR	0x63  // setle reg[arg1], reg[arg2] + jz
+#define OP_SETG_JZ_RS	 0x64  // setg reg[arg1], arg2 + jz
+#define OP_SETG_JZ_RR	 0x65  // setg reg[arg1], reg[arg2] + jz
+#define OP_SETGE_JZ_RS	0x66  // setge reg[arg1], arg2 + jz
+#define OP_SETGE_JZ_RR	0x67  // setge reg[arg1], reg[arg2] + jz
+#define OP_SETE_JZ_RS	 0x68  // sete reg[arg1], arg2 + jz
+#define OP_SETE_JZ_RR	 0x69  // sete reg[arg1], reg[arg2] + jz
+#define OP_SETNE_JZ_RS	0x6a  // setne reg[arg1], arg2 + jz
+#define OP_SETNE_JZ_RR	0x6b  // setne reg[arg1], reg[arg2] + jz
+
+#define FUSED_JZ(op)	  (unsigned char)((op) + 0x20)
+
+// float arithmetic, the operands are the bits of a float
+#define OP_FSUB_RS		0x70  // fsub reg[arg1], arg2
+#define OP_FSUB_RR		0x71  // fsub reg[arg1], reg[arg2]
+#define OP_FADD_RS		0x72  // fadd reg[arg1], arg2
+#define OP_FADD_RR		0x73  // fadd reg[arg1], reg[arg2]
+#define OP_FMUL_RS		0x74  // fmul reg[arg1], arg2
+#define OP_FMUL_RR		0x75  // fmul reg[arg1], reg[arg2]
+#define OP_FDIV_RS		0x76  // fdiv reg[arg1], arg2
+#define OP_FDIV_RR		0x77  // fdiv reg[arg1], reg[arg2]
+#define OP_FNEG		   0x78  // fneg reg[arg1]
+#define OP_CVT_IF		 0x79  // reg[arg1] = (float)reg[arg1]
+#define OP_CVT_FI		 0x7a  // reg[arg1] = (int)reg[arg1]
+
+#define OP_FSETL_RS	   0x80  // reg[arg1] = (reg[arg1] < arg2), the result is an int
+#define OP_FSETL_RR	   0x81  // reg[arg1] = (reg[arg1] < reg[arg2])
+#define OP_FSETLE_RS	  0x82  // reg[arg1] = (reg[arg1] <= arg2)
+#define OP_FSETLE_RR	  0x83  // reg[arg1] = (reg[arg1] <= reg[arg2])
+#define OP_FSETG_RS	   0x84  // reg[arg1] = (reg[arg1] > arg2)
+#define OP_FSETG_RR	   0x85  // reg[arg1] = (reg[arg1] > reg[arg2])
+#define OP_FSETGE_RS	  0x86  // reg[arg1] = (reg[arg1] >= arg2)
+#define OP_FSETGE_RR	  0x87  // reg[arg1] = (reg[arg1] >= reg[arg2])
+#define OP_FSETE_RS	   0x88  // reg[arg1] = (reg[arg1] == arg2)
+#define OP_FSETE_RR	   0x89  // reg[arg1] = (reg[arg1] == reg[arg2])
+#define OP_FSETNE_RS	  0x8a  // reg[arg1] = (reg[arg1] != arg2)
+#define OP_FSETNE_RR	  0x8b  // reg[arg1] = (reg[arg1] != reg[arg2])
+
+
 // registers
 #define EBP			   0	// stack base
 #define ESP			   1	// stack top
@@ -100,55 +173,178 @@
 #define ECX			   4
 #define EDX			   5
 #define EIP			   6	// instruction pointer
+#define FIRST_VREG		7	// the rest is for the register allocator
+
+enum execution_mode
+{
+	Exec_Switch = 0,	// decode bytestream in a switch
+	Exec_Threaded = 1,	// predecoded, threaded dispatch
+	Exec_Native = 2,	// translated to x86-64 machine code
+	Exec_Compact = 3,	// 32 bit compact encoding in a switch
+	Exec_Profile = 4	// switch dispatch with counters and sampling
+};
+
+enum verify_result
+{
+	Verify_Pending = 0,	// not verified yet
+	Verify_Failed,		// malformed, can't run
+	Verify_Checked,		// runs with every check
+	Verify_Passed		// stack balance and frame bounds proven, runs without checks
+};
+
+class Interpreter;
+
+// the parser is pure, the lexer keeps its state in the scanner
+union YYSTYPE;
+struct YYLTYPE;
+
+// helpers shared by the front ends
+std::string& replace(std::string& out, const std::string& what, const std::string& with, const std::string& instr);
+std::string tostring(int value);
+
+// what a running program modifies (one per thread)
+struct vm_context
+{
+	const Interpreter* program;
+	int*	registers;
+	char*	stack;
+	size_t	numregisters;
+	OutputSink	output;	// buffered print statements
+
+	vm_context();
+	~vm_context();
+
+	void Reserve(size_t count);
+
+private:
+	vm_context(const vm_context&);
+	vm_context& operator =(const vm_context&);
+};
 
 class Interpreter
 {
-	friend int yyparse();
-	friend int yylex();
+	friend int yyparse(Interpreter* interpreter, void* scanner);
+	friend int yylex(YYSTYPE* lvalp, YYLTYPE* llocp, void* scanner);
 
-	typedef void (*stm_ptr)(void*, void*);
+	typedef void (*stm_ptr)(int, int);
 	static stm_ptr op_special[NUM_SPECIAL];
+	static THREAD_LOCAL vm_context* running;
 
 	// special statements
-	static void Print_Reg(void* arg1, void* arg2);
-	static void Print_Memory(void* arg1, void* arg2);
+	static void Print_Reg(int arg1, int arg2);
+	static void Print_Memory(int arg1, int arg2);
+	static void Print_Float(int arg1, int arg2);
+
+	union operand
+	{
+		int		i;
+		void*	p;
+	};
+
+	// predecoded form of a bytestream entry
+	struct instruction
+	{
+		const void*	handler;	// label address (or handler index)
+		operand		arg1;
+		operand		arg2;
+		int			opcode;
+	};
+
+	typedef std::vector<instruction> instructionlist;
 
 private:
+#ifdef LEAK_CHECK
 	variadic_pointer_set garbage;
+#else
+	arena		  garbage;
+#endif
 
 	scopetable	 scopes;
 	bytestream	 program;
+	instructionlist decoded;
+	void*		  native;
+	size_t		 nativesize;
+	std::vector<const void*> nativetable;
+	std::vector<unsigned int> compact;
+	std::vector<operand> constants;
+	int			compactentry;
+	symbollist	 functions;
+	referencelist  references;	// unlinked call sites, indexed from the bytecode
+	std::vector<std::string> strings;
 	std::string	progname;
+	unsigned int   sourcehash;
 	int			entry;
-	int			registers[10];
-	char*		  stack;
+	execution_mode mode;
+	size_t		 numregisters;
+	vm_context	 context;
+	profile_desc   profile;
+	verify_result  verified;
+	int			stackneed;	// ESP needed at a call (if verified)
+	Guard		  prepareguard;
 
 	symbol_desc*   current_func;
 	size_t		 current_scope;
 	int			alloc_addr;
 
 	void Cleanup();
+	void Invalidate();
+	bool Parse(const std::string& file, bool append);
+	int Parse_Buffer(char* buffer, size_t size);	// defined by the front end
+
+	bool Decode(codelist& code);
+	void Encode(codelist& code);
+
+	bool Predecode(const void* const* handlers);
+	bool Run_Switch(vm_context& ctx);
+	bool Run_Profile(vm_context& ctx);
+
+	template <bool profiling, bool checked>
+	bool Run_Loop(vm_context& ctx, profile_desc* prof);
+	bool Run_Threaded(vm_context& ctx);
+
+	bool Translate();
+	void ReleaseNative();
+	bool Run_Native(vm_context& ctx);
+
+	unsigned int Compact_Imm(int value);
+	bool Run_Compact(vm_context& ctx);
+
+	static unsigned int Hash(const void* data, size_t size, unsigned int seed);
+
+	std::string Function_Name(int address);
+	int Source_Line(size_t off);
 
 	void Const_Add(expression_desc* expr1, expression_desc* expr2, int type);
 	void Const_Sub(expression_desc* expr1, expression_desc* expr2, int type);
 	void Const_Mul(expression_desc* expr1, expression_desc* expr2, int type);
 	void Const_Div(expression_desc* expr1, expression_desc* expr2, int type);
 	void Const_Mod(expression_desc* expr1, expression_desc* expr2, int type);
+	void Const_Compare(expression_desc* expr1, expression_desc* expr2, unsigned char op, int type);
 
 	int Sizeof(int t);
+	expression_desc* Convert(expression_desc* expr, int type);
+	expression_desc* Condition(expression_desc* expr);
 	expression_desc* Arithmetic_Expr(expression_desc* expr1, expression_desc* expr2, unsigned char op);
+	expression_desc* Logic_Expr(expression_desc* expr1, expression_desc* expr2, unsigned char op);
 	expression_desc* Unary_Expr(expression_desc* expr, unary_expr type);
 
 	template <typename value_type>
 	value_type* Allocate() {
+#ifdef LEAK_CHECK
 		value_type* ret = new value_type();
 
 		garbage.insert<value_type>(ret);
 		return ret;
+#else
+		return garbage.construct<value_type>();
+#endif
 	}
 
 	void Deallocate(void* ptr) {
+#ifdef LEAK_CHECK
 		garbage.erase(ptr);
+#endif
+		// otherwise it lives until Cleanup()
 	}
 	
 public:
@@ -156,10 +352,28 @@ public:
 	~Interpreter();
 
 	bool Compile(const std::string& file);
+	bool Append(const std::string& file);
+	bool AllocateRegisters();
+	size_t Inline();
+	size_t Optimize();
 	bool Link();
+	size_t Compact();
+	bool Save(const std::string& file);
+	bool Load(const std::string& file, unsigned int hash = 0);
+	bool CompileCached(const std::string& file, const std::string& cachedir);
+	verify_result Verify();
 	bool Run();
+	bool Run(vm_context& ctx);
+
+	static void Flush_Output();
 
+	OutputSink& Output();
+	void SetExecutionMode(execution_mode newmode);
+	void SetRegisterCount(size_t count);
+	void SetSampleInterval(unsigned int interval);
 	void Disassemble();
+	void PrintProfile();
+	bool SaveProfile(const std::string& file);
 };
 
 #endif
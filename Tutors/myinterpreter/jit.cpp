@@ -0,0 +1,825 @@
+
+#if defined(_M_X64) || defined(__x86_64__)
+#	define NATIVE_X64
+#endif
+
+#ifdef NATIVE_X64
+#	ifdef _WIN32
+#		define WIN32_LEAN_AND_MEAN
+#		define NOMINMAX
+#		include <windows.h>
+#	else
+#		include <sys/mman.h>
+#	endif
+#endif
+
+#include "interpreter.h"
+#include <cstring>
+
+#ifdef NATIVE_X64
+
+// x86-64 register encodings
+enum native_register
+{
+	N_RAX = 0,
+	N_RCX,
+	N_RDX,
+	N_RBX,
+	N_RSP,
+	N_RBP,
+	N_RSI,
+	N_RDI,
+	N_R8,
+	N_R9,
+	N_R10,
+	N_R11,
+	N_R12,
+	N_R13,	// address table
+	N_R14,	// register file
+	N_R15	// stack
+};
+
+// exit codes of the generated code
+enum native_status
+{
+	Native_Ok = 0,
+	Native_DivZero,
+	Native_Overflow,
+	Native_BadReturn,
+	Native_NumStatus
+};
+
+#define NUM_MAPPED		10
+#define SHADOW_SPACE	40	// home space for Win64 calls + alignment
+
+// VM registers that live in native ones (the rest stays in the register file)
+static const int native_map[NUM_MAPPED] =
+{
+	N_RBP,	// EBP
+	N_RBX,	// ESP
+	N_RSI,	// EAX
+	N_RDI,	// EBX
+	N_R8,	// ECX
+	N_R9,	// EDX
+	-1,		// EIP
+	N_R10,	// R7
+	N_R11,	// R8
+	N_R12	// R9
+};
+
+// setcc opcodes for the SETL..SETNE pairs
+static const unsigned char native_setcc[6] =
+{
+	0x9c, 0x9e, 0x9f, 0x9d, 0x94, 0x95
+};
+
+// SSE arithmetic for the FSUB..FDIV pairs
+static const unsigned char native_sse[4] =
+{
+	0x5c, 0x58, 0x59, 0x5e
+};
+
+// callee saved registers (in push order)
+static const int native_saved[8] =
+{
+	N_RBX, N_RBP, N_RSI, N_RDI, N_R12, N_R13, N_R14, N_R15
+};
+
+typedef int (*native_func)(int*, char*, const void* const*, const void*);
+
+static void Emit(bytestream& out, int b1, int b2 = -1, int b3 = -1, int b4 = -1, int b5 = -1)
+{
+	int bytes[5] = { b1, b2, b3, b4, b5 };
+
+	for( int i = 0; i < 5 && bytes[i] != -1; ++i )
+		out << OP(bytes[i]);
+}
+
+static void Emit_Ptr(bytestream& out, const void* ptr)
+{
+	unsigned long long value = (unsigned long long)ptr;
+
+	out << (int)(value & 0xffffffff) << (int)(value >> 32);
+}
+
+static void Emit_Rex(bytestream& out, bool wide, int reg, int index, int base)
+{
+	unsigned char rex = 0x40;
+
+	rex |= (wide ? 8 : 0);
+	rex |= ((reg & 8) ? 4 : 0);
+	rex |= ((index & 8) ? 2 : 0);
+	rex |= ((base & 8) ? 1 : 0);
+
+	if( rex != 0x40 )
+		out << rex;
+}
+
+static void Emit_Mov_RR(bytestream& out, int dst, int src)
+{
+	// mov dst32, src32
+	Emit_Rex(out, false, src, 0, dst);
+	Emit(out, 0x89, 0xc0 | ((src & 7) << 3) | (dst & 7));
+}
+
+static void Emit_Op_Base(bytestream& out, unsigned char op, int reg, int base, int disp)
+{
+	// op reg32, [base + disp32]
+	Emit_Rex(out, false, reg, 0, base);
+	Emit(out, op, 0x80 | ((reg & 7) << 3) | (base & 7));
+
+	if( (base & 7) == N_RSP )
+		Emit(out, 0x24);
+
+	out << disp;
+}
+
+static void Emit_Op_Stack(bytestream& out, unsigned char op, int reg, int disp)
+{
+	// op reg32, [r15 + rcx + disp32]
+	Emit_Rex(out, false, reg, N_RCX, N_R15);
+	Emit(out, op, 0x84 | ((reg & 7) << 3), 0x0f);
+
+	out << disp;
+}
+
+static int Native_Register(int vm)
+{
+	return (vm < NUM_MAPPED ? native_map[vm] : -1);
+}
+
+static void Emit_Load(bytestream& out, int vm, int scratch)
+{
+	int reg = Native_Register(vm);
+
+	if( reg != -1 )
+		Emit_Mov_RR(out, scratch, reg);
+	else
+		Emit_Op_Base(out, 0x8b, scratch, N_R14, vm * 4);
+}
+
+static void Emit_Store(bytestream& out, int vm, int scratch)
+{
+	int reg = Native_Register(vm);
+
+	if( reg != -1 )
+		Emit_Mov_RR(out, reg, scratch);
+	else
+		Emit_Op_Base(out, 0x89, scratch, N_R14, vm * 4);
+}
+
+static void Emit_Flush(bytestream& out, size_t numregisters, unsigned char op)
+{
+	// 0x89 writes the mapped registers back, 0x8b reloads them
+	for( size_t i = 0; i < NUM_MAPPED && i < numregisters; ++i )
+	{
+		if( native_map[i] != -1 )
+			Emit_Op_Base(out, op, native_map[i], N_R14, (int)i * 4);
+	}
+}
+
+static size_t Emit_Jump(bytestream& out, unsigned char cc)
+{
+	// cc == 0 is an unconditional jump
+	if( cc == 0 )
+		Emit(out, 0xe9);
+	else
+		Emit(out, 0x0f, cc);
+
+	out << (int)0;
+	return out.size() - 4;
+}
+
+static void Patch_Jump(bytestream& out, size_t at, size_t target)
+{
+	*((int*)out.seek_set(at)) = (int)target - (int)(at + 4);
+}
+
+bool Interpreter::Translate()
+{
+	typedef std::pair<size_t, size_t> jump;
+
+	size_t bytesize = program.size();
+	size_t count = bytesize / ENTRY_SIZE;
+
+	char* bytecode = program.data();
+	char* ptr;
+
+	std::vector<size_t> offsets(count + 1, 0);
+	std::vector<size_t> exits[Native_NumStatus];
+	std::vector<jump> jumps;
+	bytestream out;
+
+	unsigned char opcode;
+	int arg1, arg2;
+	size_t target;
+
+	assert(false, "Interpreter::Translate(): Program size is not a multiple of ENTRY_SIZE", (bytesize % ENTRY_SIZE) == 0);
+	assert(false, "Interpreter::Translate(): Invalid entry point", (entry >= 0 && (size_t)entry < bytesize && (entry % ENTRY_SIZE) == 0));
+
+	ReleaseNative();
+
+	// prologue
+	for( int i = 0; i < 8; ++i )
+	{
+		Emit_Rex(out, false, 0, 0, native_saved[i]);
+		Emit(out, 0x50 + (native_saved[i] & 7));
+	}
+
+	Emit(out, 0x48, 0x83, 0xec, SHADOW_SPACE);	// sub rsp, 40
+
+#ifdef _WIN32
+	Emit(out, 0x49, 0x89, 0xce);	// mov r14, rcx
+	Emit(out, 0x49, 0x89, 0xd7);	// mov r15, rdx
+	Emit(out, 0x4d, 0x89, 0xc5);	// mov r13, r8
+	Emit(out, 0x4c, 0x89, 0xc8);	// mov rax, r9
+#else
+	Emit(out, 0x49, 0x89, 0xfe);	// mov r14, rdi
+	Emit(out, 0x49, 0x89, 0xf7);	// mov r15, rsi
+	Emit(out, 0x49, 0x89, 0xd5);	// mov r13, rdx
+	Emit(out, 0x48, 0x89, 0xc8);	// mov rax, rcx
+#endif
+
+	Emit_Flush(out, numregisters, 0x8b);
+	Emit(out, 0xff, 0xe0);			// jmp rax
+
+#define CHECK_REG(r) \
+	nassert(false, "Interpreter::Translate(): Invalid register operand", (r) < 0 || (size_t)(r) >= numregisters || (r) == EIP)
+
+#define JUMP_TARGET(cc, rel) \
+	target = off + ENTRY_SIZE + (rel); \
+	if( target >= bytesize ) \
+		exits[Native_Ok].push_back(Emit_Jump(out, cc)); \
+	else { \
+		nassert(false, "Interpreter::Translate(): Invalid jump target", (target % ENTRY_SIZE) != 0); \
+		jumps.push_back(jump(Emit_Jump(out, cc), target / ENTRY_SIZE)); \
+	}
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		size_t off = i * ENTRY_SIZE;
+
+		ptr = (bytecode + off);
+		opcode = *((unsigned char*)ptr);
+		arg1 = ARG1_INT(ptr);
+		arg2 = ARG2_INT(ptr);
+
+		offsets[i] = out.size();
+
+		if( opcode < 0x20 )
+		{
+			nassert(false, "Interpreter::Translate(): Invalid special opcode", opcode >= NUM_SPECIAL);
+
+			// let the interpreter do it
+			Emit_Flush(out, numregisters, 0x89);
+
+#ifdef _WIN32
+			Emit(out, 0xb9);				// mov ecx, imm32
+			out << arg1;
+			Emit(out, 0xba);				// mov edx, imm32
+			out << arg2;
+#else
+			Emit(out, 0xbf);				// mov edi, imm32
+			out << arg1;
+			Emit(out, 0xbe);				// mov esi, imm32
+			out << arg2;
+#endif
+
+			Emit(out, 0x48, 0xb8);			// mov rax, imm64
+			Emit_Ptr(out, (const void*)op_special[opcode]);
+			Emit(out, 0xff, 0xd0);			// call rax
+
+			Emit_Flush(out, numregisters, 0x8b);
+			continue;
+		}
+
+		switch( opcode )
+		{
+		case OP_PUSH:
+		case OP_PUSHADD:
+			if( arg1 != EIP )
+				CHECK_REG(arg1);
+
+			Emit_Load(out, ESP, N_RCX);
+			Emit(out, 0x83, 0xe9, 0x04);	// sub ecx, 4
+			exits[Native_Overflow].push_back(Emit_Jump(out, 0x88));
+			Emit_Store(out, ESP, N_RCX);
+
+			if( arg1 == EIP )
+			{
+				Emit(out, 0xb8);			// mov eax, imm32
+				out << (int)(off + ENTRY_SIZE + (opcode == OP_PUSHADD ? arg2 : 0));
+			}
+			else
+			{
+				Emit_Load(out, arg1, N_RAX);
+
+				if( opcode == OP_PUSHADD )
+				{
+					Emit(out, 0x05);		// add eax, imm32
+					out << arg2;
+				}
+			}
+
+			Emit_Op_Stack(out, 0x89, N_RAX, 0);
+			break;
+
+		case OP_POP:
+			if( arg1 != EIP )
+				CHECK_REG(arg1);
+
+			Emit_Load(out, ESP, N_RCX);
+			Emit_Op_Stack(out, 0x8b, N_RAX, 0);
+			Emit(out, 0x83, 0xc1, 0x04);	// add ecx, 4
+			Emit_Store(out, ESP, N_RCX);
+
+			if( arg1 == EIP )
+			{
+				// return: look up the native address
+				Emit(out, 0x3d);			// cmp eax, imm32
+				out << (int)bytesize;
+				exits[Native_Ok].push_back(Emit_Jump(out, 0x83));
+
+				Emit(out, 0x49, 0x8b, 0x44, 0xc5);	// mov rax, [r13 + rax * 8]
+				Emit(out, 0x00);
+				Emit(out, 0x48, 0x85, 0xc0);		// test rax, rax
+				exits[Native_BadReturn].push_back(Emit_Jump(out, 0x84));
+				Emit(out, 0xff, 0xe0);				// jmp rax
+			}
+			else
+			{
+				Emit_Store(out, arg1, N_RAX);
+			}
+
+			break;
+
+		case OP_MOV_RS:
+			CHECK_REG(arg1);
+
+			Emit(out, 0xb8);
+			out << arg2;
+			Emit_Store(out, arg1, N_RAX);
+			break;
+
+		case OP_MOV_RR:
+			CHECK_REG(arg1);
+			CHECK_REG(arg2);
+
+			Emit_Load(out, arg2, N_RAX);
+			Emit_Store(out, arg1, N_RAX);
+			break;
+
+		case OP_MOV_RM:
+			CHECK_REG(arg1);
+
+			Emit_Load(out, EBP, N_RCX);
+			Emit_Op_Stack(out, 0x8b, N_RAX, arg2);
+			Emit_Store(out, arg1, N_RAX);
+			break;
+
+		case OP_MOV_MR:
+			CHECK_REG(arg2);
+
+			Emit_Load(out, arg2, N_RAX);
+			Emit_Load(out, EBP, N_RCX);
+			Emit_Op_Stack(out, 0x89, N_RAX, arg1);
+			break;
+
+		case OP_MOV_MM:
+			Emit_Load(out, EBP, N_RCX);
+			Emit_Op_Stack(out, 0x8b, N_RAX, arg2);
+			Emit_Op_Stack(out, 0x89, N_RAX, arg1);
+			break;
+
+		case OP_MOV_MS:
+		case OP_ADD_MS:
+			Emit_Load(out, EBP, N_RCX);
+			Emit_Op_Stack(out, (opcode == OP_MOV_MS ? 0xc7 : 0x81), 0, arg1);
+			out << arg2;
+			break;
+
+		case OP_AND_RS:
+		case OP_OR_RS:
+			CHECK_REG(arg1);
+
+			if( (opcode == OP_AND_RS) == (arg2 == 0) )
+			{
+				// the result does not depend on the register
+				Emit(out, 0xb8);
+				out << (int)(arg2 != 0);
+			}
+			else
+			{
+				Emit_Load(out, arg1, N_RAX);
+				Emit(out, 0x85, 0xc0);			// test eax, eax
+				Emit(out, 0x0f, 0x95, 0xc0);	// setne al
+				Emit(out, 0x0f, 0xb6, 0xc0);	// movzx eax, al
+			}
+
+			Emit_Store(out, arg1, N_RAX);
+			break;
+
+		case OP_AND_RR:
+		case OP_OR_RR:
+			CHECK_REG(arg1);
+			CHECK_REG(arg2);
+
+			Emit_Load(out, arg1, N_RAX);
+			Emit_Load(out, arg2, N_RCX);
+			Emit(out, 0x85, 0xc0);			// test eax, eax
+			Emit(out, 0x0f, 0x95, 0xc0);	// setne al
+			Emit(out, 0x85, 0xc9);			// test ecx, ecx
+			Emit(out, 0x0f, 0x95, 0xc1);	// setne cl
+			Emit(out, (opcode == OP_AND_RR ? 0x20 : 0x08), 0xc8);	// and/or al, cl
+			Emit(out, 0x0f, 0xb6, 0xc0);	// movzx eax, al
+			Emit_Store(out, arg1, N_RAX);
+			break;
+
+		case OP_NOT:
+			CHECK_REG(arg1);
+
+			Emit_Load(out, arg1, N_RAX);
+			Emit(out, 0x85, 0xc0);			// test eax, eax
+			Emit(out, 0x0f, 0x94, 0xc0);	// sete al
+			Emit(out, 0x0f, 0xb6, 0xc0);	// movzx eax, al
+			Emit_Store(out, arg1, N_RAX);
+			break;
+
+		case OP_NEG:
+			CHECK_REG(arg1);
+
+			Emit_Load(out, arg1, N_RAX);
+			Emit(out, 0xf7, 0xd8);			// neg eax
+			Emit_Store(out, arg1, N_RAX);
+			break;
+
+		case OP_ADD_RS:
+		case OP_SUB_RS:
+			CHECK_REG(arg1);
+
+			Emit_Load(out, arg1, N_RAX);
+			Emit(out, (opcode == OP_ADD_RS ? 0x05 : 0x2d));
+			out << arg2;
+			Emit_Store(out, arg1, N_RAX);
+			break;
+
+		case OP_MUL_RS:
+			CHECK_REG(arg1);
+
+			Emit_Load(out, arg1, N_RAX);
+			Emit(out, 0x69, 0xc0);			// imul eax, eax, imm32
+			out << arg2;
+			Emit_Store(out, arg1, N_RAX);
+			break;
+
+		case OP_ADD_RR:
+		case OP_SUB_RR:
+		case OP_MUL_RR:
+			CHECK_REG(arg1);
+			CHECK_REG(arg2);
+
+			Emit_Load(out, arg1, N_RAX);
+			Emit_Load(out, arg2, N_RCX);
+
+			if( opcode == OP_MUL_RR )
+				Emit(out, 0x0f, 0xaf, 0xc1);	// imul eax, ecx
+			else
+				Emit(out, (opcode == OP_ADD_RR ? 0x01 : 0x29), 0xc8);
+
+			Emit_Store(out, arg1, N_RAX);
+			break;
+
+		case OP_DIV_RS:
+		case OP_MOD_RS:
+		case OP_DIV_RR:
+		case OP_MOD_RR:
+			CHECK_REG(arg1);
+
+			if( opcode == OP_DIV_RS || opcode == OP_MOD_RS )
+			{
+				if( arg2 == 0 )
+				{
+					exits[Native_DivZero].push_back(Emit_Jump(out, 0));
+					break;
+				}
+
+				Emit(out, 0xb9);			// mov ecx, imm32
+				out << arg2;
+			}
+			else
+			{
+				CHECK_REG(arg2);
+
+				Emit_Load(out, arg2, N_RCX);
+				Emit(out, 0x85, 0xc9);		// test ecx, ecx
+				exits[Native_DivZero].push_back(Emit_Jump(out, 0x84));
+			}
+
+			Emit_Load(out, arg1, N_RAX);
+			Emit(out, 0x99);				// cdq
+			Emit(out, 0xf7, 0xf9);			// idiv ecx
+
+			if( opcode == OP_MOD_RS || opcode == OP_MOD_RR )
+				Emit(out, 0x89, 0xd0);		// mov eax, edx
+
+			Emit_Store(out, arg1, N_RAX);
+			break;
+
+		case OP_FSUB_RS:
+		case OP_FSUB_RR:
+		case OP_FADD_RS:
+		case OP_FADD_RR:
+		case OP_FMUL_RS:
+		case OP_FMUL_RR:
+		case OP_FDIV_RS:
+		case OP_FDIV_RR:
+		case OP_FSETL_RS:
+		case OP_FSETL_RR:
+		case OP_FSETLE_RS:
+		case OP_FSETLE_RR:
+		case OP_FSETG_RS:
+		case OP_FSETG_RR:
+		case OP_FSETGE_RS:
+		case OP_FSETGE_RR:
+		case OP_FSETE_RS:
+		case OP_FSETE_RR:
+		case OP_FSETNE_RS:
+		case OP_FSETNE_RR:
+			CHECK_REG(arg1);
+			Emit_Load(out, arg1, N_RAX);
+
+			if( opcode & 1 )
+			{
+				CHECK_REG(arg2);
+				Emit_Load(out, arg2, N_RCX);
+			}
+			else
+			{
+				Emit(out, 0xb9);				// mov ecx, imm32
+				out << arg2;
+			}
+
+			Emit(out, 0x66, 0x0f, 0x6e, 0xc0);	// movd xmm0, eax
+			Emit(out, 0x66, 0x0f, 0x6e, 0xc9);	// movd xmm1, ecx
+
+			if( opcode <= OP_FDIV_RR )
+			{
+				Emit(out, 0xf3, 0x0f, native_sse[(opcode - OP_FSUB_RS) / 2], 0xc1);	// op xmm0, xmm1
+				Emit(out, 0x66, 0x0f, 0x7e, 0xc0);	// movd eax, xmm0
+				Emit_Store(out, arg1, N_RAX);
+				break;
+			}
+
+			// unordered (NaN) compares are false, except for !=
+			switch( (opcode - OP_FSETL_RS) / 2 )
+			{
+			case 0:	Emit(out, 0x0f, 0x2e, 0xc8, 0x0f, 0x97);	break;	// ucomiss xmm1, xmm0 + seta
+			case 1:	Emit(out, 0x0f, 0x2e, 0xc8, 0x0f, 0x93);	break;	// ucomiss xmm1, xmm0 + setae
+			case 2:	Emit(out, 0x0f, 0x2e, 0xc1, 0x0f, 0x97);	break;	// ucomiss xmm0, xmm1 + seta
+			case 3:	Emit(out, 0x0f, 0x2e, 0xc1, 0x0f, 0x93);	break;	// ucomiss xmm0, xmm1 + setae
+			case 4:	Emit(out, 0x0f, 0x2e, 0xc1, 0x0f, 0x94);	break;	// ucomiss xmm0, xmm1 + sete
+			default: Emit(out, 0x0f, 0x2e, 0xc1, 0x0f, 0x95);	break;	// ucomiss xmm0, xmm1 + setne
+			}
+
+			Emit(out, 0xc0);
+
+			if( opcode == OP_FSETE_RS || opcode == OP_FSETE_RR )
+			{
+				Emit(out, 0x0f, 0x9b, 0xc1);	// setnp cl
+				Emit(out, 0x20, 0xc8);			// and al, cl
+			}
+			else if( opcode == OP_FSETNE_RS || opcode == OP_FSETNE_RR )
+			{
+				Emit(out, 0x0f, 0x9a, 0xc1);	// setp cl
+				Emit(out, 0x08, 0xc8);			// or al, cl
+			}
+
+			Emit(out, 0x0f, 0xb6, 0xc0);		// movzx eax, al
+			Emit_Store(out, arg1, N_RAX);
+			break;
+
+		case OP_FNEG:
+			CHECK_REG(arg1);
+
+			Emit_Load(out, arg1, N_RAX);
+			Emit(out, 0x35);				// xor eax, imm32
+			out << (int)INT_MIN;
+			Emit_Store(out, arg1, N_RAX);
+			break;
+
+		case OP_CVT_IF:
+		case OP_CVT_FI:
+			CHECK_REG(arg1);
+
+			Emit_Load(out, arg1, N_RAX);
+
+			if( opcode == OP_CVT_IF )
+			{
+				Emit(out, 0xf3, 0x0f, 0x2a, 0xc0);	// cvtsi2ss xmm0, eax
+				Emit(out, 0x66, 0x0f, 0x7e, 0xc0);	// movd eax, xmm0
+			}
+			else
+			{
+				Emit(out, 0x66, 0x0f, 0x6e, 0xc0);	// movd xmm0, eax
+				Emit(out, 0xf3, 0x0f, 0x2c, 0xc0);	// cvttss2si eax, xmm0
+			}
+
+			Emit_Store(out, arg1, N_RAX);
+			break;
+
+		case OP_JZ:
+		case OP_JNZ:
+			CHECK_REG(arg1);
+
+			Emit_Load(out, arg1, N_RAX);
+			Emit(out, 0x85, 0xc0);
+
+			JUMP_TARGET((opcode == OP_JZ ? 0x84 : 0x85), arg2);
+			break;
+
+		case OP_JMP:
+			nassert(false, "Interpreter::Translate(): Program is not linked", arg1 == UNKNOWN_ADDR);
+
+			JUMP_TARGET(0, arg1);
+			break;
+
+		default:
+			if( opcode >= OP_SETL_RS && opcode <= OP_SETNE_JZ_RR )
+			{
+				// the fused ones store the flag too, so the jz can stay
+				unsigned char base = (opcode >= OP_SETL_JZ_RS ? opcode - 0x20 : opcode);
+
+				if( base > OP_SETNE_RR )
+					break;
+
+				CHECK_REG(arg1);
+				Emit_Load(out, arg1, N_RAX);
+
+				if( base & 1 )
+				{
+					CHECK_REG(arg2);
+
+					Emit_Load(out, arg2, N_RCX);
+					Emit(out, 0x39, 0xc8);	// cmp eax, ecx
+				}
+				else
+				{
+					Emit(out, 0x3d);		// cmp eax, imm32
+					out << arg2;
+				}
+
+				Emit(out, 0x0f, native_setcc[(base - OP_SETL_RS) / 2], 0xc0);
+				Emit(out, 0x0f, 0xb6, 0xc0);
+				Emit_Store(out, arg1, N_RAX);
+			}
+
+			break;
+		}
+	}
+
+#undef JUMP_TARGET
+#undef CHECK_REG
+
+	// falling off the end of the program
+	offsets[count] = out.size();
+	exits[Native_Ok].push_back(Emit_Jump(out, 0));
+
+	for( size_t i = 0; i < jumps.size(); ++i )
+		Patch_Jump(out, jumps[i].first, offsets[jumps[i].second]);
+
+	// exit stubs
+	std::vector<size_t> leave;
+
+	for( int i = 0; i < Native_NumStatus; ++i )
+	{
+		for( size_t j = 0; j < exits[i].size(); ++j )
+			Patch_Jump(out, exits[i][j], out.size());
+
+		Emit(out, 0xb8);	// mov eax, status
+		out << i;
+
+		leave.push_back(Emit_Jump(out, 0));
+	}
+
+	// epilogue
+	for( size_t i = 0; i < leave.size(); ++i )
+		Patch_Jump(out, leave[i], out.size());
+
+	Emit_Flush(out, numregisters, 0x89);
+	Emit(out, 0x48, 0x83, 0xc4, SHADOW_SPACE);	// add rsp, 40
+
+	for( int i = 7; i >= 0; --i )
+	{
+		Emit_Rex(out, false, 0, 0, native_saved[i]);
+		Emit(out, 0x58 + (native_saved[i] & 7));
+	}
+
+	Emit(out, 0xc3);	// ret
+
+	// copy to executable memory
+	nativesize = out.size();
+
+#ifdef _WIN32
+	native = VirtualAlloc(0, nativesize, MEM_COMMIT|MEM_RESERVE, PAGE_READWRITE);
+	assert(false, "Interpreter::Translate(): Could not allocate executable memory", native);
+#else
+	native = mmap(0, nativesize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+
+	if( native == MAP_FAILED )
+		native = 0;
+
+	assert(false, "Interpreter::Translate(): Could not allocate executable memory", native);
+#endif
+
+	memcpy(native, out.data(), nativesize);
+
+#ifdef _WIN32
+	DWORD oldprotect;
+	VirtualProtect(native, nativesize, PAGE_EXECUTE_READ, &oldprotect);
+#else
+	mprotect(native, nativesize, PROT_READ|PROT_EXEC);
+#endif
+
+	// return addresses are byte offsets into the bytestream
+	nativetable.assign(bytesize, (const void*)0);
+
+	for( size_t i = 0; i < count; ++i )
+		nativetable[i * ENTRY_SIZE] = (const char*)native + offsets[i];
+
+	return true;
+}
+
+void Interpreter::ReleaseNative()
+{
+	if( native )
+	{
+#ifdef _WIN32
+		VirtualFree(native, 0, MEM_RELEASE);
+#else
+		munmap(native, nativesize);
+#endif
+	}
+
+	native = 0;
+	nativesize = 0;
+	nativetable.clear();
+}
+
+bool Interpreter::Run_Native(vm_context& ctx)
+{
+	int* registers = ctx.registers;
+	char* stack = ctx.stack;
+
+	// first run translates, the others wait for it
+	prepareguard.Lock();
+
+	bool ready = (native || Translate());
+
+	if( !ready )
+		ReleaseNative();
+
+	prepareguard.Unlock();
+
+	if( !ready )
+	{
+		warn("Interpreter::Run(): Native translation failed, falling back to switch dispatch");
+		return Run_Switch(ctx);
+	}
+
+	memset(registers, 0, numregisters * sizeof(int));
+
+	registers[EBP] = STACK_SIZE;
+	registers[ESP] = STACK_SIZE;
+	registers[EIP] = entry;
+
+	native_func func = (native_func)native;
+	int status = func(registers, stack, &nativetable[0], nativetable[entry]);
+
+	nassert(false, "EXCEPTION: Division by zero", status == Native_DivZero);
+	nassert(false, "EXCEPTION: Stack overflow", status == Native_Overflow);
+	nassert(false, "EXCEPTION: Invalid return address", status == Native_BadReturn);
+
+	return true;
+}
+
+#else
+
+bool Interpreter::Translate()
+{
+	return false;
+}
+
+void Interpreter::ReleaseNative()
+{
+	native = 0;
+	nativesize = 0;
+	nativetable.clear();
+}
+
+bool Interpreter::Run_Native(vm_context& ctx)
+{
+	warn("Interpreter::Run(): Native code is only generated on x86-64, falling back to switch dispatch");
+	return Run_Switch(ctx);
+}
+
+#endif
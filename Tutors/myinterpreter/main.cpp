@@ -1,9 +1,323 @@
 
+#ifdef _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <windows.h>
+#else
+#	include <pthread.h>
+#	include <unistd.h>
+#endif
+
 #include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <ctime>
 #include "interpreter.h"
+#include "guard.h"
+
+#ifdef _MSC_VER
+#	define _CRTDBG_MAP_ALLOC
+#	include <crtdbg.h>
+#endif
+
+#define MAX_BENCHMARK_THREADS	64
+
+void Benchmark(Interpreter& ip, execution_mode mode, const char* name, int runs)
+{
+	std::streambuf* coutbuf = std::cout.rdbuf(0);
+	clock_t start = clock();
+
+	ip.SetExecutionMode(mode);
+
+	for( int i = 0; i < runs; ++i )
+		ip.Run();
+
+	clock_t elapsed = clock() - start;
+
+	std::cout.rdbuf(coutbuf);
+	std::cout.clear();
+
+	std::cout << name << ": " << runs << " runs in " << (elapsed * 1000 / CLOCKS_PER_SEC) << " ms\n";
+}
+
+void Benchmark_Inline(const char* file, int runs)
+{
+	// the same pipeline with and without the inliner
+	for( int pass = 0; pass < 2; ++pass )
+	{
+		Interpreter ip;
+		std::streambuf* coutbuf = std::cout.rdbuf(0);
+
+		ip.Compile(file);
+		ip.AllocateRegisters();
+
+		if( pass == 1 )
+			ip.Inline();
+
+		ip.Optimize();
+		ip.Link();
+
+		std::cout.rdbuf(coutbuf);
+		std::cout.clear();
+
+		Benchmark(ip, Exec_Threaded, (pass == 0 ? "calls" : "inlined"), runs);
+	}
+}
+
+#ifdef _WIN32
+typedef DWORD thread_result;
+#	define THREAD_CALL WINAPI
+#else
+typedef void* thread_result;
+#	define THREAD_CALL
+#endif
+
+typedef thread_result (THREAD_CALL *thread_func)(void*);
+
+long Core_Count()
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+
+	GetSystemInfo(&info);
+	return (long)info.dwNumberOfProcessors;
+#else
+	return sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+}
+
+long Milliseconds()
+{
+	// wall clock (clock() is process CPU time outside Windows)
+#ifdef _WIN32
+	return (long)(clock() * 1000 / CLOCKS_PER_SEC);
+#else
+	timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long)(now.tv_sec * 1000 + now.tv_nsec / 1000000);
+#endif
+}
+
+void Run_Threads(thread_func func, void* param, long count)
+{
+	// starts count threads and waits for all of them
+#ifdef _WIN32
+	HANDLE threads[MAX_BENCHMARK_THREADS];
+
+	for( long i = 0; i < count; ++i )
+		threads[i] = CreateThread(NULL, 0, func, param, 0, NULL);
+
+	WaitForMultipleObjects((DWORD)count, threads, TRUE, INFINITE);
+
+	for( long i = 0; i < count; ++i )
+		CloseHandle(threads[i]);
+#else
+	pthread_t threads[MAX_BENCHMARK_THREADS];
+
+	for( long i = 0; i < count; ++i )
+		pthread_create(&threads[i], 0, func, param);
+
+	for( long i = 0; i < count; ++i )
+		pthread_join(threads[i], 0);
+#endif
+}
+
+struct worker_desc
+{
+	Interpreter* ip;
+	const char* file;
+	int runs;
+	int failed;
+	Guard guard;
+};
+
+thread_result THREAD_CALL Run_Worker(void* param)
+{
+	// every thread has its own registers and stack
+	worker_desc* desc = (worker_desc*)param;
+	vm_context ctx;
+
+	for( int i = 0; i < desc->runs; ++i )
+		desc->ip->Run(ctx);
+
+	return 0;
+}
+
+thread_result THREAD_CALL Compile_Worker(void* param)
+{
+	// every compile has its own scanner and parser state
+	worker_desc* desc = (worker_desc*)param;
+
+	for( int i = 0; i < desc->runs; ++i )
+	{
+		Interpreter ip;
+
+		if( !ip.Compile(desc->file) || !ip.Link() )
+		{
+			desc->guard.Lock();
+			++desc->failed;
+			desc->guard.Unlock();
+		}
+	}
+
+	return 0;
+}
+
+void Benchmark_Threads(Interpreter& ip, execution_mode mode, int runs)
+{
+	worker_desc desc;
+	long cores = Core_Count();
 
-#define _CRTDBG_MAP_ALLOC
-#include <crtdbg.h>
+	desc.ip = &ip;
+	desc.file = 0;
+	desc.runs = runs;
+	desc.failed = 0;
+
+	ip.SetExecutionMode(mode);
+
+	for( long count = 1; count <= cores && count <= MAX_BENCHMARK_THREADS; count *= 2 )
+	{
+		std::streambuf* coutbuf = std::cout.rdbuf(0);
+		long start = Milliseconds();
+
+		Run_Threads(&Run_Worker, &desc, count);
+
+		long elapsed = Milliseconds() - start;
+
+		std::cout.rdbuf(coutbuf);
+		std::cout.clear();
+
+		std::cout << count << " threads: " << (count * runs) << " runs in " << elapsed << " ms ("
+			<< (count * runs * 1000 / std::max<long>(elapsed, 1)) << " runs/s)\n";
+	}
+}
+
+void Generate_Script(const char* file, int lines)
+{
+	// one huge function made of deeply nested blocks
+	std::ofstream out(file);
+	int count = 6;
+	int depth = 16;
+
+	out << "int main()\n{\n\tint a = 0;\n\tint b = 1;\n";
+
+	while( count < lines )
+	{
+		for( int i = 0; i < depth; ++i )
+		{
+			out << std::string(i + 1, '\t') << (i % 2 ? "if( a < " : "while( a > ") << i << " )\n";
+			out << std::string(i + 1, '\t') << "{\n";
+			out << std::string(i + 2, '\t') << "a = a + b * " << i << ";\n";
+			out << std::string(i + 2, '\t') << "b = (b - a) % 7;\n";
+		}
+
+		for( int i = depth - 1; i >= 0; --i )
+			out << std::string(i + 1, '\t') << "}\n";
+
+		count += depth * 5;
+	}
+
+	out << "\treturn a;\n}\n";
+}
+
+void Benchmark_Compile(const char* file, int lines, int runs)
+{
+	Generate_Script(file, lines);
+
+	std::streambuf* coutbuf = std::cout.rdbuf(0);
+	clock_t start = clock();
+
+	for( int i = 0; i < runs; ++i )
+	{
+		Interpreter ip;
+		ip.Compile(file);
+	}
+
+	clock_t elapsed = clock() - start;
+
+	std::cout.rdbuf(coutbuf);
+	std::cout.clear();
+
+	std::cout << "compile " << lines << " lines: " << runs << " runs in " << (elapsed * 1000 / CLOCKS_PER_SEC) << " ms\n";
+}
+
+void Benchmark_Compile_Threads(const char* file, int runs)
+{
+	// the parser is pure, several interpreters compile at the same time
+	worker_desc desc;
+	long cores = Core_Count();
+
+	desc.ip = 0;
+	desc.file = file;
+	desc.runs = runs;
+
+	for( long count = 1; count <= cores && count <= MAX_BENCHMARK_THREADS; count *= 2 )
+	{
+		std::streambuf* coutbuf = std::cout.rdbuf(0);
+		long start = Milliseconds();
+
+		desc.failed = 0;
+		Run_Threads(&Compile_Worker, &desc, count);
+
+		long elapsed = Milliseconds() - start;
+
+		std::cout.rdbuf(coutbuf);
+		std::cout.clear();
+
+		std::cout << count << " threads: " << (count * runs) << " compiles in " << elapsed << " ms";
+
+		if( desc.failed > 0 )
+			std::cout << " (" << desc.failed << " failed)";
+
+		std::cout << "\n";
+	}
+}
+
+void Benchmark_Output(const char* file, const char* outfile)
+{
+	Interpreter ip;
+	std::streambuf* coutbuf = std::cout.rdbuf(0);
+
+	bool ok = (ip.Compile(file) && ip.Link());
+
+	std::cout.rdbuf(coutbuf);
+	std::cout.clear();
+
+	if( !ok )
+		return;
+
+	// a tiny buffer is flushed on almost every print, like std::cout was
+	const size_t sizes[] = { 16, OUTPUT_BUFFER_SIZE };
+	OutputSink& output = ip.Output();
+
+	ip.SetExecutionMode(Exec_Threaded);
+
+	for( int i = 0; i < 2; ++i )
+	{
+		output.Resize(sizes[i]);
+
+		if( !output.RedirectToFile(outfile) )
+			return;
+
+		clock_t start = clock();
+		ip.Run();
+		clock_t elapsed = clock() - start;
+
+		std::cout << "file, " << sizes[i] << " byte buffer: " << (elapsed * 1000 / CLOCKS_PER_SEC) << " ms\n";
+	}
+
+	output.RedirectToMemory();
+
+	clock_t start = clock();
+	ip.Run();
+	clock_t elapsed = clock() - start;
+
+	std::cout << "memory: " << (elapsed * 1000 / CLOCKS_PER_SEC) << " ms (" << output.Captured().size() << " bytes)\n";
+
+	output.ClearCaptured();
+	output.RedirectToConsole();
+}
 
 int main()
 {
@@ -15,7 +329,10 @@ int main()
 		//ip.Compile("programs/helloworld.p");
 		//ip.Compile("programs/factorial.p");
 		//ip.Compile("programs/lnko.p");
+		//ip.Compile("programs/config.p");
 		ip.Compile("../myinterpreter/programs/bigtest.p");
+		ip.AllocateRegisters();
+		ip.Optimize();
 		ip.Link();
 
 		std::cout << "\n";
@@ -25,9 +342,93 @@ int main()
 		ip.Run();
 	}
 
+	{
+		Interpreter ip;
+
+		// link a program, then append a new entry point that calls into it
+		std::cout << "\n";
+
+		if( ip.Compile("../myinterpreter/programs/lnko.p") && ip.Link() )
+		{
+			ip.Run();
+
+			if( ip.Append("../myinterpreter/programs/lkkt.p") && ip.Link() )
+				ip.Run();
+		}
+	}
+
+	const char* programs[] =
+	{
+		"../myinterpreter/programs/factorial.p",
+		"../myinterpreter/programs/lnko.p",
+		"../myinterpreter/programs/primes.p",
+		"../myinterpreter/programs/floats.p",
+		"../myinterpreter/programs/bigtest.p"
+	};
+
+	const int runs[] = { 100000, 100000, 10, 10, 100000 };
+
+	for( int i = 0; i < 5; ++i )
+	{
+		Interpreter ip;
+
+		std::cout << "\n";
+
+		// second start loads the linked image
+		if( !ip.CompileCached(programs[i], "../myinterpreter/cache") )
+			continue;
+
+		ip.Compact();
+
+		Benchmark(ip, Exec_Switch, "switch dispatch", runs[i]);
+		Benchmark(ip, Exec_Threaded, "threaded dispatch", runs[i]);
+		Benchmark(ip, Exec_Compact, "compact encoding", runs[i]);
+		Benchmark(ip, Exec_Native, "native code", runs[i]);
+	}
+
+	std::cout << "\n";
+	Benchmark_Inline("../myinterpreter/programs/calls.p", 100);
+
+	{
+		Interpreter ip;
+
+		// flat profile on the console, call stacks for flame graph tools
+		std::cout << "\n";
+
+		if( ip.CompileCached("../myinterpreter/programs/primes.p", "../myinterpreter/cache") )
+		{
+			ip.SetExecutionMode(Exec_Profile);
+			ip.Run();
+
+			ip.PrintProfile();
+			ip.SaveProfile("../myinterpreter/cache/primes.folded");
+		}
+	}
+
+	{
+		Interpreter ip;
+
+		// the same program on more and more threads
+		std::cout << "\n";
+
+		if( ip.CompileCached("../myinterpreter/programs/primes.p", "../myinterpreter/cache") )
+			Benchmark_Threads(ip, Exec_Threaded, 4);
+	}
+
+	std::cout << "\n";
+	Benchmark_Compile("../myinterpreter/programs/generated.p", 50000, 5);
+	Benchmark_Compile_Threads("../myinterpreter/programs/bigtest.p", 50);
+
+	std::cout << "\n";
+	Benchmark_Output("../myinterpreter/programs/printing.p", "../myinterpreter/cache/printing.txt");
+
+#ifdef _MSC_VER
 	_CrtDumpMemoryLeaks();
+#endif
 
+#ifdef _WIN32
 	system("pause");
+#endif
 	return 0;
 }
 
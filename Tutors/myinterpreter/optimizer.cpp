@@ -0,0 +1,906 @@
+
+#include "interpreter.h"
+#include <algorithm>
+#include <set>
+
+#define MAX_LIVENESS_STEPS	16
+
+static bool Is_General(int reg)
+{
+	return (reg >= EAX && reg <= EDX);
+}
+
+static bool Is_Relation(unsigned char opcode)
+{
+	return (opcode >= OP_SETL_RS && opcode <= OP_SETNE_RR);
+}
+
+static bool Is_Float(unsigned char opcode)
+{
+	return ((opcode >= OP_FSUB_RS && opcode <= OP_CVT_FI) || (opcode >= OP_FSETL_RS && opcode <= OP_FSETNE_RR));
+}
+
+static bool Is_Tracked(int reg)
+{
+	return (Is_General(reg) || reg >= FIRST_VREG);
+}
+
+static bool Writes_Register(unsigned char opcode)
+{
+	// modifies reg[arg1]
+	return (
+		opcode == OP_POP ||
+		(opcode >= OP_MOV_RS && opcode <= OP_MOV_RM) ||
+		(opcode >= OP_AND_RS && opcode <= OP_SETNE_RR) ||
+		(opcode >= OP_SETL_JZ_RS && opcode <= OP_SETNE_JZ_RR) ||
+		Is_Float(opcode));
+}
+
+static bool Has_Immediate_Form(unsigned char opcode)
+{
+	// the _RS variant is opcode - 1
+	switch( opcode )
+	{
+	case OP_AND_RR:
+	case OP_OR_RR:
+	case OP_SUB_RR:
+	case OP_ADD_RR:
+	case OP_MUL_RR:
+	case OP_DIV_RR:
+	case OP_MOD_RR:
+	case OP_SETL_RR:
+	case OP_SETLE_RR:
+	case OP_SETG_RR:
+	case OP_SETGE_RR:
+	case OP_SETE_RR:
+	case OP_SETNE_RR:
+	case OP_SETL_JZ_RR:
+	case OP_SETLE_JZ_RR:
+	case OP_SETG_JZ_RR:
+	case OP_SETGE_JZ_RR:
+	case OP_SETE_JZ_RR:
+	case OP_SETNE_JZ_RR:
+	case OP_FSUB_RR:
+	case OP_FADD_RR:
+	case OP_FMUL_RR:
+	case OP_FDIV_RR:
+	case OP_FSETL_RR:
+	case OP_FSETLE_RR:
+	case OP_FSETG_RR:
+	case OP_FSETGE_RR:
+	case OP_FSETE_RR:
+	case OP_FSETNE_RR:
+		return true;
+
+	default:
+		break;
+	}
+
+	return false;
+}
+
+static bool Evaluate(unsigned char opcode, int a, int b, int& result)
+{
+	// opcode is an _RS instruction (or unary)
+	if( opcode >= OP_SETL_JZ_RS && opcode <= OP_SETNE_JZ_RR )
+		opcode -= 0x20;
+
+	switch( opcode )
+	{
+	case OP_AND_RS:		result = (a && b);	break;
+	case OP_OR_RS:		result = (a || b);	break;
+	case OP_NOT:		result = (a == 0);	break;
+	case OP_SUB_RS:		result = a - b;		break;
+	case OP_ADD_RS:		result = a + b;		break;
+	case OP_MUL_RS:		result = a * b;		break;
+	case OP_NEG:		result = -a;		break;
+	case OP_SETL_RS:	result = (a < b);	break;
+	case OP_SETLE_RS:	result = (a <= b);	break;
+	case OP_SETG_RS:	result = (a > b);	break;
+	case OP_SETGE_RS:	result = (a >= b);	break;
+	case OP_SETE_RS:	result = (a == b);	break;
+	case OP_SETNE_RS:	result = (a != b);	break;
+
+	case OP_DIV_RS:
+	case OP_MOD_RS:
+		// leave it to runtime
+		if( b == 0 || (a == INT_MIN && b == -1) )
+			return false;
+
+		result = (opcode == OP_DIV_RS ? a / b : a % b);
+		break;
+
+	// same single precision math as the VM
+	case OP_FSUB_RS:	result = FLOAT_OP(a, -, b);		break;
+	case OP_FADD_RS:	result = FLOAT_OP(a, +, b);		break;
+	case OP_FMUL_RS:	result = FLOAT_OP(a, *, b);		break;
+	case OP_FDIV_RS:	result = FLOAT_OP(a, /, b);		break;
+	case OP_FNEG:		result = (a ^ INT_MIN);			break;
+	case OP_CVT_IF:		result = Float_To_Bits((float)a);	break;
+	case OP_FSETL_RS:	result = FLOAT_CMP(a, <, b);	break;
+	case OP_FSETLE_RS:	result = FLOAT_CMP(a, <=, b);	break;
+	case OP_FSETG_RS:	result = FLOAT_CMP(a, >, b);	break;
+	case OP_FSETGE_RS:	result = FLOAT_CMP(a, >=, b);	break;
+	case OP_FSETE_RS:	result = FLOAT_CMP(a, ==, b);	break;
+	case OP_FSETNE_RS:	result = FLOAT_CMP(a, !=, b);	break;
+
+	case OP_CVT_FI:
+		// out of range is undefined, leave it to runtime
+		if( !(Bits_To_Float(a) > -2147483648.0f && Bits_To_Float(a) < 2147483648.0f) )
+			return false;
+
+		result = (int)Bits_To_Float(a);
+		break;
+
+	default:
+		return false;
+	}
+
+	return true;
+}
+
+static int Next_Kept(const codelist& code, int index)
+{
+	int count = (int)code.size();
+
+	while( index < count && code[index].removed )
+		++index;
+
+	return index;
+}
+
+static bool Is_Fused(const codelist& code, int index)
+{
+	// is the previous instruction a fused one?
+	while( --index >= 0 )
+	{
+		if( !code[index].removed )
+			return (code[index].opcode >= OP_SETL_JZ_RS && code[index].opcode <= OP_SETNE_JZ_RR);
+	}
+
+	return false;
+}
+
+static bool Is_Dead(const codelist& code, int index, int reg, int steps = MAX_LIVENESS_STEPS)
+{
+	// NOTE: labels are indices here (freshly decoded code)
+	int count = (int)code.size();
+
+	for( ; steps > 0; --steps )
+	{
+		index = Next_Kept(code, index);
+
+		if( index >= count )
+			return true;
+
+		const code_entry& e = code[index];
+
+		switch( e.opcode )
+		{
+		case OP_PRINT_M:
+		case OP_MOV_MM:
+		case OP_MOV_MS:
+		case OP_ADD_MS:
+			break;
+
+		case OP_MOV_RS:
+		case OP_MOV_RM:
+			if( e.arg1 == reg )
+				return true;
+
+			break;
+
+		case OP_POP:
+			if( e.arg1 == EIP )
+				return false;
+
+			if( e.arg1 == reg )
+				return true;
+
+			break;
+
+		case OP_MOV_RR:
+			if( e.arg2 == reg )
+				return false;
+
+			if( e.arg1 == reg )
+				return true;
+
+			break;
+
+		case OP_MOV_MR:
+			if( e.arg2 == reg )
+				return false;
+
+			break;
+
+		case OP_PUSH:
+		case OP_PRINT_R:
+		case OP_PRINT_F:
+			if( e.arg1 == reg )
+				return false;
+
+			break;
+
+		case OP_JZ:
+		case OP_JNZ:
+			if( e.arg1 == reg || e.target < 0 )
+				return false;
+
+			// both ways
+			if( !Is_Dead(code, e.target, reg, steps - 1) )
+				return false;
+
+			break;
+
+		case OP_JMP:
+			if( e.target < 0 )
+				return false;
+
+			// follow the jump
+			index = e.target;
+			continue;
+
+		default:
+			if( ((e.opcode >= OP_AND_RS && e.opcode <= OP_SETNE_JZ_RR) || Is_Float(e.opcode)) && e.arg1 != reg )
+			{
+				// reads and writes arg1 only (or arg2 as a register)
+				if( !Has_Immediate_Form(e.opcode) || e.arg2 != reg )
+					break;
+			}
+
+			// reads its operands or leaves the basic block
+			return false;
+		}
+
+		++index;
+	}
+
+	return false;
+}
+
+static void Find_Constants(const codelist& code, int start, int end, constantmap& regs, constantmap& slots)
+{
+	// registers and locals that are assigned exactly once, with an immediate
+	regs.clear();
+	slots.clear();
+
+	for( int i = start; i < end; ++i )
+	{
+		const code_entry& e = code[i];
+
+		if( e.removed )
+			continue;
+
+		if( e.arg1 >= FIRST_VREG && Writes_Register(e.opcode) && e.opcode != OP_POP )
+		{
+			// (pop only restores callee saved registers)
+			constant_desc& reg = regs[e.arg1];
+
+			reg.known = (reg.writes == 0 && e.opcode == OP_MOV_RS);
+			reg.value = e.arg2;
+			++reg.writes;
+		}
+		else if( e.arg1 < 0 && (e.opcode == OP_MOV_MR || e.opcode == OP_MOV_MM || e.opcode == OP_MOV_MS || e.opcode == OP_ADD_MS) )
+		{
+			constant_desc& slot = slots[e.arg1];
+
+			slot.known = (slot.writes == 0 && e.opcode == OP_MOV_MS);
+			slot.value = e.arg2;
+			++slot.writes;
+		}
+	}
+}
+
+static size_t Fold_Constants(codelist& code, int start, int end, int numregs)
+{
+	// NOTE: reading an uninitialized local is undefined anyway
+	constantmap regs, slots;
+	constantmap::iterator it;
+	std::vector<int> value(numregs, 0);
+	std::vector<bool> known(numregs, false);
+	std::vector<std::pair<int, int> > pushed;	// (index, value) of pushes in this block
+	size_t folded = 0;
+	int result;
+
+	Find_Constants(code, start, end, regs, slots);
+
+	for( int i = start; i < end; ++i )
+	{
+		code_entry& e = code[i];
+
+		if( e.removed )
+			continue;
+
+		if( e.barrier )
+		{
+			known.assign(numregs, false);
+			pushed.clear();
+		}
+
+		// single assignment registers are known in the whole function
+		for( it = regs.begin(); it != regs.end(); ++it )
+		{
+			if( it->second.known && it->second.writes == 1 && it->first < numregs )
+			{
+				known[it->first] = true;
+				value[it->first] = it->second.value;
+			}
+		}
+
+		bool src = (e.arg2 >= 0 && e.arg2 < numregs && Is_Tracked(e.arg2) && known[e.arg2]);
+		bool dst = (e.arg1 >= 0 && e.arg1 < numregs && Is_Tracked(e.arg1) && known[e.arg1]);
+
+		switch( e.opcode )
+		{
+		case OP_MOV_RR:
+			if( src )
+			{
+				e.opcode = OP_MOV_RS;
+				e.arg2 = value[e.arg2];
+
+				++folded;
+			}
+
+			break;
+
+		case OP_MOV_RM:
+			it = slots.find(e.arg2);
+
+			if( it != slots.end() && it->second.known && it->second.writes == 1 )
+			{
+				e.opcode = OP_MOV_RS;
+				e.arg2 = it->second.value;
+
+				++folded;
+			}
+
+			break;
+
+		case OP_MOV_MR:
+			if( src )
+			{
+				e.opcode = OP_MOV_MS;
+				e.arg2 = value[e.arg2];
+
+				++folded;
+			}
+
+			break;
+
+		case OP_MOV_MM:
+			it = slots.find(e.arg2);
+
+			if( it != slots.end() && it->second.known && it->second.writes == 1 )
+			{
+				e.opcode = OP_MOV_MS;
+				e.arg2 = it->second.value;
+
+				++folded;
+			}
+
+			break;
+
+		case OP_PUSH:
+			if( dst )
+				pushed.push_back(std::make_pair(i, value[e.arg1]));
+			else
+				pushed.push_back(std::make_pair(-1, 0));
+			break;
+
+		case OP_POP:
+			if( !pushed.empty() && pushed.back().first >= 0 && Is_Tracked(e.arg1) )
+			{
+				// push known + pop reg (nothing touches ESP in between)
+				int push = pushed.back().first;
+
+				e.opcode = OP_MOV_RS;
+				e.arg2 = pushed.back().second;
+				code[push].removed = true;
+
+				if( code[push].barrier && Next_Kept(code, push) < (int)code.size() )
+					code[Next_Kept(code, push)].barrier = true;
+
+				++folded;
+			}
+
+			if( !pushed.empty() )
+				pushed.pop_back();
+
+			break;
+
+		case OP_JZ:
+		case OP_JNZ:
+			if( dst && e.target >= 0 && !Is_Fused(code, i) )
+			{
+				if( (value[e.arg1] == 0) == (e.opcode == OP_JZ) )
+				{
+					// always taken
+					e.opcode = OP_JMP;
+					e.arg1 = 0;
+					e.arg2 = NIL;
+				}
+				else
+				{
+					// never taken
+					e.removed = true;
+
+					if( e.barrier && Next_Kept(code, i) < (int)code.size() )
+						code[Next_Kept(code, i)].barrier = true;
+				}
+
+				++folded;
+			}
+
+			break;
+
+		default:
+			if( !Is_Tracked(e.arg1) || !Writes_Register(e.opcode) )
+				break;
+
+			if( src && Has_Immediate_Form(e.opcode) )
+			{
+				e.opcode = e.opcode - 1;
+				e.arg2 = value[e.arg2];
+
+				++folded;
+			}
+
+			if( dst && (e.opcode == OP_NOT || e.opcode == OP_NEG || !Has_Immediate_Form(e.opcode)) &&
+				Evaluate(e.opcode, value[e.arg1], e.arg2, result) )
+			{
+				// the jz of a fused instruction stays, so it can be folded too
+				e.opcode = OP_MOV_RS;
+				e.arg2 = result;
+
+				++folded;
+			}
+
+			break;
+		}
+
+		if( e.removed )
+			continue;
+
+		if( e.opcode == OP_JMP || (e.opcode == OP_POP && e.arg1 == EIP) )
+		{
+			// calls and returns
+			known.assign(numregs, false);
+			pushed.clear();
+		}
+		else if( e.opcode == OP_PUSHADD || e.arg1 == ESP || (e.opcode == OP_MOV_RR && e.arg2 == ESP) )
+		{
+			pushed.clear();
+		}
+		else if( e.arg1 >= 0 && e.arg1 < numregs && Writes_Register(e.opcode) )
+		{
+			known[e.arg1] = (e.opcode == OP_MOV_RS);
+			value[e.arg1] = e.arg2;
+		}
+	}
+
+	return folded;
+}
+
+static size_t Remove_Unreachable(codelist& code, const std::vector<int>& roots)
+{
+	int n = (int)code.size();
+	std::vector<bool> reached(n, false);
+	std::vector<int> stack;
+	size_t removed = 0;
+
+	for( size_t i = 0; i < roots.size(); ++i )
+		stack.push_back(roots[i]);
+
+	while( !stack.empty() )
+	{
+		int i = Next_Kept(code, stack.back());
+		stack.pop_back();
+
+		if( i >= n || reached[i] )
+			continue;
+
+		const code_entry& e = code[i];
+		reached[i] = true;
+
+		// calls return to the target of the pushadd
+		if( e.target >= 0 )
+			stack.push_back(e.target);
+
+		if( e.opcode == OP_JMP || (e.opcode == OP_POP && e.arg1 == EIP) )
+			continue;
+
+		stack.push_back(i + 1);
+	}
+
+	for( int i = 0; i < n; ++i )
+	{
+		code[i].barrier = false;
+
+		if( !code[i].removed && !reached[i] )
+		{
+			code[i].removed = true;
+			++removed;
+		}
+	}
+
+	// only live jumps make barriers
+	for( int i = 0; i < n; ++i )
+	{
+		if( !code[i].removed && code[i].target >= 0 && Next_Kept(code, code[i].target) < n )
+			code[Next_Kept(code, code[i].target)].barrier = true;
+	}
+
+	for( size_t i = 0; i < roots.size(); ++i )
+	{
+		if( Next_Kept(code, roots[i]) < n )
+			code[Next_Kept(code, roots[i])].barrier = true;
+	}
+
+	return removed;
+}
+
+bool Interpreter::Decode(codelist& code)
+{
+	size_t bytesize = program.size();
+	size_t count = bytesize / ENTRY_SIZE;
+
+	char* bytecode = program.data();
+	char* ptr;
+	int off;
+
+	assert(false, "Interpreter::Decode(): Program size is not a multiple of ENTRY_SIZE", (bytesize % ENTRY_SIZE) == 0);
+
+	const bytestream::linetable& lines = program.lines();
+	size_t mark = 0;
+	int line = 0;
+
+	code.clear();
+	code.resize(count);
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		code_entry& e = code[i];
+		ptr = (bytecode + i * ENTRY_SIZE);
+
+		while( mark < lines.size() && lines[mark].first <= i * ENTRY_SIZE )
+			line = lines[mark++].second;
+
+		e.opcode = *((unsigned char*)ptr);
+		e.arg1 = ARG1_INT(ptr);
+		e.arg2 = ARG2_INT(ptr);
+		e.label = (int)i;
+		e.line = line;
+
+		if( e.opcode == OP_JZ || e.opcode == OP_JNZ )
+			off = e.arg2;
+		else if( e.opcode == OP_PUSHADD && e.arg1 == EIP )
+			off = e.arg2;
+		else if( e.opcode == OP_JMP && e.arg1 != UNKNOWN_ADDR )
+			off = e.arg1;
+		else
+			continue;
+
+		off += (int)((i + 1) * ENTRY_SIZE);
+
+		nassert(false, "Interpreter::Decode(): Invalid jump target", off < 0 || (off % ENTRY_SIZE) != 0);
+		e.target = std::min<int>(off / ENTRY_SIZE, (int)count);
+	}
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		if( code[i].target >= 0 && code[i].target < (int)count )
+			code[code[i].target].barrier = true;
+	}
+
+	if( count > 0 )
+		code[entry / ENTRY_SIZE].barrier = true;
+
+	// every function, even the ones linked by a previous Link()
+	for( symboltable::iterator it = scopes[0].begin(); it != scopes[0].end(); ++it )
+	{
+		off = it->second->address / ENTRY_SIZE;
+
+		if( off < (int)count )
+			code[off].barrier = true;
+	}
+
+	return true;
+}
+
+void Interpreter::Encode(codelist& code)
+{
+	std::vector<int> position;
+	std::vector<int> pending;
+	bytestream result;
+	int kept = 0;
+	int line = 0;
+	int off;
+
+	// find out where the labels went
+	for( size_t i = 0; i < code.size(); ++i )
+	{
+		const code_entry& e = code[i];
+
+		if( e.label >= 0 )
+			pending.push_back(e.label);
+
+		if( e.removed )
+			continue;
+
+		for( size_t j = 0; j < pending.size(); ++j )
+		{
+			if( pending[j] >= (int)position.size() )
+				position.resize(pending[j] + 1, -1);
+
+			position[pending[j]] = kept;
+		}
+
+		pending.clear();
+		++kept;
+	}
+
+	// labels at the end of the program (including 'count')
+	for( size_t j = 0; j < pending.size(); ++j )
+	{
+		if( pending[j] >= (int)position.size() )
+			position.resize(pending[j] + 1, -1);
+
+		position[pending[j]] = kept;
+	}
+
+	for( size_t i = 0; i < code.size(); ++i )
+	{
+		if( code[i].target >= (int)position.size() )
+			position.resize(code[i].target + 1, -1);
+	}
+
+	for( size_t i = 0; i < position.size(); ++i )
+	{
+		if( position[i] == -1 )
+			position[i] = kept;
+	}
+
+	kept = 0;
+
+	for( size_t i = 0; i < code.size(); ++i )
+	{
+		code_entry& e = code[i];
+
+		if( e.removed )
+			continue;
+
+		if( e.target >= 0 )
+		{
+			off = (position[e.target] - (kept + 1)) * (int)ENTRY_SIZE;
+
+			if( e.opcode == OP_JMP )
+				e.arg1 = off;
+			else
+				e.arg2 = off;
+		}
+
+		if( e.opcode == OP_JMP && e.arg1 == UNKNOWN_ADDR )
+			result.relocate();
+
+		// inserted entries belong to the previous line
+		if( e.line != 0 && e.line != line )
+		{
+			result.mark(result.size(), e.line);
+			line = e.line;
+		}
+
+		result << OP(e.opcode) << e.arg1 << e.arg2;
+		++kept;
+	}
+
+	entry = position[entry / ENTRY_SIZE] * ENTRY_SIZE;
+
+	for( symboltable::iterator it = scopes[0].begin(); it != scopes[0].end(); ++it )
+		it->second->address = position[it->second->address / ENTRY_SIZE] * ENTRY_SIZE;
+
+	program.swap(result);
+	Invalidate();
+}
+
+size_t Interpreter::Optimize()
+{
+	codelist code;
+
+	if( !Decode(code) || code.empty() )
+		return 0;
+
+	size_t removed = 0;
+	size_t fused = 0;
+	size_t folded = 0;
+	bool changed = true;
+	int i, j, k, n = (int)code.size();
+
+	std::vector<int> roots;
+
+	// functions are folded one by one
+	roots.push_back(entry / ENTRY_SIZE);
+
+	for( symboltable::iterator it = scopes[0].begin(); it != scopes[0].end(); ++it )
+	{
+		if( (size_t)it->second->address / ENTRY_SIZE < (size_t)n )
+			roots.push_back(it->second->address / ENTRY_SIZE);
+	}
+
+	std::sort(roots.begin(), roots.end());
+	roots.erase(std::unique(roots.begin(), roots.end()), roots.end());
+
+#define REMOVE(x) \
+	{ \
+		code[x].removed = true; \
+		if( code[x].barrier && Next_Kept(code, x) < n ) \
+			code[Next_Kept(code, x)].barrier = true; \
+		++removed; \
+		changed = true; \
+	}
+
+	// apply patterns until nothing changes
+	while( changed )
+	{
+		changed = false;
+
+		for( i = Next_Kept(code, 0); i < n; i = Next_Kept(code, i + 1) )
+		{
+			code_entry& e = code[i];
+
+			j = Next_Kept(code, i + 1);
+			k = (j < n ? Next_Kept(code, j + 1) : n);
+
+			// mov reg, reg
+			if( e.opcode == OP_MOV_RR && e.arg1 == e.arg2 )
+			{
+				REMOVE(i);
+				continue;
+			}
+
+			// result that nobody reads (typically after folding a branch)
+			if( (e.opcode == OP_MOV_RS || e.opcode == OP_MOV_RR || e.opcode == OP_MOV_RM) &&
+				Is_General(e.arg1) && Is_Dead(code, i + 1, e.arg1) )
+			{
+				REMOVE(i);
+				continue;
+			}
+
+			// jump to the next instruction
+			if( (e.opcode == OP_JMP || e.opcode == OP_JZ || e.opcode == OP_JNZ) &&
+				e.target >= 0 && Next_Kept(code, e.target) == j && !Is_Fused(code, i) )
+			{
+				REMOVE(i);
+				continue;
+			}
+
+			// setcc reg + jz reg (the jz stays, so barriers don't matter)
+			if( j < n && Is_Relation(e.opcode) && code[j].opcode == OP_JZ && code[j].arg1 == e.arg1 )
+			{
+				e.opcode = FUSED_JZ(e.opcode);
+
+				++fused;
+				changed = true;
+
+				continue;
+			}
+
+			if( j >= n || code[j].barrier )
+				continue;
+
+			code_entry& f = code[j];
+
+			// push reg1 + pop reg2
+			if( e.opcode == OP_PUSH && f.opcode == OP_POP &&
+				e.arg1 != ESP && e.arg1 != EIP && f.arg1 != ESP && f.arg1 != EIP )
+			{
+				if( e.arg1 == f.arg1 )
+				{
+					REMOVE(i);
+				}
+				else
+				{
+					e.opcode = OP_MOV_RR;
+					e.arg2 = e.arg1;
+					e.arg1 = f.arg1;
+				}
+
+				REMOVE(j);
+				continue;
+			}
+
+			// mov reg, imm + mov [mem], reg
+			if( e.opcode == OP_MOV_RS && f.opcode == OP_MOV_MR && f.arg2 == e.arg1 &&
+				Is_General(e.arg1) && Is_Dead(code, j + 1, e.arg1) )
+			{
+				e.opcode = OP_MOV_MS;
+				e.arg1 = f.arg1;
+
+				REMOVE(j);
+				continue;
+			}
+
+			// mov reg, imm + mov vreg, reg
+			if( e.opcode == OP_MOV_RS && f.opcode == OP_MOV_RR && f.arg2 == e.arg1 &&
+				f.arg1 >= FIRST_VREG && Is_General(e.arg1) && Is_Dead(code, j + 1, e.arg1) )
+			{
+				e.arg1 = f.arg1;
+
+				REMOVE(j);
+				continue;
+			}
+
+			// mov reg, vreg + print reg
+			if( e.opcode == OP_MOV_RR && (f.opcode == OP_PRINT_R || f.opcode == OP_PRINT_F) && f.arg1 == e.arg1 &&
+				e.arg2 >= FIRST_VREG && Is_General(e.arg1) && Is_Dead(code, j + 1, e.arg1) )
+			{
+				e.opcode = f.opcode;
+				e.arg1 = e.arg2;
+				e.arg2 = f.arg2;
+
+				REMOVE(j);
+				continue;
+			}
+
+			if( k >= n || code[k].barrier || !Is_General(e.arg1) )
+				continue;
+
+			// mov reg, [mem] + add/sub reg, imm + mov [mem], reg
+			if( e.opcode == OP_MOV_RM &&
+				(f.opcode == OP_ADD_RS || f.opcode == OP_SUB_RS) && f.arg1 == e.arg1 &&
+				code[k].opcode == OP_MOV_MR && code[k].arg1 == e.arg2 && code[k].arg2 == e.arg1 &&
+				Is_Dead(code, k + 1, e.arg1) )
+			{
+				e.opcode = OP_ADD_MS;
+				e.arg1 = e.arg2;
+				e.arg2 = (f.opcode == OP_ADD_RS ? f.arg2 : -f.arg2);
+
+				REMOVE(j);
+				REMOVE(k);
+				continue;
+			}
+
+			// mov reg, vreg + add/sub reg, imm + mov vreg, reg
+			if( e.opcode == OP_MOV_RR && e.arg2 >= FIRST_VREG &&
+				(f.opcode == OP_ADD_RS || f.opcode == OP_SUB_RS) && f.arg1 == e.arg1 &&
+				code[k].opcode == OP_MOV_RR && code[k].arg1 == e.arg2 && code[k].arg2 == e.arg1 &&
+				Is_Dead(code, k + 1, e.arg1) )
+			{
+				e.opcode = f.opcode;
+				e.arg1 = e.arg2;
+				e.arg2 = f.arg2;
+
+				REMOVE(j);
+				REMOVE(k);
+				continue;
+			}
+		}
+
+		// propagate constants, then throw away what became unreachable
+		size_t count = 0;
+
+		for( size_t r = 0; r < roots.size(); ++r )
+		{
+			int start = (r == 0 ? 0 : roots[r]);
+			int end = (r + 1 < roots.size() ? roots[r + 1] : n);
+
+			count += Fold_Constants(code, start, end, (int)numregisters);
+		}
+
+		size_t unreachable = Remove_Unreachable(code, roots);
+
+		if( count > 0 || unreachable > 0 )
+		{
+			removed += unreachable;
+			folded += count;
+			changed = true;
+		}
+	}
+
+#undef REMOVE
+
+	Encode(code);
+
+	std::cout << "Peephole: " << removed << " instructions removed, " << fused << " fused, " << folded << " constants folded\n";
+	return removed;
+}
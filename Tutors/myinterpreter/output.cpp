@@ -0,0 +1,162 @@
+#include "output.h"
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+
+#define MAX_NUMBER_LENGTH	32
+
+OutputSink::OutputSink()
+{
+	buffer = (char*)malloc(OUTPUT_BUFFER_SIZE);
+	size = 0;
+	capacity = OUTPUT_BUFFER_SIZE;
+	target = Output_Console;
+	file = 0;
+}
+
+OutputSink::~OutputSink()
+{
+	Flush();
+
+	if( file )
+		fclose(file);
+
+	free(buffer);
+}
+
+bool OutputSink::RedirectToFile(const std::string& path)
+{
+	FILE* newfile = fopen(path.c_str(), "wb");
+
+	if( !newfile )
+		return false;
+
+	Flush();
+
+	if( file )
+		fclose(file);
+
+	file = newfile;
+	target = Output_File;
+
+	return true;
+}
+
+void OutputSink::RedirectToMemory()
+{
+	Flush();
+
+	if( file )
+	{
+		fclose(file);
+		file = 0;
+	}
+
+	target = Output_Memory;
+}
+
+void OutputSink::RedirectToConsole()
+{
+	Flush();
+
+	if( file )
+	{
+		fclose(file);
+		file = 0;
+	}
+
+	target = Output_Console;
+}
+
+void OutputSink::Resize(size_t newcapacity)
+{
+	Flush();
+
+	capacity = (newcapacity > MAX_NUMBER_LENGTH ? newcapacity : MAX_NUMBER_LENGTH);
+	buffer = (char*)realloc(buffer, capacity);
+}
+
+void OutputSink::Write_Target(const char* data, size_t length)
+{
+	if( target == Output_File )
+		fwrite(data, 1, length, file);
+	else if( target == Output_Memory )
+		memory.append(data, length);
+	else
+		std::cout.write(data, length);
+}
+
+void OutputSink::Write(const char* data, size_t length)
+{
+	if( size + length > capacity )
+	{
+		Flush();
+
+		// doesn't fit anyway, bypass the buffer
+		if( length > capacity )
+		{
+			Write_Target(data, length);
+			return;
+		}
+	}
+
+	memcpy(buffer + size, data, length);
+	size += length;
+}
+
+void OutputSink::Write(const std::string& str)
+{
+	Write(str.data(), str.length());
+}
+
+void OutputSink::Write(int value)
+{
+	// digits backwards from the end of a small buffer
+	char digits[MAX_NUMBER_LENGTH];
+	char* end = digits + MAX_NUMBER_LENGTH;
+	char* ptr = end;
+
+	// negating INT_MIN overflows, but not as unsigned
+	unsigned int absval = (value < 0 ? 0u - (unsigned int)value : (unsigned int)value);
+
+	do
+	{
+		*(--ptr) = (char)('0' + absval % 10);
+		absval /= 10;
+	}
+	while( absval > 0 );
+
+	if( value < 0 )
+		*(--ptr) = '-';
+
+	Write(ptr, end - ptr);
+}
+
+void OutputSink::Write(float value)
+{
+	// same format as the default for std::ostream
+	char digits[MAX_NUMBER_LENGTH];
+#ifdef _MSC_VER
+	int length = sprintf_s(digits, MAX_NUMBER_LENGTH, "%g", value);
+#else
+	int length = snprintf(digits, MAX_NUMBER_LENGTH, "%g", value);
+#endif
+
+	if( length > 0 )
+		Write(digits, length);
+}
+
+void OutputSink::Flush()
+{
+	if( size > 0 )
+	{
+		Write_Target(buffer, size);
+		size = 0;
+	}
+
+	if( target == Output_File )
+		fflush(file);
+	else if( target == Output_Console )
+		std::cout.flush();
+}
@@ -0,0 +1,57 @@
+#ifndef _OUTPUT_H_
+#define _OUTPUT_H_
+
+#include <cstdio>
+#include <string>
+
+#define OUTPUT_BUFFER_SIZE	65536
+
+enum output_target
+{
+	Output_Console = 0,
+	Output_File,
+	Output_Memory
+};
+
+// NOTE: print statements only fill the buffer; it is written out when full,
+// at the end of a run, or before an error message
+class OutputSink
+{
+private:
+	char*			buffer;
+	size_t			size;
+	size_t			capacity;
+	output_target	target;
+	FILE*			file;
+	std::string		memory;
+
+	void Write_Target(const char* data, size_t length);
+
+	OutputSink(const OutputSink&);
+	OutputSink& operator =(const OutputSink&);
+
+public:
+	OutputSink();
+	~OutputSink();
+
+	bool RedirectToFile(const std::string& path);
+	void RedirectToMemory();
+	void RedirectToConsole();
+	void Resize(size_t newcapacity);
+
+	void Write(const char* data, size_t length);
+	void Write(const std::string& str);
+	void Write(int value);
+	void Write(float value);
+	void Flush();
+
+	inline const std::string& Captured() const {
+		return memory;
+	}
+
+	inline void ClearCaptured() {
+		memory.clear();
+	}
+};
+
+#endif
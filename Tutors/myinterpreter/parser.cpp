@@ -1,23 +1,22 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* A Bison parser, made by GNU Bison 2.4.1.  */
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -28,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -42,17 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.4.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 1
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -60,15 +63,11 @@
 /* Pull parsers.  */
 #define YYPULL 1
 
-/* Using locations.  */
-#define YYLSP_NEEDED 1
-
 
 
-/* Copy the first part of user declarations.  */
 
-/* Line 189 of yacc.c  */
-#line 3 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+/* First part of user prologue.  */
+#line 7 "parser.y"
 
 
 #include "interpreter.h"
@@ -83,11 +82,6 @@
 #   pragma warning(disable : 4996)
 #endif
 
-int yylex();
-void yyerror(const char *s);
-
-Interpreter* interpreter = 0;
-
 extern std::string tostring(
     int value);
 
@@ -97,158 +91,213 @@ extern std::string& replace(
     const std::string& with,
     const std::string& instr);
 
+#line 95 "parser.cpp"
 
-/* Line 189 of yacc.c  */
-#line 103 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.cpp"
-
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
-#endif
-
-
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     QUOTE = 258,
-     LRB = 259,
-     RRB = 260,
-     LB = 261,
-     RB = 262,
-     LSB = 263,
-     RSB = 264,
-     SEMICOLON = 265,
-     COMMA = 266,
-     EQ = 267,
-     PEQ = 268,
-     MEQ = 269,
-     SEQ = 270,
-     DEQ = 271,
-     OEQ = 272,
-     OR = 273,
-     AND = 274,
-     NOT = 275,
-     ISEQU = 276,
-     NOTEQU = 277,
-     LT = 278,
-     LE = 279,
-     GT = 280,
-     GE = 281,
-     PLUS = 282,
-     MINUS = 283,
-     STAR = 284,
-     DIV = 285,
-     MOD = 286,
-     INC = 287,
-     DEC = 288,
-     INT = 289,
-     VOID = 290,
-     PRINT = 291,
-     IF = 292,
-     ELSE = 293,
-     WHILE = 294,
-     RETURN = 295,
-     NUMBER = 296,
-     IDENTIFIER = 297,
-     STRING = 298
-   };
-#endif
-
-
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+#include "parser.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_QUOTE = 3,                      /* QUOTE  */
+  YYSYMBOL_LRB = 4,                        /* LRB  */
+  YYSYMBOL_RRB = 5,                        /* RRB  */
+  YYSYMBOL_LB = 6,                         /* LB  */
+  YYSYMBOL_RB = 7,                         /* RB  */
+  YYSYMBOL_LSB = 8,                        /* LSB  */
+  YYSYMBOL_RSB = 9,                        /* RSB  */
+  YYSYMBOL_SEMICOLON = 10,                 /* SEMICOLON  */
+  YYSYMBOL_COMMA = 11,                     /* COMMA  */
+  YYSYMBOL_EQ = 12,                        /* EQ  */
+  YYSYMBOL_PEQ = 13,                       /* PEQ  */
+  YYSYMBOL_MEQ = 14,                       /* MEQ  */
+  YYSYMBOL_SEQ = 15,                       /* SEQ  */
+  YYSYMBOL_DEQ = 16,                       /* DEQ  */
+  YYSYMBOL_OEQ = 17,                       /* OEQ  */
+  YYSYMBOL_OR = 18,                        /* OR  */
+  YYSYMBOL_AND = 19,                       /* AND  */
+  YYSYMBOL_NOT = 20,                       /* NOT  */
+  YYSYMBOL_ISEQU = 21,                     /* ISEQU  */
+  YYSYMBOL_NOTEQU = 22,                    /* NOTEQU  */
+  YYSYMBOL_LT = 23,                        /* LT  */
+  YYSYMBOL_LE = 24,                        /* LE  */
+  YYSYMBOL_GT = 25,                        /* GT  */
+  YYSYMBOL_GE = 26,                        /* GE  */
+  YYSYMBOL_PLUS = 27,                      /* PLUS  */
+  YYSYMBOL_MINUS = 28,                     /* MINUS  */
+  YYSYMBOL_STAR = 29,                      /* STAR  */
+  YYSYMBOL_DIV = 30,                       /* DIV  */
+  YYSYMBOL_MOD = 31,                       /* MOD  */
+  YYSYMBOL_INC = 32,                       /* INC  */
+  YYSYMBOL_DEC = 33,                       /* DEC  */
+  YYSYMBOL_INT = 34,                       /* INT  */
+  YYSYMBOL_FLOAT = 35,                     /* FLOAT  */
+  YYSYMBOL_VOID = 36,                      /* VOID  */
+  YYSYMBOL_PRINT = 37,                     /* PRINT  */
+  YYSYMBOL_IF = 38,                        /* IF  */
+  YYSYMBOL_ELSE = 39,                      /* ELSE  */
+  YYSYMBOL_WHILE = 40,                     /* WHILE  */
+  YYSYMBOL_RETURN = 41,                    /* RETURN  */
+  YYSYMBOL_NUMBER = 42,                    /* NUMBER  */
+  YYSYMBOL_REAL = 43,                      /* REAL  */
+  YYSYMBOL_IDENTIFIER = 44,                /* IDENTIFIER  */
+  YYSYMBOL_STRING = 45,                    /* STRING  */
+  YYSYMBOL_YYACCEPT = 46,                  /* $accept  */
+  YYSYMBOL_program = 47,                   /* program  */
+  YYSYMBOL_function_list = 48,             /* function_list  */
+  YYSYMBOL_function = 49,                  /* function  */
+  YYSYMBOL_function_header = 50,           /* function_header  */
+  YYSYMBOL_argument_list = 51,             /* argument_list  */
+  YYSYMBOL_argument = 52,                  /* argument  */
+  YYSYMBOL_statement_block = 53,           /* statement_block  */
+  YYSYMBOL_statement = 54,                 /* statement  */
+  YYSYMBOL_control_block = 55,             /* control_block  */
+  YYSYMBOL_conditional = 56,               /* conditional  */
+  YYSYMBOL_while_loop = 57,                /* while_loop  */
+  YYSYMBOL_scope = 58,                     /* scope  */
+  YYSYMBOL_scope_start = 59,               /* scope_start  */
+  YYSYMBOL_print = 60,                     /* print  */
+  YYSYMBOL_declaration = 61,               /* declaration  */
+  YYSYMBOL_init_declarator_list = 62,      /* init_declarator_list  */
+  YYSYMBOL_init_declarator = 63,           /* init_declarator  */
+  YYSYMBOL_expr = 64,                      /* expr  */
+  YYSYMBOL_assignment = 65,                /* assignment  */
+  YYSYMBOL_or_level_expr = 66,             /* or_level_expr  */
+  YYSYMBOL_and_level_expr = 67,            /* and_level_expr  */
+  YYSYMBOL_compare_expr = 68,              /* compare_expr  */
+  YYSYMBOL_relative_expr = 69,             /* relative_expr  */
+  YYSYMBOL_additive_expr = 70,             /* additive_expr  */
+  YYSYMBOL_multiplicative_expr = 71,       /* multiplicative_expr  */
+  YYSYMBOL_unary_expr = 72,                /* unary_expr  */
+  YYSYMBOL_lvalue = 73,                    /* lvalue  */
+  YYSYMBOL_term = 74,                      /* term  */
+  YYSYMBOL_func_call = 75,                 /* func_call  */
+  YYSYMBOL_expression_list = 76,           /* expression_list  */
+  YYSYMBOL_literal = 77,                   /* literal  */
+  YYSYMBOL_variable = 78,                  /* variable  */
+  YYSYMBOL_typename = 79,                  /* typename  */
+  YYSYMBOL_string = 80                     /* string  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-/* Line 214 of yacc.c  */
-#line 33 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
 
-    std::string*      text_t;
-    symbol_desc*      symbol_t;
-    symbollist*       symbollist_t;
-    statement_desc*   stat_t;
-    statlist*         statlist_t;
-    declaration_desc* decl_t;
-    decllist*         decllist_t;
-    expression_desc*  expr_t;
-    exprlist*         exprlist_t;
-    symbol_type       type_t;
+/* Second part of user prologue.  */
+#line 45 "parser.y"
 
+int yylex(YYSTYPE* lvalp, YYLTYPE* llocp, void* scanner);
+void yyerror(YYLTYPE* llocp, Interpreter* interpreter, void* scanner, const char* s);
 
+#line 214 "parser.cpp"
 
-/* Line 214 of yacc.c  */
-#line 197 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.cpp"
-} YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
-#endif
 
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE
-{
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
-} YYLTYPE;
-# define yyltype YYLTYPE /* obsolescent; will be withdrawn */
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
+#ifdef short
+# undef short
 #endif
 
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-/* Copy the second part of user declarations.  */
-
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
-/* Line 264 of yacc.c  */
-#line 222 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.cpp"
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef short
-# undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned char yytype_uint8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
-#else
-typedef short int yytype_int8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -256,55 +305,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
-# if YYENABLE_NLS
+# if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int yyi)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (yyi)
-    int yyi;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return yyi;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
 #endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -321,11 +421,11 @@ YYID (yyi)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -333,8 +433,8 @@ YYID (yyi)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -348,113 +448,120 @@ YYID (yyi)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
-	     && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
+             && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
   YYLTYPE yyls_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE) + sizeof (YYLTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
       + 2 * YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  8
+#define YYFINAL  9
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   132
+#define YYLAST   139
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  44
+#define YYNTOKENS  46
 /* YYNNTS -- Number of nonterminals.  */
 #define YYNNTS  35
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  74
-/* YYNRULES -- Number of states.  */
-#define YYNSTATES  125
+#define YYNRULES  76
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  127
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   300
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   298
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -485,334 +592,272 @@ static const yytype_uint8 yytranslate[] =
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
       15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
       25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,    40,    41,    42,    43
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint8 yyprhs[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,     0,     3,     5,     7,    10,    13,    18,    24,    26,
-      30,    33,    34,    38,    41,    43,    45,    47,    49,    52,
-      54,    56,    62,    70,    76,    80,    82,    85,    88,    91,
-      93,    97,    99,   103,   105,   107,   111,   113,   117,   119,
-     123,   125,   129,   133,   135,   139,   143,   147,   151,   153,
-     157,   161,   163,   167,   171,   175,   177,   180,   183,   186,
-     189,   192,   194,   198,   200,   202,   204,   209,   213,   215,
-     219,   221,   223,   225,   227
+       0,   124,   124,   143,   148,   155,   215,   242,   294,   299,
+     306,   319,   323,   334,   346,   351,   356,   366,   384,   422,
+     426,   432,   483,   564,   633,   664,   673,   684,   713,   787,
+     794,   803,   812,   824,   831,   835,   865,   869,   875,   879,
+     885,   889,   893,   899,   903,   907,   911,   915,   921,   925,
+     929,   935,   939,   943,   947,   953,   957,   964,   971,   975,
+     982,   991,  1001,  1006,  1011,  1020,  1081,  1097,  1115,  1120,
+    1127,  1139,  1154,  1181,  1186,  1191,  1198
 };
+#endif
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      45,     0,    -1,    46,    -1,    47,    -1,    46,    47,    -1,
-      48,    56,    -1,    77,    42,     4,     5,    -1,    77,    42,
-       4,    49,     5,    -1,    50,    -1,    49,    11,    50,    -1,
-      77,    42,    -1,    -1,    51,    52,    10,    -1,    51,    53,
-      -1,    58,    -1,    59,    -1,    62,    -1,    40,    -1,    40,
-      62,    -1,    54,    -1,    55,    -1,    37,     4,    62,     5,
-      56,    -1,    37,     4,    62,     5,    56,    38,    56,    -1,
-      39,     4,    62,     5,    56,    -1,    57,    51,     7,    -1,
-       6,    -1,    36,    78,    -1,    36,    62,    -1,    77,    60,
-      -1,    61,    -1,    60,    11,    61,    -1,    42,    -1,    42,
-      12,    62,    -1,    63,    -1,    64,    -1,    71,    12,    63,
-      -1,    65,    -1,    64,    18,    65,    -1,    66,    -1,    65,
-      19,    66,    -1,    67,    -1,    66,    21,    67,    -1,    66,
-      22,    67,    -1,    68,    -1,    67,    23,    68,    -1,    67,
-      24,    68,    -1,    67,    25,    68,    -1,    67,    26,    68,
-      -1,    69,    -1,    68,    27,    69,    -1,    68,    28,    69,
-      -1,    70,    -1,    69,    29,    70,    -1,    69,    30,    70,
-      -1,    69,    31,    70,    -1,    72,    -1,    32,    72,    -1,
-      33,    72,    -1,    27,    72,    -1,    28,    72,    -1,    20,
-      72,    -1,    76,    -1,     4,    62,     5,    -1,    75,    -1,
-      76,    -1,    73,    -1,    42,     4,    74,     5,    -1,    42,
-       4,     5,    -1,    62,    -1,    74,    11,    62,    -1,    41,
-      -1,    42,    -1,    34,    -1,    35,    -1,     3,    43,     3,
-      -1
-};
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
-{
-       0,   118,   118,   137,   142,   149,   208,   235,   285,   290,
-     297,   310,   314,   321,   330,   335,   340,   350,   368,   405,
-     409,   415,   467,   555,   599,   630,   636,   643,   665,   739,
-     746,   755,   764,   776,   783,   787,   818,   822,   828,   832,
-     838,   842,   846,   852,   856,   860,   864,   868,   874,   878,
-     882,   888,   892,   896,   900,   906,   910,   917,   924,   928,
-     935,   944,   953,   958,   963,   972,  1027,  1043,  1061,  1066,
-    1073,  1087,  1114,  1119,  1126
-};
-#endif
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "QUOTE", "LRB", "RRB", "LB", "RB", "LSB",
-  "RSB", "SEMICOLON", "COMMA", "EQ", "PEQ", "MEQ", "SEQ", "DEQ", "OEQ",
-  "OR", "AND", "NOT", "ISEQU", "NOTEQU", "LT", "LE", "GT", "GE", "PLUS",
-  "MINUS", "STAR", "DIV", "MOD", "INC", "DEC", "INT", "VOID", "PRINT",
-  "IF", "ELSE", "WHILE", "RETURN", "NUMBER", "IDENTIFIER", "STRING",
-  "$accept", "program", "function_list", "function", "function_header",
-  "argument_list", "argument", "statement_block", "statement",
-  "control_block", "conditional", "while_loop", "scope", "scope_start",
-  "print", "declaration", "init_declarator_list", "init_declarator",
-  "expr", "assignment", "or_level_expr", "and_level_expr", "compare_expr",
-  "relative_expr", "additive_expr", "multiplicative_expr", "unary_expr",
-  "lvalue", "term", "func_call", "expression_list", "literal", "variable",
-  "typename", "string", 0
+  "\"end of file\"", "error", "\"invalid token\"", "QUOTE", "LRB", "RRB",
+  "LB", "RB", "LSB", "RSB", "SEMICOLON", "COMMA", "EQ", "PEQ", "MEQ",
+  "SEQ", "DEQ", "OEQ", "OR", "AND", "NOT", "ISEQU", "NOTEQU", "LT", "LE",
+  "GT", "GE", "PLUS", "MINUS", "STAR", "DIV", "MOD", "INC", "DEC", "INT",
+  "FLOAT", "VOID", "PRINT", "IF", "ELSE", "WHILE", "RETURN", "NUMBER",
+  "REAL", "IDENTIFIER", "STRING", "$accept", "program", "function_list",
+  "function", "function_header", "argument_list", "argument",
+  "statement_block", "statement", "control_block", "conditional",
+  "while_loop", "scope", "scope_start", "print", "declaration",
+  "init_declarator_list", "init_declarator", "expr", "assignment",
+  "or_level_expr", "and_level_expr", "compare_expr", "relative_expr",
+  "additive_expr", "multiplicative_expr", "unary_expr", "lvalue", "term",
+  "func_call", "expression_list", "literal", "variable", "typename",
+  "string", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-107)
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-62)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int8 yypact[] =
 {
-       0,    44,    45,    46,    46,    47,    48,    48,    49,    49,
-      50,    51,    51,    51,    52,    52,    52,    52,    52,    53,
-      53,    54,    54,    55,    56,    57,    58,    58,    59,    60,
-      60,    61,    61,    62,    63,    63,    64,    64,    65,    65,
-      66,    66,    66,    67,    67,    67,    67,    67,    68,    68,
-      68,    69,    69,    69,    69,    70,    70,    70,    70,    70,
-      70,    71,    72,    72,    72,    72,    73,    73,    74,    74,
-      75,    76,    77,    77,    78
+      -9,  -107,  -107,  -107,    15,    -9,  -107,    16,   -26,  -107,
+    -107,  -107,  -107,  -107,    31,    46,    25,     1,  -107,    -3,
+      -3,    -3,    -3,    -3,     4,    34,    38,     1,  -107,  -107,
+      45,    47,  -107,  -107,  -107,  -107,  -107,  -107,  -107,    67,
+      97,    54,    39,    40,    41,  -107,   105,  -107,  -107,  -107,
+     106,    77,  -107,     9,  -107,    78,   118,  -107,  -107,  -107,
+    -107,  -107,  -107,    79,  -107,  -107,     1,     1,  -107,    87,
+    -107,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,   113,   115,  -107,  -107,    -9,
+    -107,  -107,   124,   123,   127,  -107,  -107,    12,    97,    54,
+      39,    39,    40,    40,    40,    40,    41,    41,  -107,  -107,
+    -107,  -107,     1,    77,  -107,  -107,    16,    16,  -107,     1,
+    -107,  -107,    94,  -107,  -107,    16,  -107
 };
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
-       0,     2,     1,     1,     2,     2,     4,     5,     1,     3,
-       2,     0,     3,     2,     1,     1,     1,     1,     2,     1,
-       1,     5,     7,     5,     3,     1,     2,     2,     2,     1,
-       3,     1,     3,     1,     1,     3,     1,     3,     1,     3,
-       1,     3,     3,     1,     3,     3,     3,     3,     1,     3,
-       3,     1,     3,     3,     3,     1,     2,     2,     2,     2,
-       2,     1,     3,     1,     1,     1,     4,     3,     1,     3,
-       1,     1,     1,     1,     3
+       0,    73,    74,    75,     0,     2,     3,     0,     0,     1,
+       4,    25,     5,    11,     0,     0,     0,     0,    24,     0,
+       0,     0,     0,     0,     0,     0,     0,    17,    70,    71,
+      72,     0,    13,    19,    20,    14,    15,    16,    33,    34,
+      36,    38,    40,    43,    48,    51,     0,    55,    65,    63,
+      64,     0,     6,     0,     8,     0,     0,    60,    64,    58,
+      59,    56,    57,     0,    27,    26,     0,     0,    18,     0,
+      12,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    31,    28,    29,     7,     0,
+      10,    62,     0,     0,     0,    67,    68,     0,    37,    39,
+      41,    42,    44,    45,    46,    47,    49,    50,    52,    53,
+      54,    35,     0,     0,     9,    76,     0,     0,    66,     0,
+      32,    30,    21,    23,    69,     0,    22
 };
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
 {
-       0,    72,    73,     0,     2,     3,     0,     0,     1,     4,
-      25,     5,    11,     0,     0,     0,     0,    24,     0,     0,
-       0,     0,     0,     0,     0,     0,    17,    70,    71,     0,
-      13,    19,    20,    14,    15,    16,    33,    34,    36,    38,
-      40,    43,    48,    51,     0,    55,    65,    63,    64,     0,
-       6,     0,     8,     0,     0,    60,    64,    58,    59,    56,
-      57,     0,    27,    26,     0,     0,    18,     0,    12,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,    31,    28,    29,     7,     0,    10,    62,
-       0,     0,     0,    67,    68,     0,    37,    39,    41,    42,
-      44,    45,    46,    47,    49,    50,    52,    53,    54,    35,
-       0,     0,     9,    74,     0,     0,    66,     0,    32,    30,
-      21,    23,    69,     0,    22
+    -107,  -107,  -107,   129,  -107,  -107,    48,  -107,  -107,  -107,
+    -107,  -107,  -106,  -107,  -107,  -107,  -107,    22,   -11,    52,
+    -107,    68,    66,    29,    18,    26,    17,  -107,    90,  -107,
+    -107,  -107,   -15,   -12,  -107
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     3,     4,     5,     6,    51,    52,    14,    29,    30,
-      31,    32,    11,    12,    33,    34,    84,    85,    35,    36,
-      37,    38,    39,    40,    41,    42,    43,    44,    45,    46,
-      95,    47,    56,     7,    63
+       0,     4,     5,     6,     7,    53,    54,    15,    31,    32,
+      33,    34,    12,    13,    35,    36,    86,    87,    37,    38,
+      39,    40,    41,    42,    43,    44,    45,    46,    47,    48,
+      97,    49,    58,     8,    65
 };
 
-/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-   STATE-NUM.  */
-#define YYPACT_NINF -101
-static const yytype_int8 yypact[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
 {
-     -17,  -101,  -101,    20,   -17,  -101,    -5,   -20,  -101,  -101,
-    -101,  -101,  -101,    26,    45,    24,    84,  -101,     1,     1,
-       1,     1,     1,     4,    31,    52,    84,  -101,    79,    34,
-    -101,  -101,  -101,  -101,  -101,  -101,  -101,    10,    74,    19,
-      66,    39,    40,  -101,    89,  -101,  -101,  -101,    90,    63,
-    -101,    14,  -101,    64,   103,  -101,  -101,  -101,  -101,  -101,
-    -101,    67,  -101,  -101,    84,    84,  -101,     6,  -101,    84,
-      84,    84,    84,    84,    84,    84,    84,    84,    84,    84,
-      84,    84,    84,    97,   102,  -101,  -101,   -17,  -101,  -101,
-     111,   110,   113,  -101,  -101,    16,    74,    19,    66,    66,
-      39,    39,    39,    39,    40,    40,  -101,  -101,  -101,  -101,
-      84,    63,  -101,  -101,    -5,    -5,  -101,    84,  -101,  -101,
-      85,  -101,  -101,    -5,  -101
+      50,    17,    50,    51,    55,    17,    56,    63,    17,    50,
+     122,   123,    50,    64,    88,     9,    68,   118,    14,   126,
+      89,    19,    11,   119,    19,     1,     2,     3,    20,    21,
+      52,    20,    21,    22,    23,    16,    22,    23,    66,    28,
+      29,    30,    67,    28,    29,    30,    28,    29,    30,    69,
+      17,    50,    50,    18,    50,    93,    94,    70,    96,     1,
+       2,     3,    75,    76,    77,    78,    19,    79,    80,    50,
+      81,    82,    83,    20,    21,    73,    74,    55,    22,    23,
+       1,     2,     3,    24,    25,    71,    26,    27,    28,    29,
+      30,    17,    95,   102,   103,   104,   105,    50,   108,   109,
+     110,   120,   100,   101,    50,   106,   107,    19,   124,    57,
+      59,    60,    61,    62,    20,    21,    72,    84,   -61,    22,
+      23,    85,    90,    91,    92,   112,   113,   115,   116,    28,
+      29,    30,   117,   125,    10,   121,   111,   114,    99,    98
 };
 
-/* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] =
+static const yytype_int8 yycheck[] =
 {
-    -101,  -101,  -101,   120,  -101,  -101,    41,  -101,  -101,  -101,
-    -101,  -101,  -100,  -101,  -101,  -101,  -101,    21,   -10,    47,
-    -101,    58,    60,     3,    46,    17,    18,  -101,    42,  -101,
-    -101,  -101,   -14,   -11,  -101
+      15,     4,    17,    15,    16,     4,    17,     3,     4,    24,
+     116,   117,    27,    24,     5,     0,    27,     5,    44,   125,
+      11,    20,     6,    11,    20,    34,    35,    36,    27,    28,
+       5,    27,    28,    32,    33,     4,    32,    33,     4,    42,
+      43,    44,     4,    42,    43,    44,    42,    43,    44,     4,
+       4,    66,    67,     7,    69,    66,    67,    10,    69,    34,
+      35,    36,    23,    24,    25,    26,    20,    27,    28,    84,
+      29,    30,    31,    27,    28,    21,    22,    89,    32,    33,
+      34,    35,    36,    37,    38,    18,    40,    41,    42,    43,
+      44,     4,     5,    75,    76,    77,    78,   112,    81,    82,
+      83,   112,    73,    74,   119,    79,    80,    20,   119,    19,
+      20,    21,    22,    23,    27,    28,    19,    12,    12,    32,
+      33,    44,    44,     5,    45,    12,    11,     3,     5,    42,
+      43,    44,     5,    39,     5,   113,    84,    89,    72,    71
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -62
-static const yytype_int8 yytable[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
-      48,    10,    48,    49,    53,    16,    54,    61,    16,    48,
-      16,    93,    48,    62,   120,   121,    66,     1,     2,    86,
-       8,   116,    13,   124,    18,    87,    18,   117,    69,    50,
-      15,    19,    20,    19,    20,    64,    21,    22,    21,    22,
-      71,    72,    27,    28,    68,    27,    28,    27,    28,    16,
-      48,    48,    17,    48,    91,    92,    65,    94,     1,     2,
-      55,    57,    58,    59,    60,    18,    77,    78,    48,    79,
-      80,    81,    19,    20,    98,    99,    53,    21,    22,     1,
-       2,    23,    24,    67,    25,    26,    27,    28,    16,    73,
-      74,    75,    76,    70,   104,   105,    48,   106,   107,   108,
-     118,    82,   -61,    48,    18,    83,    88,   122,    89,   110,
-      90,    19,    20,   111,   113,   114,    21,    22,   115,   100,
-     101,   102,   103,   123,     9,    27,    28,    96,   112,   109,
-      97,     0,   119
+       0,    34,    35,    36,    47,    48,    49,    50,    79,     0,
+      49,     6,    58,    59,    44,    53,     4,     4,     7,    20,
+      27,    28,    32,    33,    37,    38,    40,    41,    42,    43,
+      44,    54,    55,    56,    57,    60,    61,    64,    65,    66,
+      67,    68,    69,    70,    71,    72,    73,    74,    75,    77,
+      78,    79,     5,    51,    52,    79,    64,    74,    78,    74,
+      74,    74,    74,     3,    64,    80,     4,     4,    64,     4,
+      10,    18,    19,    21,    22,    23,    24,    25,    26,    27,
+      28,    29,    30,    31,    12,    44,    62,    63,     5,    11,
+      44,     5,    45,    64,    64,     5,    64,    76,    67,    68,
+      69,    69,    70,    70,    70,    70,    71,    71,    72,    72,
+      72,    65,    12,    11,    52,     3,     5,     5,     5,    11,
+      64,    63,    58,    58,    64,    39,    58
 };
 
-static const yytype_int8 yycheck[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
-      14,     6,    16,    14,    15,     4,    16,     3,     4,    23,
-       4,     5,    26,    23,   114,   115,    26,    34,    35,     5,
-       0,     5,    42,   123,    20,    11,    20,    11,    18,     5,
-       4,    27,    28,    27,    28,     4,    32,    33,    32,    33,
-      21,    22,    41,    42,    10,    41,    42,    41,    42,     4,
-      64,    65,     7,    67,    64,    65,     4,    67,    34,    35,
-      18,    19,    20,    21,    22,    20,    27,    28,    82,    29,
-      30,    31,    27,    28,    71,    72,    87,    32,    33,    34,
-      35,    36,    37,     4,    39,    40,    41,    42,     4,    23,
-      24,    25,    26,    19,    77,    78,   110,    79,    80,    81,
-     110,    12,    12,   117,    20,    42,    42,   117,     5,    12,
-      43,    27,    28,    11,     3,     5,    32,    33,     5,    73,
-      74,    75,    76,    38,     4,    41,    42,    69,    87,    82,
-      70,    -1,   111
+       0,    46,    47,    48,    48,    49,    50,    50,    51,    51,
+      52,    53,    53,    53,    54,    54,    54,    54,    54,    55,
+      55,    56,    56,    57,    58,    59,    60,    60,    61,    62,
+      62,    63,    63,    64,    65,    65,    66,    66,    67,    67,
+      68,    68,    68,    69,    69,    69,    69,    69,    70,    70,
+      70,    71,    71,    71,    71,    72,    72,    72,    72,    72,
+      72,    73,    74,    74,    74,    74,    75,    75,    76,    76,
+      77,    77,    78,    79,    79,    79,    80
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
-       0,    34,    35,    45,    46,    47,    48,    77,     0,    47,
-       6,    56,    57,    42,    51,     4,     4,     7,    20,    27,
-      28,    32,    33,    36,    37,    39,    40,    41,    42,    52,
-      53,    54,    55,    58,    59,    62,    63,    64,    65,    66,
-      67,    68,    69,    70,    71,    72,    73,    75,    76,    77,
-       5,    49,    50,    77,    62,    72,    76,    72,    72,    72,
-      72,     3,    62,    78,     4,     4,    62,     4,    10,    18,
-      19,    21,    22,    23,    24,    25,    26,    27,    28,    29,
-      30,    31,    12,    42,    60,    61,     5,    11,    42,     5,
-      43,    62,    62,     5,    62,    74,    65,    66,    67,    67,
-      68,    68,    68,    68,    69,    69,    70,    70,    70,    63,
-      12,    11,    50,     3,     5,     5,     5,    11,    62,    61,
-      56,    56,    62,    38,    56
+       0,     2,     1,     1,     2,     2,     4,     5,     1,     3,
+       2,     0,     3,     2,     1,     1,     1,     1,     2,     1,
+       1,     5,     7,     5,     3,     1,     2,     2,     2,     1,
+       3,     1,     3,     1,     1,     3,     1,     3,     1,     3,
+       1,     3,     3,     1,     3,     3,     3,     3,     1,     3,
+       3,     1,     3,     3,     3,     1,     2,     2,     2,     2,
+       2,     1,     3,     1,     1,     1,     4,     3,     1,     3,
+       1,     1,     1,     1,     1,     1,     3
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
 
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
+enum { YYENOMEM = -2 };
 
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-#define YYFAIL		goto yyerrlab
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, interpreter, scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
    the previous symbol: RHS[0] (always defined).  */
 
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
 #ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
+          (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
+          (Current).last_line    = YYRHSLOC (Rhs, N).last_line;         \
+          (Current).last_column  = YYRHSLOC (Rhs, N).last_column;       \
+        }                                                               \
+      else                                                              \
+        {                                                               \
+          (Current).first_line   = (Current).last_line   =              \
+            YYRHSLOC (Rhs, 0).last_line;                                \
+          (Current).first_column = (Current).last_column =              \
+            YYRHSLOC (Rhs, 0).last_column;                              \
+        }                                                               \
+    while (0)
 #endif
 
+#define YYRHSLOC(Rhs, K) ((Rhs)[K])
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
-
-#ifndef YY_LOCATION_PRINT
-# if YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
-
-
-/* YYLEX -- calling `yylex' with the right arguments.  */
-
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -822,85 +867,120 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value, Location); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
-#else
-static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    YYLTYPE const * const yylocationp;
-#endif
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
+   This macro was not mandated originally: define only if we know
+   we won't break user code: when these are the locations we know.  */
+
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+
+/* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
+
+YY_ATTRIBUTE_UNUSED
+static int
+yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
 {
-  if (!yyvaluep)
-    return;
-  YYUSE (yylocationp);
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
+  int res = 0;
+  int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
+  if (0 <= yylocp->first_line)
     {
-      default:
-	break;
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
+      if (0 <= yylocp->first_column)
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
     }
+  if (0 <= yylocp->last_line)
+    {
+      if (yylocp->first_line < yylocp->last_line)
+        {
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
+          if (0 <= end_col)
+            res += YYFPRINTF (yyo, ".%d", end_col);
+        }
+      else if (0 <= end_col && yylocp->first_column < end_col)
+        res += YYFPRINTF (yyo, "-%d", end_col);
+    }
+  return res;
 }
 
+#   define YYLOCATION_PRINT  yy_location_print_
+
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location, interpreter, scanner); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
-#else
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, Interpreter* interpreter, void* scanner)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (interpreter);
+  YY_USE (scanner);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
 static void
-yy_symbol_print (yyoutput, yytype, yyvaluep, yylocationp)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    YYLTYPE const * const yylocationp;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, Interpreter* interpreter, void* scanner)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyoutput, *yylocationp);
-  YYFPRINTF (yyoutput, ": ");
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp);
-  YYFPRINTF (yyoutput, ")");
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, interpreter, scanner);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -908,16 +988,8 @@ yy_symbol_print (yyoutput, yytype, yyvaluep, yylocationp)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-#else
 static void
-yy_stack_print (yybottom, yytop)
-    yytype_int16 *yybottom;
-    yytype_int16 *yytop;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -928,64 +1000,57 @@ yy_stack_print (yybottom, yytop)
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_reduce_print (YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
-#else
 static void
-yy_reduce_print (yyvsp, yylsp, yyrule)
-    YYSTYPE *yyvsp;
-    YYLTYPE *yylsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, Interpreter* interpreter, void* scanner)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       , &(yylsp[(yyi + 1) - (yynrhs)])		       );
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), interpreter, scanner);
       YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, yylsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, interpreter, scanner); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -1000,357 +1065,104 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
-
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
 
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
 
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
-    {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
-
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
-
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
-
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
-
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
-    }
-}
-#endif /* YYERROR_VERBOSE */
-
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
-#else
-static void
-yydestruct (yymsg, yytype, yyvaluep, yylocationp)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-    YYLTYPE *yylocationp;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, Interpreter* interpreter, void* scanner)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
-
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (interpreter);
+  YY_USE (scanner);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
-
-  switch (yytype)
-    {
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
-/* Prevent warnings from -Wmissing-prototypes.  */
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
-
 
-/* The lookahead symbol.  */
-int yychar;
 
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
 
-/* Location data for the lookahead symbol.  */
-YYLTYPE yylloc;
 
-/* Number of syntax errors so far.  */
-int yynerrs;
 
+/*----------.
+| yyparse.  |
+`----------*/
 
+int
+yyparse (Interpreter* interpreter, void* scanner)
+{
+/* Lookahead token kind.  */
+int yychar;
 
-/*-------------------------.
-| yyparse or yypush_parse.  |
-`-------------------------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void)
-#else
-int
-yyparse ()
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
-#endif
-#endif
-{
+/* Location data for the lookahead symbol.  */
+static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
 
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
-       `yyls': related to locations.
+    int yyerrstatus = 0;
 
-       Refer to the stacks thru separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[2];
-
-    YYSIZE_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1358,146 +1170,147 @@ yyparse ()
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yytoken = 0;
-  yyss = yyssa;
-  yyvs = yyvsa;
-  yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
 
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-  yyssp = yyss;
-  yyvsp = yyvs;
-  yylsp = yyls;
-
-#if YYLTYPE_IS_TRIVIAL
-  /* Initialize the default location before parsing starts.  */
-  yylloc.first_line   = yylloc.last_line   = 1;
-  yylloc.first_column = yylloc.last_column = 1;
-#endif
-
+  yylsp[0] = yylloc;
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-	YYLTYPE *yyls1 = yyls;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yyls1, yysize * sizeof (*yylsp),
-		    &yystacksize);
-
-	yyls = yyls1;
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss_alloc, yyss);
-	YYSTACK_RELOCATE (yyvs_alloc, yyvs);
-	YYSTACK_RELOCATE (yyls_alloc, yyls);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
       yylsp = yyls + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
   /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, &yylloc, scanner);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1512,8 +1325,8 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
@@ -1525,13 +1338,14 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
   *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1546,14 +1360,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1562,64 +1376,61 @@ yyreduce:
      GCC warning that YYVAL may be used uninitialized.  */
   yyval = yyvsp[1-yylen];
 
-  /* Default location.  */
+  /* Default location. */
   YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-
-/* Line 1455 of yacc.c  */
-#line 119 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 2: /* program: function_list  */
+#line 125 "parser.y"
+         {
              parser_out("program -> function_list");
-             interpreter->entry = -1;
              
-             for( symbollist::iterator it = (yyvsp[(1) - (1)].symbollist_t)->begin(); it != (yyvsp[(1) - (1)].symbollist_t)->end(); ++it )
+             for( symbollist::iterator it = (yyvsp[0].symbollist_t)->begin(); it != (yyvsp[0].symbollist_t)->end(); ++it )
              {
                  if( (*it)->name == "main" )
                      interpreter->entry = interpreter->program.size();
                  
                  (*it)->address = interpreter->program.size();
-                 interpreter->program << (*it)->bytecode;
+                 interpreter->program.splice((*it)->bytecode);
+                 interpreter->functions.push_back(*it);
              }
              
              nassert(0, "Unresolved external 'main'", interpreter->entry == -1);
-             interpreter->Deallocate((yyvsp[(1) - (1)].symbollist_t));
-         ;}
+             interpreter->Deallocate((yyvsp[0].symbollist_t));
+         }
+#line 1404 "parser.cpp"
     break;
 
-  case 3:
-
-/* Line 1455 of yacc.c  */
-#line 138 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 3: /* function_list: function  */
+#line 144 "parser.y"
+               {
                    (yyval.symbollist_t) = interpreter->Allocate<symbollist>();
-                   (yyval.symbollist_t)->push_back((yyvsp[(1) - (1)].symbol_t));
-               ;}
+                   (yyval.symbollist_t)->push_back((yyvsp[0].symbol_t));
+               }
+#line 1413 "parser.cpp"
     break;
 
-  case 4:
-
-/* Line 1455 of yacc.c  */
-#line 143 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                   (yyval.symbollist_t) = (yyvsp[(1) - (2)].symbollist_t);
-                   (yyval.symbollist_t)->push_back((yyvsp[(2) - (2)].symbol_t));
-               ;}
+  case 4: /* function_list: function_list function  */
+#line 149 "parser.y"
+               {
+                   (yyval.symbollist_t) = (yyvsp[-1].symbollist_t);
+                   (yyval.symbollist_t)->push_back((yyvsp[0].symbol_t));
+               }
+#line 1422 "parser.cpp"
     break;
 
-  case 5:
-
-/* Line 1455 of yacc.c  */
-#line 150 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 5: /* function: function_header scope  */
+#line 156 "parser.y"
+          {
               parser_out("function -> function_header scope");
 
               // build code
-              (yyval.symbol_t) = (yyvsp[(1) - (2)].symbol_t);
+              (yyval.symbol_t) = (yyvsp[-1].symbol_t);
+              (yyval.symbol_t)->bytecode.mark(0, (yylsp[-1]).first_line);
               
-              if( (yyvsp[(1) - (2)].symbol_t)->name == "main" )
+              if( (yyvsp[-1].symbol_t)->name == "main" )
               {
                   (yyval.symbol_t)->bytecode << OP(OP_MOV_RS) << REG(EAX) << (int)CODE_SIZE;
                   (yyval.symbol_t)->bytecode << OP(OP_PUSH) << REG(EAX) << NIL;
@@ -1635,27 +1446,27 @@ yyreduce:
               
               bool found = false;
               
-              for( statlist::iterator it = (yyvsp[(2) - (2)].statlist_t)->begin(); it != (yyvsp[(2) - (2)].statlist_t)->end(); ++it )
+              for( statlist::iterator it = (yyvsp[0].statlist_t)->begin(); it != (yyvsp[0].statlist_t)->end(); ++it )
               {
                   if( *it )
                   {
                       if( found )
                       {
-                          warn("In function '" << (yyvsp[(1) - (2)].symbol_t)->name << "': Unreachable code detected");
+                          warn("In function '" << (yyvsp[-1].symbol_t)->name << "': Unreachable code detected");
                           break;
                       }
                           
                       if( (*it)->type == Type_Return && (*it)->scope == 1 )
                           found = true;
                   
-                      (yyval.symbol_t)->bytecode << (*it)->bytecode;
+                      (yyval.symbol_t)->bytecode.splice((*it)->bytecode);
                       interpreter->Deallocate(*it);
                   }
               }
               
-              nassert(0, "In function '" << (yyvsp[(1) - (2)].symbol_t)->name << "': Function must return a value", (yyvsp[(1) - (2)].symbol_t)->type != Type_Unknown && !found);
+              nassert(0, "In function '" << (yyvsp[-1].symbol_t)->name << "': Function must return a value", (yyvsp[-1].symbol_t)->type != Type_Unknown && !found);
               
-              if( (yyvsp[(1) - (2)].symbol_t)->type == Type_Unknown && !found )
+              if( (yyvsp[-1].symbol_t)->type == Type_Unknown && !found )
               {
                   // void function and no return statement
                   (yyval.symbol_t)->bytecode << OP(OP_MOV_RS) << REG(EAX) << (int)0;
@@ -1664,70 +1475,68 @@ yyreduce:
                   (yyval.symbol_t)->bytecode << OP(OP_POP) << REG(EIP) << NIL;
               }
               
-              interpreter->Deallocate((yyvsp[(2) - (2)].statlist_t));
+              interpreter->Deallocate((yyvsp[0].statlist_t));
               interpreter->current_func = 0;
               
               interpreter->alloc_addr = 0;
-          ;}
+          }
+#line 1484 "parser.cpp"
     break;
 
-  case 6:
-
-/* Line 1455 of yacc.c  */
-#line 209 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 6: /* function_header: typename IDENTIFIER LRB RRB  */
+#line 216 "parser.y"
+                 {
                      parser_out("function_header -> typename IDENTIFIER LRB RRB");
                      
-                     if( *(yyvsp[(2) - (4)].text_t) == "main" )
-                         nassert(0, "Function 'main' must return 'int'", (yyvsp[(1) - (4)].type_t) != Type_Integer);
+                     if( *(yyvsp[-2].text_t) == "main" )
+                         nassert(0, "Function 'main' must return 'int'", (yyvsp[-3].type_t) != Type_Integer);
                          
                      // functions are in the global scope
                      symboltable& table0 = interpreter->scopes[0];
                      symboltable::iterator sym;
              
                      // check for redeclaration
-                     sym = table0.find(*(yyvsp[(2) - (4)].text_t));
-                     nassert(0, "Conflicting declaration '" << *(yyvsp[(2) - (4)].text_t) << "'", sym != table0.end());
+                     sym = table0.find(*(yyvsp[-2].text_t));
+                     nassert(0, "Conflicting declaration '" << *(yyvsp[-2].text_t) << "'", sym != table0.end());
               
                      (yyval.symbol_t) = interpreter->Allocate<symbol_desc>();
-                     table0[*(yyvsp[(2) - (4)].text_t)] = (yyval.symbol_t);
+                     table0[*(yyvsp[-2].text_t)] = (yyval.symbol_t);
                  
                      interpreter->current_func = (yyval.symbol_t);
                      
-                     (yyval.symbol_t)->name = *(yyvsp[(2) - (4)].text_t);
-                     (yyval.symbol_t)->type = (yyvsp[(1) - (4)].type_t);
+                     (yyval.symbol_t)->name = *(yyvsp[-2].text_t);
+                     (yyval.symbol_t)->type = (yyvsp[-3].type_t);
                      (yyval.symbol_t)->isfunc = true;
                      (yyval.symbol_t)->address = UNKNOWN_ADDR;
                      
-                     interpreter->Deallocate((yyvsp[(2) - (4)].text_t));
-                 ;}
+                     interpreter->Deallocate((yyvsp[-2].text_t));
+                 }
+#line 1515 "parser.cpp"
     break;
 
-  case 7:
-
-/* Line 1455 of yacc.c  */
-#line 236 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 7: /* function_header: typename IDENTIFIER LRB argument_list RRB  */
+#line 243 "parser.y"
+                 {
                      parser_out("function_header -> typename IDENTIFIER LRB argument_list RRB");
                      
-                     if( *(yyvsp[(2) - (5)].text_t) == "main" )
-                         nassert(0, "Function 'main' must return 'int'", (yyvsp[(1) - (5)].type_t) != Type_Integer);
+                     if( *(yyvsp[-3].text_t) == "main" )
+                         nassert(0, "Function 'main' must return 'int'", (yyvsp[-4].type_t) != Type_Integer);
 
                      // functions are in the global scope
                      symboltable& table0 = interpreter->scopes[0];
                      symboltable::iterator sym;
              
                      // check for redeclaration
-                     sym = table0.find(*(yyvsp[(2) - (5)].text_t));
-                     nassert(0, "Conflicting declaration '" << *(yyvsp[(2) - (5)].text_t) << "'", sym != table0.end());
+                     sym = table0.find(*(yyvsp[-3].text_t));
+                     nassert(0, "Conflicting declaration '" << *(yyvsp[-3].text_t) << "'", sym != table0.end());
               
                      (yyval.symbol_t) = interpreter->Allocate<symbol_desc>();
-                     table0[*(yyvsp[(2) - (5)].text_t)] = (yyval.symbol_t);
+                     table0[*(yyvsp[-3].text_t)] = (yyval.symbol_t);
                  
                      interpreter->current_func = (yyval.symbol_t);
                      
-                     (yyval.symbol_t)->name = *(yyvsp[(2) - (5)].text_t);
-                     (yyval.symbol_t)->type = (yyvsp[(1) - (5)].type_t);
+                     (yyval.symbol_t)->name = *(yyvsp[-3].text_t);
+                     (yyval.symbol_t)->type = (yyvsp[-4].type_t);
                      (yyval.symbol_t)->isfunc = true;
                      (yyval.symbol_t)->address = UNKNOWN_ADDR;
                      
@@ -1738,7 +1547,7 @@ yyreduce:
                      symboltable& table = interpreter->scopes[scope];
                      
                      // register arguments into the function's scope
-                     for( symbollist::iterator it = (yyvsp[(4) - (5)].symbollist_t)->begin(); it != (yyvsp[(4) - (5)].symbollist_t)->end(); ++it )
+                     for( symbollist::iterator it = (yyvsp[-1].symbollist_t)->begin(); it != (yyvsp[-1].symbollist_t)->end(); ++it )
                      {
                          // this shouldn't occur ever, but...
                          sym = table.find((*it)->name);
@@ -1749,122 +1558,121 @@ yyreduce:
                          // update address
                          (*it)->address = addr;
                          addr += 4;
+
+                         (yyval.symbol_t)->params.push_back((*it)->type);
                      }
                      
-                     interpreter->Deallocate((yyvsp[(2) - (5)].text_t));
-                     interpreter->Deallocate((yyvsp[(4) - (5)].symbollist_t));
-                 ;}
+                     interpreter->Deallocate((yyvsp[-3].text_t));
+                     interpreter->Deallocate((yyvsp[-1].symbollist_t));
+                 }
+#line 1569 "parser.cpp"
     break;
 
-  case 8:
-
-/* Line 1455 of yacc.c  */
-#line 286 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 8: /* argument_list: argument  */
+#line 295 "parser.y"
+               {
                    (yyval.symbollist_t) = interpreter->Allocate<symbollist>();
-                   (yyval.symbollist_t)->push_back((yyvsp[(1) - (1)].symbol_t));
-               ;}
+                   (yyval.symbollist_t)->push_back((yyvsp[0].symbol_t));
+               }
+#line 1578 "parser.cpp"
     break;
 
-  case 9:
-
-/* Line 1455 of yacc.c  */
-#line 291 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                   (yyval.symbollist_t) = (yyvsp[(1) - (3)].symbollist_t);
-                   (yyval.symbollist_t)->push_back((yyvsp[(3) - (3)].symbol_t));
-               ;}
+  case 9: /* argument_list: argument_list COMMA argument  */
+#line 300 "parser.y"
+               {
+                   (yyval.symbollist_t) = (yyvsp[-2].symbollist_t);
+                   (yyval.symbollist_t)->push_back((yyvsp[0].symbol_t));
+               }
+#line 1587 "parser.cpp"
     break;
 
-  case 10:
-
-/* Line 1455 of yacc.c  */
-#line 298 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 10: /* argument: typename IDENTIFIER  */
+#line 307 "parser.y"
+          {
               (yyval.symbol_t) = interpreter->Allocate<symbol_desc>();
               
-              (yyval.symbol_t)->name = *(yyvsp[(2) - (2)].text_t);
-              (yyval.symbol_t)->type = (yyvsp[(1) - (2)].type_t);
+              (yyval.symbol_t)->name = *(yyvsp[0].text_t);
+              (yyval.symbol_t)->type = (yyvsp[-1].type_t);
               (yyval.symbol_t)->address = UNKNOWN_ADDR;
               
-              interpreter->Deallocate((yyvsp[(2) - (2)].text_t));
-          ;}
+              interpreter->Deallocate((yyvsp[0].text_t));
+          }
+#line 1601 "parser.cpp"
     break;
 
-  case 11:
-
-/* Line 1455 of yacc.c  */
-#line 310 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 11: /* statement_block: %empty  */
+#line 319 "parser.y"
+                 {
                      parser_out("statement_block -> epsilon");
                      (yyval.statlist_t) = interpreter->Allocate<statlist>();
-                 ;}
+                 }
+#line 1610 "parser.cpp"
     break;
 
-  case 12:
-
-/* Line 1455 of yacc.c  */
-#line 315 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 12: /* statement_block: statement_block statement SEMICOLON  */
+#line 324 "parser.y"
+                 {
                      parser_out("statement_block -> statement_block statement SEMICOLON");
                      
-                     (yyval.statlist_t) = (yyvsp[(1) - (3)].statlist_t);
-                     (yyval.statlist_t)->push_back((yyvsp[(2) - (3)].stat_t));
-                 ;}
-    break;
+                     // for the profiler
+                     if( (yyvsp[-1].stat_t) )
+                         (yyvsp[-1].stat_t)->bytecode.mark(0, (yylsp[-1]).first_line);
 
-  case 13:
+                     (yyval.statlist_t) = (yyvsp[-2].statlist_t);
+                     (yyval.statlist_t)->push_back((yyvsp[-1].stat_t));
+                 }
+#line 1625 "parser.cpp"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 322 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 13: /* statement_block: statement_block control_block  */
+#line 335 "parser.y"
+                 {
                      parser_out("statement_block -> statement_block control_block");
                      
-                     (yyval.statlist_t) = (yyvsp[(1) - (2)].statlist_t);
-                     (yyval.statlist_t)->push_back((yyvsp[(2) - (2)].stat_t));
-                 ;}
-    break;
+                     if( (yyvsp[0].stat_t) )
+                         (yyvsp[0].stat_t)->bytecode.mark(0, (yylsp[0]).first_line);
 
-  case 14:
+                     (yyval.statlist_t) = (yyvsp[-1].statlist_t);
+                     (yyval.statlist_t)->push_back((yyvsp[0].stat_t));
+                 }
+#line 1639 "parser.cpp"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 331 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 14: /* statement: print  */
+#line 347 "parser.y"
+           {
                parser_out("statement -> print");
-               (yyval.stat_t) = (yyvsp[(1) - (1)].stat_t);
-           ;}
+               (yyval.stat_t) = (yyvsp[0].stat_t);
+           }
+#line 1648 "parser.cpp"
     break;
 
-  case 15:
-
-/* Line 1455 of yacc.c  */
-#line 336 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 15: /* statement: declaration  */
+#line 352 "parser.y"
+           {
                parser_out("statement -> declaration");
-               (yyval.stat_t) = (yyvsp[(1) - (1)].stat_t);
-           ;}
+               (yyval.stat_t) = (yyvsp[0].stat_t);
+           }
+#line 1657 "parser.cpp"
     break;
 
-  case 16:
-
-/* Line 1455 of yacc.c  */
-#line 341 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 16: /* statement: expr  */
+#line 357 "parser.y"
+           {
                // even if it has no sense, like (5 + 3);
                parser_out("statement -> expr");
                
                (yyval.stat_t) = interpreter->Allocate<statement_desc>();
-               (yyval.stat_t)->bytecode << (yyvsp[(1) - (1)].expr_t)->bytecode;
+               (yyval.stat_t)->bytecode.splice((yyvsp[0].expr_t)->bytecode);
                
-               interpreter->Deallocate((yyvsp[(1) - (1)].expr_t));
-           ;}
+               interpreter->Deallocate((yyvsp[0].expr_t));
+           }
+#line 1671 "parser.cpp"
     break;
 
-  case 17:
-
-/* Line 1455 of yacc.c  */
-#line 351 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 17: /* statement: RETURN  */
+#line 367 "parser.y"
+           {
                parser_out("statement -> RETURN");
                symbol_desc* func = interpreter->current_func;
                
@@ -1880,19 +1688,20 @@ yyreduce:
                (yyval.stat_t)->bytecode << OP(OP_MOV_RR) << REG(ESP) << REG(EBP);
                (yyval.stat_t)->bytecode << OP(OP_POP) << REG(EBP) << NIL;
                (yyval.stat_t)->bytecode << OP(OP_POP) << REG(EIP) << NIL;
-           ;}
+           }
+#line 1693 "parser.cpp"
     break;
 
-  case 18:
-
-/* Line 1455 of yacc.c  */
-#line 369 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 18: /* statement: RETURN expr  */
+#line 385 "parser.y"
+           {
                parser_out("statement -> RETURN expr");
                symbol_desc* func = interpreter->current_func;
                
+               interpreter->Convert((yyvsp[0].expr_t), func->type);
+
                nassert(0, "In function '" << func->name <<
-                   "': Invalid return type", func->type != (yyvsp[(2) - (2)].expr_t)->type);
+                   "': Invalid return type", func->type != (yyvsp[0].expr_t)->type);
 
                // mov the result into EAX and return
                (yyval.stat_t) = interpreter->Allocate<statement_desc>();
@@ -1900,81 +1709,76 @@ yyreduce:
                (yyval.stat_t)->type = Type_Return;
                (yyval.stat_t)->scope = interpreter->current_scope;
                
-               if( (yyvsp[(2) - (2)].expr_t)->constexpr )
+               if( (yyvsp[0].expr_t)->constexpr )
                {
-                   int val = atoi((yyvsp[(2) - (2)].expr_t)->value.c_str());
-                   (yyval.stat_t)->bytecode << OP(OP_MOV_RS) << REG(EAX) << val;
+                   (yyval.stat_t)->bytecode << OP(OP_MOV_RS) << REG(EAX) << (yyvsp[0].expr_t)->value;
                }
-               else if( (yyvsp[(2) - (2)].expr_t)->address == UNKNOWN_ADDR )
+               else if( (yyvsp[0].expr_t)->address == UNKNOWN_ADDR )
                {
-                   (yyval.stat_t)->bytecode << (yyvsp[(2) - (2)].expr_t)->bytecode;
+                   (yyval.stat_t)->bytecode.splice((yyvsp[0].expr_t)->bytecode);
                }
                else
                {
-                   (yyval.stat_t)->bytecode << (yyvsp[(2) - (2)].expr_t)->bytecode;
-                   (yyval.stat_t)->bytecode << OP(OP_MOV_RM) << REG(EAX) << (yyvsp[(2) - (2)].expr_t)->address;
+                   (yyval.stat_t)->bytecode.splice((yyvsp[0].expr_t)->bytecode);
+                   (yyval.stat_t)->bytecode << OP(OP_MOV_RM) << REG(EAX) << (yyvsp[0].expr_t)->address;
                }
                
                (yyval.stat_t)->bytecode << OP(OP_MOV_RR) << REG(ESP) << REG(EBP);
                (yyval.stat_t)->bytecode << OP(OP_POP) << REG(EBP) << NIL;
                (yyval.stat_t)->bytecode << OP(OP_POP) << REG(EIP) << NIL;
 
-               interpreter->Deallocate((yyvsp[(2) - (2)].expr_t));
-           ;}
+               interpreter->Deallocate((yyvsp[0].expr_t));
+           }
+#line 1733 "parser.cpp"
     break;
 
-  case 19:
-
-/* Line 1455 of yacc.c  */
-#line 406 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                   (yyval.stat_t) = (yyvsp[(1) - (1)].stat_t);
-               ;}
+  case 19: /* control_block: conditional  */
+#line 423 "parser.y"
+               {
+                   (yyval.stat_t) = (yyvsp[0].stat_t);
+               }
+#line 1741 "parser.cpp"
     break;
 
-  case 20:
-
-/* Line 1455 of yacc.c  */
-#line 410 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                   (yyval.stat_t) = (yyvsp[(1) - (1)].stat_t);
-               ;}
+  case 20: /* control_block: while_loop  */
+#line 427 "parser.y"
+               {
+                   (yyval.stat_t) = (yyvsp[0].stat_t);
+               }
+#line 1749 "parser.cpp"
     break;
 
-  case 21:
-
-/* Line 1455 of yacc.c  */
-#line 416 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 21: /* conditional: IF LRB expr RRB scope  */
+#line 433 "parser.y"
+             {
                  (yyval.stat_t) = interpreter->Allocate<statement_desc>();
+                 interpreter->Condition((yyvsp[-2].expr_t));
                  
-                 if( (yyvsp[(3) - (5)].expr_t)->constexpr )
+                 if( (yyvsp[-2].expr_t)->constexpr )
                  {
-                     int val = atoi((yyvsp[(3) - (5)].expr_t)->value.c_str());
-                     
-                     if( val != 0 )
+                     // the branch is either compiled or dropped
+                     for( statlist::iterator it = (yyvsp[0].statlist_t)->begin(); it != (yyvsp[0].statlist_t)->end(); ++it )
                      {
-                         for( statlist::iterator it = (yyvsp[(5) - (5)].statlist_t)->begin(); it != (yyvsp[(5) - (5)].statlist_t)->end(); ++it )
-						 {
-							 if( *it )
-							 {
-								 (yyval.stat_t)->bytecode << (*it)->bytecode;
-								 interpreter->Deallocate(*it);
-							 }
-						 }
+                         if( *it )
+                         {
+                             if( (yyvsp[-2].expr_t)->value != 0 )
+                                 (yyval.stat_t)->bytecode.splice((*it)->bytecode);
+
+                             interpreter->Deallocate(*it);
+                         }
                      }
                  }
                  else
                  {
-                     (yyval.stat_t)->bytecode << (yyvsp[(3) - (5)].expr_t)->bytecode;
+                     (yyval.stat_t)->bytecode.splice((yyvsp[-2].expr_t)->bytecode);
                      
-					 if( (yyvsp[(3) - (5)].expr_t)->address != UNKNOWN_ADDR )
-						 (yyval.stat_t)->bytecode << OP(OP_MOV_RM) << OP(EAX) << (yyvsp[(3) - (5)].expr_t)->address;
+					 if( (yyvsp[-2].expr_t)->address != UNKNOWN_ADDR )
+						 (yyval.stat_t)->bytecode << OP(OP_MOV_RM) << REG(EAX) << (yyvsp[-2].expr_t)->address;
 	                 
 					 int off = 0;
 	                 
 					 // calculate offset
-					 for( statlist::iterator it = (yyvsp[(5) - (5)].statlist_t)->begin(); it != (yyvsp[(5) - (5)].statlist_t)->end(); ++it )
+					 for( statlist::iterator it = (yyvsp[0].statlist_t)->begin(); it != (yyvsp[0].statlist_t)->end(); ++it )
 					 {
 						 if( *it )
 							 off += (int)(*it)->bytecode.size();
@@ -1983,75 +1787,67 @@ yyreduce:
 					 (yyval.stat_t)->bytecode << OP(OP_JZ) << REG(EAX) << off;
 	                 
 					 // apply true branch
-					 for( statlist::iterator it = (yyvsp[(5) - (5)].statlist_t)->begin(); it != (yyvsp[(5) - (5)].statlist_t)->end(); ++it )
+					 for( statlist::iterator it = (yyvsp[0].statlist_t)->begin(); it != (yyvsp[0].statlist_t)->end(); ++it )
 					 {
 						 if( *it )
 						 {
-							 (yyval.stat_t)->bytecode << (*it)->bytecode;
+							 (yyval.stat_t)->bytecode.splice((*it)->bytecode);
 							 interpreter->Deallocate(*it);
 						 }
 					 }
 			     }
                  
-                 interpreter->Deallocate((yyvsp[(3) - (5)].expr_t));
-                 interpreter->Deallocate((yyvsp[(5) - (5)].statlist_t));
-             ;}
+                 interpreter->Deallocate((yyvsp[-2].expr_t));
+                 interpreter->Deallocate((yyvsp[0].statlist_t));
+             }
+#line 1804 "parser.cpp"
     break;
 
-  case 22:
-
-/* Line 1455 of yacc.c  */
-#line 468 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 22: /* conditional: IF LRB expr RRB scope ELSE scope  */
+#line 484 "parser.y"
+             {
                  (yyval.stat_t) = interpreter->Allocate<statement_desc>();
+                 interpreter->Condition((yyvsp[-4].expr_t));
                  
-                 if( (yyvsp[(3) - (7)].expr_t)->constexpr )
+                 if( (yyvsp[-4].expr_t)->constexpr )
                  {
-                     int val = atoi((yyvsp[(3) - (7)].expr_t)->value.c_str());
-                     
-                     if( val != 0 )
+                     // only one of the branches is compiled
+                     statlist* taken = ((yyvsp[-4].expr_t)->value != 0 ? (yyvsp[-2].statlist_t) : (yyvsp[0].statlist_t));
+                     statlist* dead = ((yyvsp[-4].expr_t)->value != 0 ? (yyvsp[0].statlist_t) : (yyvsp[-2].statlist_t));
+
+                     for( statlist::iterator it = taken->begin(); it != taken->end(); ++it )
                      {
-                         // apply true branch
-                         for( statlist::iterator it = (yyvsp[(5) - (7)].statlist_t)->begin(); it != (yyvsp[(5) - (7)].statlist_t)->end(); ++it )
-						 {
-							 if( *it )
-							 {
-								 (yyval.stat_t)->bytecode << (*it)->bytecode;
-								 interpreter->Deallocate(*it);
-							 }
-						 }
+                         if( *it )
+                         {
+                             (yyval.stat_t)->bytecode.splice((*it)->bytecode);
+                             interpreter->Deallocate(*it);
+                         }
                      }
-                     else
+
+                     for( statlist::iterator it = dead->begin(); it != dead->end(); ++it )
                      {
-                         // apply false branch
-						 for( statlist::iterator it = (yyvsp[(7) - (7)].statlist_t)->begin(); it != (yyvsp[(7) - (7)].statlist_t)->end(); ++it )
-						 {
-							 if( *it )
-							 {
-								 (yyval.stat_t)->bytecode << (*it)->bytecode;
-								 interpreter->Deallocate(*it);
-							 }
-						 }
+                         if( *it )
+                             interpreter->Deallocate(*it);
                      }
                  }
                  else
                  {
-					 (yyval.stat_t)->bytecode << (yyvsp[(3) - (7)].expr_t)->bytecode;
+					 (yyval.stat_t)->bytecode.splice((yyvsp[-4].expr_t)->bytecode);
 	                 
-					 if( (yyvsp[(3) - (7)].expr_t)->address != UNKNOWN_ADDR )
-						 (yyval.stat_t)->bytecode << OP(OP_MOV_RM) << OP(EAX) << (yyvsp[(3) - (7)].expr_t)->address;
+					 if( (yyvsp[-4].expr_t)->address != UNKNOWN_ADDR )
+						 (yyval.stat_t)->bytecode << OP(OP_MOV_RM) << REG(EAX) << (yyvsp[-4].expr_t)->address;
 	                 
 					 int off1 = 0;
 					 int off2 = 0;
 	                 
 					 // calculate offset
-					 for( statlist::iterator it = (yyvsp[(5) - (7)].statlist_t)->begin(); it != (yyvsp[(5) - (7)].statlist_t)->end(); ++it )
+					 for( statlist::iterator it = (yyvsp[-2].statlist_t)->begin(); it != (yyvsp[-2].statlist_t)->end(); ++it )
 					 {
 						 if( *it )
 							 off1 += (int)(*it)->bytecode.size();
 					 }
 	                 
-					 for( statlist::iterator it = (yyvsp[(7) - (7)].statlist_t)->begin(); it != (yyvsp[(7) - (7)].statlist_t)->end(); ++it )
+					 for( statlist::iterator it = (yyvsp[0].statlist_t)->begin(); it != (yyvsp[0].statlist_t)->end(); ++it )
 					 {
 						 if( *it )
 							 off2 += (int)(*it)->bytecode.size();
@@ -2061,11 +1857,11 @@ yyreduce:
 					 (yyval.stat_t)->bytecode << OP(OP_JZ) << REG(EAX) << (int)(off1 + ENTRY_SIZE);
 	                 
 					 // apply true branch
-					 for( statlist::iterator it = (yyvsp[(5) - (7)].statlist_t)->begin(); it != (yyvsp[(5) - (7)].statlist_t)->end(); ++it )
+					 for( statlist::iterator it = (yyvsp[-2].statlist_t)->begin(); it != (yyvsp[-2].statlist_t)->end(); ++it )
 					 {
 						 if( *it )
 						 {
-							 (yyval.stat_t)->bytecode << (*it)->bytecode;
+							 (yyval.stat_t)->bytecode.splice((*it)->bytecode);
 							 interpreter->Deallocate(*it);
 						 }
 					 }
@@ -2073,75 +1869,98 @@ yyreduce:
 					 (yyval.stat_t)->bytecode << OP(OP_JMP) << off2 << NIL;
 	                 
 					 // apply false branch
-					 for( statlist::iterator it = (yyvsp[(7) - (7)].statlist_t)->begin(); it != (yyvsp[(7) - (7)].statlist_t)->end(); ++it )
+					 for( statlist::iterator it = (yyvsp[0].statlist_t)->begin(); it != (yyvsp[0].statlist_t)->end(); ++it )
 					 {
 						 if( *it )
 						 {
-							 (yyval.stat_t)->bytecode << (*it)->bytecode;
+							 (yyval.stat_t)->bytecode.splice((*it)->bytecode);
 							 interpreter->Deallocate(*it);
 						 }
 					 }
 				 }
                                   
-                 interpreter->Deallocate((yyvsp[(3) - (7)].expr_t));
-                 interpreter->Deallocate((yyvsp[(5) - (7)].statlist_t));
-                 interpreter->Deallocate((yyvsp[(7) - (7)].statlist_t));
-             ;}
+                 interpreter->Deallocate((yyvsp[-4].expr_t));
+                 interpreter->Deallocate((yyvsp[-2].statlist_t));
+                 interpreter->Deallocate((yyvsp[0].statlist_t));
+             }
+#line 1887 "parser.cpp"
     break;
 
-  case 23:
-
-/* Line 1455 of yacc.c  */
-#line 556 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 23: /* while_loop: WHILE LRB expr RRB scope  */
+#line 565 "parser.y"
+            {
                 (yyval.stat_t) = interpreter->Allocate<statement_desc>();
-                (yyval.stat_t)->bytecode << (yyvsp[(3) - (5)].expr_t)->bytecode;
-                
-                nassert(0, "Break statement not yet supported", (yyvsp[(3) - (5)].expr_t)->constexpr);
-                
-                int off = 0;
-                int loop = (yyvsp[(3) - (5)].expr_t)->bytecode.size();
-                
-                if( (yyvsp[(3) - (5)].expr_t)->address != UNKNOWN_ADDR )
-                {
-                    (yyval.stat_t)->bytecode << OP(OP_MOV_RM) << OP(EAX) << (yyvsp[(3) - (5)].expr_t)->address;
-                    loop += ENTRY_SIZE;
-                }
-                 
-                // calculate offset
-                for( statlist::iterator it = (yyvsp[(5) - (5)].statlist_t)->begin(); it != (yyvsp[(5) - (5)].statlist_t)->end(); ++it )
+                interpreter->Condition((yyvsp[-2].expr_t));
+
+                if( (yyvsp[-2].expr_t)->constexpr )
                 {
-                    if( *it )
-                        off += (int)(*it)->bytecode.size();
+                    // while( 0 ) is dropped, anything else loops until a return
+                    int off = 0;
+
+                    for( statlist::iterator it = (yyvsp[0].statlist_t)->begin(); it != (yyvsp[0].statlist_t)->end(); ++it )
+                    {
+                        if( *it )
+                        {
+                            if( (yyvsp[-2].expr_t)->value != 0 )
+                            {
+                                off += (int)(*it)->bytecode.size();
+                                (yyval.stat_t)->bytecode.splice((*it)->bytecode);
+                            }
+
+                            interpreter->Deallocate(*it);
+                        }
+                    }
+
+                    if( (yyvsp[-2].expr_t)->value != 0 )
+                        (yyval.stat_t)->bytecode << OP(OP_JMP) << (int)-(off + (int)ENTRY_SIZE) << NIL;
                 }
-                
-                (yyval.stat_t)->bytecode << OP(OP_JZ) << REG(EAX) << (int)(off + ENTRY_SIZE);
-                
-                // jz and jmp
-                loop += (off + 2 * ENTRY_SIZE);
-                 
-                for( statlist::iterator it = (yyvsp[(5) - (5)].statlist_t)->begin(); it != (yyvsp[(5) - (5)].statlist_t)->end(); ++it )
+                else
                 {
-                    if( *it )
+                    (yyval.stat_t)->bytecode.splice((yyvsp[-2].expr_t)->bytecode);
+
+                    int off = 0;
+                    int loop = (yyval.stat_t)->bytecode.size();
+
+                    if( (yyvsp[-2].expr_t)->address != UNKNOWN_ADDR )
+                    {
+                        (yyval.stat_t)->bytecode << OP(OP_MOV_RM) << REG(EAX) << (yyvsp[-2].expr_t)->address;
+                        loop += ENTRY_SIZE;
+                    }
+
+                    // calculate offset
+                    for( statlist::iterator it = (yyvsp[0].statlist_t)->begin(); it != (yyvsp[0].statlist_t)->end(); ++it )
+                    {
+                        if( *it )
+                            off += (int)(*it)->bytecode.size();
+                    }
+
+                    (yyval.stat_t)->bytecode << OP(OP_JZ) << REG(EAX) << (int)(off + ENTRY_SIZE);
+
+                    // jz and jmp
+                    loop += (off + 2 * ENTRY_SIZE);
+
+                    for( statlist::iterator it = (yyvsp[0].statlist_t)->begin(); it != (yyvsp[0].statlist_t)->end(); ++it )
                     {
-                        (yyval.stat_t)->bytecode << (*it)->bytecode;
-                        interpreter->Deallocate(*it);
+                        if( *it )
+                        {
+                            (yyval.stat_t)->bytecode.splice((*it)->bytecode);
+                            interpreter->Deallocate(*it);
+                        }
                     }
+
+                    (yyval.stat_t)->bytecode << OP(OP_JMP) << -loop << NIL;
                 }
-                
-                (yyval.stat_t)->bytecode << OP(OP_JMP) << -loop << NIL;
-                
-                interpreter->Deallocate((yyvsp[(3) - (5)].expr_t));
-                interpreter->Deallocate((yyvsp[(5) - (5)].statlist_t));
-            ;}
-    break;
 
-  case 24:
+                interpreter->Deallocate((yyvsp[-2].expr_t));
+                interpreter->Deallocate((yyvsp[0].statlist_t));
+            }
+#line 1958 "parser.cpp"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 600 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-           (yyval.statlist_t) = (yyvsp[(2) - (3)].statlist_t);
+  case 24: /* scope: scope_start statement_block RB  */
+#line 634 "parser.y"
+       {
+           (yyval.statlist_t) = (yyvsp[-1].statlist_t);
            
            // end of scope, deallocate locals
            int s = interpreter->current_scope;
@@ -2167,60 +1986,70 @@ yyreduce:
            }
            
            --interpreter->current_scope;
-       ;}
+       }
+#line 1991 "parser.cpp"
     break;
 
-  case 25:
-
-/* Line 1455 of yacc.c  */
-#line 631 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 25: /* scope_start: LB  */
+#line 665 "parser.y"
+             {
                  ++interpreter->current_scope;
-             ;}
+                 
+                 if( interpreter->current_scope >= interpreter->scopes.size() )
+                     interpreter->scopes.resize(interpreter->current_scope + 1);
+             }
+#line 2002 "parser.cpp"
     break;
 
-  case 26:
-
-/* Line 1455 of yacc.c  */
-#line 637 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 26: /* print: PRINT string  */
+#line 674 "parser.y"
+       {
            parser_out("print -> PRINT string");
            
            (yyval.stat_t) = interpreter->Allocate<statement_desc>();
-           (yyval.stat_t)->bytecode << OP(OP_PRINT_M) << ADDR((yyvsp[(2) - (2)].text_t)) << REG(0);
-       ;}
+           (yyval.stat_t)->bytecode << OP(OP_PRINT_M) << (int)interpreter->strings.size() << REG(0);
+           
+           // code refers to strings by index
+           interpreter->strings.push_back(*(yyvsp[0].text_t));
+           interpreter->Deallocate((yyvsp[0].text_t));
+       }
+#line 2017 "parser.cpp"
     break;
 
-  case 27:
-
-/* Line 1455 of yacc.c  */
-#line 644 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 27: /* print: PRINT expr  */
+#line 685 "parser.y"
+       {
            parser_out("print -> PRINT expr");
            (yyval.stat_t) = interpreter->Allocate<statement_desc>();
            
-           if( (yyvsp[(2) - (2)].expr_t)->address == UNKNOWN_ADDR )
+           unsigned char op = ((yyvsp[0].expr_t)->type == Type_Float ? OP_PRINT_F : OP_PRINT_R);
+           
+           if( (yyvsp[0].expr_t)->constexpr )
+           {
+               (yyval.stat_t)->bytecode << OP(OP_MOV_RS) << REG(EAX) << (yyvsp[0].expr_t)->value;
+               (yyval.stat_t)->bytecode << OP(op) << REG(EAX) << REG(0);
+           }
+           else if( (yyvsp[0].expr_t)->address == UNKNOWN_ADDR )
            {
                // result of an expression in EAX
-               (yyval.stat_t)->bytecode << (yyvsp[(2) - (2)].expr_t)->bytecode << OP(OP_PRINT_R) << REG(EAX) << REG(0);
+               (yyval.stat_t)->bytecode.splice((yyvsp[0].expr_t)->bytecode) << OP(op) << REG(EAX) << REG(0);
            }
            else
            {
                // variable on the stack
-               (yyval.stat_t)->bytecode << (yyvsp[(2) - (2)].expr_t)->bytecode;
-               (yyval.stat_t)->bytecode << OP(OP_MOV_RM) << REG(EAX) << (yyvsp[(2) - (2)].expr_t)->address;
-               (yyval.stat_t)->bytecode << OP(OP_PRINT_R) << REG(EAX) << REG(0);
+               (yyval.stat_t)->bytecode.splice((yyvsp[0].expr_t)->bytecode);
+               (yyval.stat_t)->bytecode << OP(OP_MOV_RM) << REG(EAX) << (yyvsp[0].expr_t)->address;
+               (yyval.stat_t)->bytecode << OP(op) << REG(EAX) << REG(0);
            }
            
-           interpreter->Deallocate((yyvsp[(2) - (2)].expr_t));
-       ;}
+           interpreter->Deallocate((yyvsp[0].expr_t));
+       }
+#line 2048 "parser.cpp"
     break;
 
-  case 28:
-
-/* Line 1455 of yacc.c  */
-#line 666 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 28: /* declaration: typename init_declarator_list  */
+#line 714 "parser.y"
+             {
                  parser_out("declaration -> typename init_declarator_list");
                  
                  int scope = interpreter->current_scope;
@@ -2234,28 +2063,28 @@ yyreduce:
                  (yyval.stat_t) = interpreter->Allocate<statement_desc>();
                  
                  // look for entries in current scope
-                 for( decllist::iterator it = (yyvsp[(2) - (2)].decllist_t)->begin(); it != (yyvsp[(2) - (2)].decllist_t)->end(); ++it )
+                 for( decllist::iterator it = (yyvsp[0].decllist_t)->begin(); it != (yyvsp[0].decllist_t)->end(); ++it )
                  {
                      sym = table.find((*it)->name);
                      nassert(0, "Conflicting declaration '" << (*it)->name << "'", sym != table.end());
                      
                      // save this variable
                      var = interpreter->Allocate<symbol_desc>();
-                     var->type = (yyvsp[(1) - (2)].type_t);
+                     var->type = (yyvsp[-1].type_t);
                      
                      table[(*it)->name] = var;
                      
                      // update address
-                     interpreter->alloc_addr += interpreter->Sizeof((yyvsp[(1) - (2)].type_t));
+                     interpreter->alloc_addr += interpreter->Sizeof((yyvsp[-1].type_t));
                      var->address = -interpreter->alloc_addr;
                      
                      // extend size
-                     size += interpreter->Sizeof((yyvsp[(1) - (2)].type_t));
+                     size += interpreter->Sizeof((yyvsp[-1].type_t));
                  }
                  
                  (yyval.stat_t)->bytecode << OP(OP_SUB_RS) << REG(ESP) << size;
                  
-                 for( decllist::iterator it = (yyvsp[(2) - (2)].decllist_t)->begin(); it != (yyvsp[(2) - (2)].decllist_t)->end(); ++it )
+                 for( decllist::iterator it = (yyvsp[0].decllist_t)->begin(); it != (yyvsp[0].decllist_t)->end(); ++it )
                  {
                      sym = table.find((*it)->name);
                      var = sym->second;
@@ -2263,22 +2092,22 @@ yyreduce:
 
                      if( expr )
                      {
+                         interpreter->Convert(expr, var->type);
+
                          if( expr->constexpr )
                          {
-                             int a = atoi(expr->value.c_str());
-
-                             (yyval.stat_t)->bytecode << OP(OP_MOV_RS) << REG(EAX) << a;
-                             (yyval.stat_t)->bytecode << expr->bytecode << OP(OP_MOV_MR) << var->address << REG(EAX);
+                             (yyval.stat_t)->bytecode << OP(OP_MOV_RS) << REG(EAX) << expr->value;
+                             (yyval.stat_t)->bytecode.splice(expr->bytecode) << OP(OP_MOV_MR) << var->address << REG(EAX);
                          }
                          else if( expr->address == UNKNOWN_ADDR )
                          {
                              // result of an expression in EAX
-                             (yyval.stat_t)->bytecode << expr->bytecode << OP(OP_MOV_MR) << var->address << REG(EAX);
+                             (yyval.stat_t)->bytecode.splice(expr->bytecode) << OP(OP_MOV_MR) << var->address << REG(EAX);
                          }
                          else
                          {
                              // variable on the stack
-                             (yyval.stat_t)->bytecode << expr->bytecode;
+                             (yyval.stat_t)->bytecode.splice(expr->bytecode);
                              (yyval.stat_t)->bytecode << OP(OP_MOV_RM) << REG(EAX) << expr->address;
                              (yyval.stat_t)->bytecode << OP(OP_MOV_MR) << var->address << REG(EAX);
                          }
@@ -2289,433 +2118,400 @@ yyreduce:
                      interpreter->Deallocate(*it);
                  }
                  
-                 interpreter->Deallocate((yyvsp[(2) - (2)].decllist_t));
-             ;}
+                 interpreter->Deallocate((yyvsp[0].decllist_t));
+             }
+#line 2124 "parser.cpp"
     break;
 
-  case 29:
-
-/* Line 1455 of yacc.c  */
-#line 740 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 29: /* init_declarator_list: init_declarator  */
+#line 788 "parser.y"
+                      {
                           parser_out("init_declarator_list -> init_declarator");
                           
                           (yyval.decllist_t) = interpreter->Allocate<decllist>();
-                          (yyval.decllist_t)->push_back((yyvsp[(1) - (1)].decl_t));
-                      ;}
+                          (yyval.decllist_t)->push_back((yyvsp[0].decl_t));
+                      }
+#line 2135 "parser.cpp"
     break;
 
-  case 30:
-
-/* Line 1455 of yacc.c  */
-#line 747 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 30: /* init_declarator_list: init_declarator_list COMMA init_declarator  */
+#line 795 "parser.y"
+                      {
                           parser_out("init_declarator_list -> init_declarator_list COMMA init_declarator");
                           
-                          (yyval.decllist_t) = (yyvsp[(1) - (3)].decllist_t);
-                          (yyval.decllist_t)->push_back((yyvsp[(3) - (3)].decl_t));
-                      ;}
+                          (yyval.decllist_t) = (yyvsp[-2].decllist_t);
+                          (yyval.decllist_t)->push_back((yyvsp[0].decl_t));
+                      }
+#line 2146 "parser.cpp"
     break;
 
-  case 31:
-
-/* Line 1455 of yacc.c  */
-#line 756 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 31: /* init_declarator: IDENTIFIER  */
+#line 804 "parser.y"
+                 {
                      parser_out("init_declarator -> IDENTIFIER");
                      
                      (yyval.decl_t) = interpreter->Allocate<declaration_desc>();
-                     (yyval.decl_t)->name = *(yyvsp[(1) - (1)].text_t);
+                     (yyval.decl_t)->name = *(yyvsp[0].text_t);
 
-                     interpreter->Deallocate((yyvsp[(1) - (1)].text_t));
-                 ;}
+                     interpreter->Deallocate((yyvsp[0].text_t));
+                 }
+#line 2159 "parser.cpp"
     break;
 
-  case 32:
-
-/* Line 1455 of yacc.c  */
-#line 765 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 32: /* init_declarator: IDENTIFIER EQ expr  */
+#line 813 "parser.y"
+                 {
                      parser_out("init_declarator -> IDENTIFIER EQ expr");
                      
                      (yyval.decl_t) = interpreter->Allocate<declaration_desc>();
-                     (yyval.decl_t)->name = *(yyvsp[(1) - (3)].text_t);
-                     (yyval.decl_t)->expr = (yyvsp[(3) - (3)].expr_t);
+                     (yyval.decl_t)->name = *(yyvsp[-2].text_t);
+                     (yyval.decl_t)->expr = (yyvsp[0].expr_t);
 
-                     interpreter->Deallocate((yyvsp[(1) - (3)].text_t));
-                 ;}
+                     interpreter->Deallocate((yyvsp[-2].text_t));
+                 }
+#line 2173 "parser.cpp"
     break;
 
-  case 33:
-
-/* Line 1455 of yacc.c  */
-#line 777 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 33: /* expr: assignment  */
+#line 825 "parser.y"
+      {
           parser_out("expr -> assignment");
-          (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
-      ;}
+          (yyval.expr_t) = (yyvsp[0].expr_t);
+      }
+#line 2182 "parser.cpp"
     break;
 
-  case 34:
-
-/* Line 1455 of yacc.c  */
-#line 784 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
-            ;}
+  case 34: /* assignment: or_level_expr  */
+#line 832 "parser.y"
+            {
+                (yyval.expr_t) = (yyvsp[0].expr_t);
+            }
+#line 2190 "parser.cpp"
     break;
 
-  case 35:
-
-/* Line 1455 of yacc.c  */
-#line 788 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 35: /* assignment: lvalue EQ assignment  */
+#line 836 "parser.y"
+            {
                 parser_out("assignment -> lvalue = assignment");
 
-                assert(0, "assignment -> lvalue = assignment: NULL == $1", (yyvsp[(1) - (3)].expr_t));
-                assert(0, "assignment -> lvalue = assignment: NULL == $3", (yyvsp[(3) - (3)].expr_t));
+                assert(0, "assignment -> lvalue = assignment: NULL == $1", (yyvsp[-2].expr_t));
+                assert(0, "assignment -> lvalue = assignment: NULL == $3", (yyvsp[0].expr_t));
 
-                (yyval.expr_t) = (yyvsp[(1) - (3)].expr_t);
+                (yyval.expr_t) = (yyvsp[-2].expr_t);
+                interpreter->Convert((yyvsp[0].expr_t), (yyvsp[-2].expr_t)->type);
 
-                if( (yyvsp[(3) - (3)].expr_t)->constexpr )
+                if( (yyvsp[0].expr_t)->constexpr )
                 {
-                    int a = atoi((yyvsp[(3) - (3)].expr_t)->value.c_str());
-
-                    (yyval.expr_t)->bytecode << OP(OP_MOV_RS) << REG(EAX) << a;
-                    (yyval.expr_t)->bytecode << (yyvsp[(3) - (3)].expr_t)->bytecode << OP(OP_MOV_MR) << (yyvsp[(1) - (3)].expr_t)->address << REG(EAX);
+                    (yyval.expr_t)->bytecode << OP(OP_MOV_RS) << REG(EAX) << (yyvsp[0].expr_t)->value;
+                    (yyval.expr_t)->bytecode.splice((yyvsp[0].expr_t)->bytecode) << OP(OP_MOV_MR) << (yyvsp[-2].expr_t)->address << REG(EAX);
                 }
-                else if( (yyvsp[(3) - (3)].expr_t)->address == UNKNOWN_ADDR )
+                else if( (yyvsp[0].expr_t)->address == UNKNOWN_ADDR )
                 {
                     // result of an expression in EAX
-                    (yyval.expr_t)->bytecode << (yyvsp[(3) - (3)].expr_t)->bytecode << OP(OP_MOV_MR) << (yyvsp[(1) - (3)].expr_t)->address << REG(EAX);
+                    (yyval.expr_t)->bytecode.splice((yyvsp[0].expr_t)->bytecode) << OP(OP_MOV_MR) << (yyvsp[-2].expr_t)->address << REG(EAX);
                 }
                 else
                 {
                     // variable on the stack
-                    (yyval.expr_t)->bytecode << (yyvsp[(3) - (3)].expr_t)->bytecode << OP(OP_MOV_MM) << (yyvsp[(1) - (3)].expr_t)->address << (yyvsp[(3) - (3)].expr_t)->address;
+                    (yyval.expr_t)->bytecode.splice((yyvsp[0].expr_t)->bytecode) << OP(OP_MOV_MM) << (yyvsp[-2].expr_t)->address << (yyvsp[0].expr_t)->address;
                 }
                 
-                interpreter->Deallocate((yyvsp[(3) - (3)].expr_t));
-            ;}
+                interpreter->Deallocate((yyvsp[0].expr_t));
+            }
+#line 2222 "parser.cpp"
     break;
 
-  case 36:
-
-/* Line 1455 of yacc.c  */
-#line 819 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                   (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
-               ;}
+  case 36: /* or_level_expr: and_level_expr  */
+#line 866 "parser.y"
+               {
+                   (yyval.expr_t) = (yyvsp[0].expr_t);
+               }
+#line 2230 "parser.cpp"
     break;
 
-  case 37:
-
-/* Line 1455 of yacc.c  */
-#line 823 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_OR_RR);
-               ;}
+  case 37: /* or_level_expr: or_level_expr OR and_level_expr  */
+#line 870 "parser.y"
+               {
+                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[-2].expr_t), (yyvsp[0].expr_t), OP_OR_RR);
+               }
+#line 2238 "parser.cpp"
     break;
 
-  case 38:
-
-/* Line 1455 of yacc.c  */
-#line 829 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                    (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
-                ;}
+  case 38: /* and_level_expr: compare_expr  */
+#line 876 "parser.y"
+                {
+                    (yyval.expr_t) = (yyvsp[0].expr_t);
+                }
+#line 2246 "parser.cpp"
     break;
 
-  case 39:
-
-/* Line 1455 of yacc.c  */
-#line 833 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                    (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_AND_RR);
-                ;}
+  case 39: /* and_level_expr: and_level_expr AND compare_expr  */
+#line 880 "parser.y"
+                {
+                    (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[-2].expr_t), (yyvsp[0].expr_t), OP_AND_RR);
+                }
+#line 2254 "parser.cpp"
     break;
 
-  case 40:
-
-/* Line 1455 of yacc.c  */
-#line 839 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                  (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
-              ;}
+  case 40: /* compare_expr: relative_expr  */
+#line 886 "parser.y"
+              {
+                  (yyval.expr_t) = (yyvsp[0].expr_t);
+              }
+#line 2262 "parser.cpp"
     break;
 
-  case 41:
-
-/* Line 1455 of yacc.c  */
-#line 843 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                  (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_SETE_RR);
-              ;}
+  case 41: /* compare_expr: compare_expr ISEQU relative_expr  */
+#line 890 "parser.y"
+              {
+                  (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[-2].expr_t), (yyvsp[0].expr_t), OP_SETE_RR);
+              }
+#line 2270 "parser.cpp"
     break;
 
-  case 42:
-
-/* Line 1455 of yacc.c  */
-#line 847 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                  (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_SETNE_RR);
-              ;}
+  case 42: /* compare_expr: compare_expr NOTEQU relative_expr  */
+#line 894 "parser.y"
+              {
+                  (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[-2].expr_t), (yyvsp[0].expr_t), OP_SETNE_RR);
+              }
+#line 2278 "parser.cpp"
     break;
 
-  case 43:
-
-/* Line 1455 of yacc.c  */
-#line 853 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                   (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
-               ;}
+  case 43: /* relative_expr: additive_expr  */
+#line 900 "parser.y"
+               {
+                   (yyval.expr_t) = (yyvsp[0].expr_t);
+               }
+#line 2286 "parser.cpp"
     break;
 
-  case 44:
-
-/* Line 1455 of yacc.c  */
-#line 857 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_SETL_RR);
-               ;}
+  case 44: /* relative_expr: relative_expr LT additive_expr  */
+#line 904 "parser.y"
+               {
+                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[-2].expr_t), (yyvsp[0].expr_t), OP_SETL_RR);
+               }
+#line 2294 "parser.cpp"
     break;
 
-  case 45:
-
-/* Line 1455 of yacc.c  */
-#line 861 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_SETLE_RR);
-               ;}
+  case 45: /* relative_expr: relative_expr LE additive_expr  */
+#line 908 "parser.y"
+               {
+                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[-2].expr_t), (yyvsp[0].expr_t), OP_SETLE_RR);
+               }
+#line 2302 "parser.cpp"
     break;
 
-  case 46:
-
-/* Line 1455 of yacc.c  */
-#line 865 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_SETG_RR);
-               ;}
+  case 46: /* relative_expr: relative_expr GT additive_expr  */
+#line 912 "parser.y"
+               {
+                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[-2].expr_t), (yyvsp[0].expr_t), OP_SETG_RR);
+               }
+#line 2310 "parser.cpp"
     break;
 
-  case 47:
-
-/* Line 1455 of yacc.c  */
-#line 869 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_SETGE_RR);
-               ;}
+  case 47: /* relative_expr: relative_expr GE additive_expr  */
+#line 916 "parser.y"
+               {
+                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[-2].expr_t), (yyvsp[0].expr_t), OP_SETGE_RR);
+               }
+#line 2318 "parser.cpp"
     break;
 
-  case 48:
-
-/* Line 1455 of yacc.c  */
-#line 875 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                   (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
-               ;}
+  case 48: /* additive_expr: multiplicative_expr  */
+#line 922 "parser.y"
+               {
+                   (yyval.expr_t) = (yyvsp[0].expr_t);
+               }
+#line 2326 "parser.cpp"
     break;
 
-  case 49:
-
-/* Line 1455 of yacc.c  */
-#line 879 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_ADD_RR);
-               ;}
+  case 49: /* additive_expr: additive_expr PLUS multiplicative_expr  */
+#line 926 "parser.y"
+               {
+                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[-2].expr_t), (yyvsp[0].expr_t), OP_ADD_RR);
+               }
+#line 2334 "parser.cpp"
     break;
 
-  case 50:
-
-/* Line 1455 of yacc.c  */
-#line 883 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_SUB_RR);
-               ;}
+  case 50: /* additive_expr: additive_expr MINUS multiplicative_expr  */
+#line 930 "parser.y"
+               {
+                   (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[-2].expr_t), (yyvsp[0].expr_t), OP_SUB_RR);
+               }
+#line 2342 "parser.cpp"
     break;
 
-  case 51:
-
-/* Line 1455 of yacc.c  */
-#line 889 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                         (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
-                     ;}
+  case 51: /* multiplicative_expr: unary_expr  */
+#line 936 "parser.y"
+                     {
+                         (yyval.expr_t) = (yyvsp[0].expr_t);
+                     }
+#line 2350 "parser.cpp"
     break;
 
-  case 52:
-
-/* Line 1455 of yacc.c  */
-#line 893 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                         (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_MUL_RR);
-                     ;}
+  case 52: /* multiplicative_expr: multiplicative_expr STAR unary_expr  */
+#line 940 "parser.y"
+                     {
+                         (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[-2].expr_t), (yyvsp[0].expr_t), OP_MUL_RR);
+                     }
+#line 2358 "parser.cpp"
     break;
 
-  case 53:
-
-/* Line 1455 of yacc.c  */
-#line 897 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                         (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_DIV_RR);
-                     ;}
+  case 53: /* multiplicative_expr: multiplicative_expr DIV unary_expr  */
+#line 944 "parser.y"
+                     {
+                         (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[-2].expr_t), (yyvsp[0].expr_t), OP_DIV_RR);
+                     }
+#line 2366 "parser.cpp"
     break;
 
-  case 54:
-
-/* Line 1455 of yacc.c  */
-#line 901 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                         (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[(1) - (3)].expr_t), (yyvsp[(3) - (3)].expr_t), OP_MOD_RR);
-                     ;}
+  case 54: /* multiplicative_expr: multiplicative_expr MOD unary_expr  */
+#line 948 "parser.y"
+                     {
+                         (yyval.expr_t) = interpreter->Arithmetic_Expr((yyvsp[-2].expr_t), (yyvsp[0].expr_t), OP_MOD_RR);
+                     }
+#line 2374 "parser.cpp"
     break;
 
-  case 55:
-
-/* Line 1455 of yacc.c  */
-#line 907 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
-            ;}
+  case 55: /* unary_expr: term  */
+#line 954 "parser.y"
+            {
+                (yyval.expr_t) = (yyvsp[0].expr_t);
+            }
+#line 2382 "parser.cpp"
     break;
 
-  case 56:
-
-/* Line 1455 of yacc.c  */
-#line 911 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                (yyval.expr_t) = interpreter->Unary_Expr((yyvsp[(2) - (2)].expr_t), Expr_Inc);
+  case 56: /* unary_expr: INC term  */
+#line 958 "parser.y"
+            {
+                (yyval.expr_t) = interpreter->Unary_Expr((yyvsp[0].expr_t), Expr_Inc);
                 
                 if( !(yyval.expr_t) )
                     return 0;
-            ;}
+            }
+#line 2393 "parser.cpp"
     break;
 
-  case 57:
-
-/* Line 1455 of yacc.c  */
-#line 918 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                (yyval.expr_t) = interpreter->Unary_Expr((yyvsp[(2) - (2)].expr_t), Expr_Dec);
+  case 57: /* unary_expr: DEC term  */
+#line 965 "parser.y"
+            {
+                (yyval.expr_t) = interpreter->Unary_Expr((yyvsp[0].expr_t), Expr_Dec);
                 
                 if( !(yyval.expr_t) )
                     return 0;
-            ;}
+            }
+#line 2404 "parser.cpp"
     break;
 
-  case 58:
-
-/* Line 1455 of yacc.c  */
-#line 925 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                (yyval.expr_t) = (yyvsp[(2) - (2)].expr_t);
-            ;}
+  case 58: /* unary_expr: PLUS term  */
+#line 972 "parser.y"
+            {
+                (yyval.expr_t) = (yyvsp[0].expr_t);
+            }
+#line 2412 "parser.cpp"
     break;
 
-  case 59:
-
-/* Line 1455 of yacc.c  */
-#line 929 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                (yyval.expr_t) = interpreter->Unary_Expr((yyvsp[(2) - (2)].expr_t), Expr_Neg);
+  case 59: /* unary_expr: MINUS term  */
+#line 976 "parser.y"
+            {
+                (yyval.expr_t) = interpreter->Unary_Expr((yyvsp[0].expr_t), Expr_Neg);
                 
                 if( !(yyval.expr_t) )
                     return 0;
-            ;}
+            }
+#line 2423 "parser.cpp"
     break;
 
-  case 60:
-
-/* Line 1455 of yacc.c  */
-#line 936 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                (yyval.expr_t) = interpreter->Unary_Expr((yyvsp[(2) - (2)].expr_t), Expr_Not);
+  case 60: /* unary_expr: NOT term  */
+#line 983 "parser.y"
+            {
+                (yyval.expr_t) = interpreter->Unary_Expr((yyvsp[0].expr_t), Expr_Not);
                 
                 if( !(yyval.expr_t) )
                     return 0;
-            ;}
+            }
+#line 2434 "parser.cpp"
     break;
 
-  case 61:
-
-/* Line 1455 of yacc.c  */
-#line 945 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 61: /* lvalue: variable  */
+#line 992 "parser.y"
+        {
             (yyval.expr_t) = interpreter->Allocate<expression_desc>();
 
-            (yyval.expr_t)->address = (yyvsp[(1) - (1)].symbol_t)->address;
+            (yyval.expr_t)->address = (yyvsp[0].symbol_t)->address;
             (yyval.expr_t)->constexpr = false;
-        ;}
+            (yyval.expr_t)->type = (yyvsp[0].symbol_t)->type;
+        }
+#line 2446 "parser.cpp"
     break;
 
-  case 62:
-
-/* Line 1455 of yacc.c  */
-#line 954 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 62: /* term: LRB expr RRB  */
+#line 1002 "parser.y"
+      {
           parser_out("term -> (expr)");
-          (yyval.expr_t) = (yyvsp[(2) - (3)].expr_t);
-      ;}
+          (yyval.expr_t) = (yyvsp[-1].expr_t);
+      }
+#line 2455 "parser.cpp"
     break;
 
-  case 63:
-
-/* Line 1455 of yacc.c  */
-#line 959 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 63: /* term: literal  */
+#line 1007 "parser.y"
+      {
           parser_out("term -> literal");
-          (yyval.expr_t) = (yyvsp[(1) - (1)].expr_t);
-      ;}
+          (yyval.expr_t) = (yyvsp[0].expr_t);
+      }
+#line 2464 "parser.cpp"
     break;
 
-  case 64:
-
-/* Line 1455 of yacc.c  */
-#line 964 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 64: /* term: variable  */
+#line 1012 "parser.y"
+      {
           parser_out("term -> variable");
           (yyval.expr_t) = interpreter->Allocate<expression_desc>();
 
-          (yyval.expr_t)->address = (yyvsp[(1) - (1)].symbol_t)->address;
+          (yyval.expr_t)->address = (yyvsp[0].symbol_t)->address;
           (yyval.expr_t)->constexpr = false;
-          (yyval.expr_t)->type = (yyvsp[(1) - (1)].symbol_t)->type;
-      ;}
+          (yyval.expr_t)->type = (yyvsp[0].symbol_t)->type;
+      }
+#line 2477 "parser.cpp"
     break;
 
-  case 65:
-
-/* Line 1455 of yacc.c  */
-#line 973 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 65: /* term: func_call  */
+#line 1021 "parser.y"
+      {
           parser_out("term -> func_call");
           (yyval.expr_t) = interpreter->Allocate<expression_desc>();
 
           (yyval.expr_t)->address = UNKNOWN_ADDR;
           (yyval.expr_t)->constexpr = false;
-          (yyval.expr_t)->type = (yyvsp[(1) - (1)].symbol_t)->type;
+          (yyval.expr_t)->type = (yyvsp[0].symbol_t)->type;
           
           expression_desc* expr;
-          int val;
           int count = 0;
           
-          if( (yyvsp[(1) - (1)].symbol_t)->args )
+          if( (yyvsp[0].symbol_t)->args )
           {
-              for( exprlist::reverse_iterator it = (yyvsp[(1) - (1)].symbol_t)->args->rbegin(); it != (yyvsp[(1) - (1)].symbol_t)->args->rend(); ++it )
+              size_t index = (yyvsp[0].symbol_t)->args->size();
+
+              for( exprlist::reverse_iterator it = (yyvsp[0].symbol_t)->args->rbegin(); it != (yyvsp[0].symbol_t)->args->rend(); ++it )
               {
                   expr = (*it);
                   
+                  // arguments are passed as the declared type
+                  if( --index < (yyvsp[0].symbol_t)->params.size() )
+                      interpreter->Convert(expr, (yyvsp[0].symbol_t)->params[index]);
+
                   if( expr->constexpr )
                   {
-                      val = atoi(expr->value.c_str());
-                      (yyval.expr_t)->bytecode << OP(OP_MOV_RS) << REG(EAX) << val;
+                      (yyval.expr_t)->bytecode << OP(OP_MOV_RS) << REG(EAX) << expr->value;
                   }
                   else if( expr->address == UNKNOWN_ADDR )
                   {
-                      (yyval.expr_t)->bytecode << expr->bytecode;
+                      (yyval.expr_t)->bytecode.splice(expr->bytecode);
                   }
                   else
                   {
-                      (yyval.expr_t)->bytecode << expr->bytecode;
+                      (yyval.expr_t)->bytecode.splice(expr->bytecode);
                       (yyval.expr_t)->bytecode << OP(OP_MOV_RM) << REG(EAX) << expr->address;
                   }
                   
@@ -2725,105 +2521,118 @@ yyreduce:
                   ++count;
               }
               
-              interpreter->Deallocate((yyvsp[(1) - (1)].symbol_t)->args);
+              interpreter->Deallocate((yyvsp[0].symbol_t)->args);
           }
           
-          unresolved_reference* ref = interpreter->Allocate<unresolved_reference>();
-          ref->func = (yyvsp[(1) - (1)].symbol_t);
+          unresolved_reference ref;
+          ref.func = (yyvsp[0].symbol_t);
 
           (yyval.expr_t)->bytecode << OP(OP_PUSHADD) << REG(EIP) << (int)(ENTRY_SIZE);
-          (yyval.expr_t)->bytecode << OP(OP_JMP) << (int)UNKNOWN_ADDR << ADDR(ref);
+          (yyval.expr_t)->bytecode.relocate() << OP(OP_JMP) << (int)UNKNOWN_ADDR << (int)interpreter->references.size();
+
+          interpreter->references.push_back(ref);
           
           // clear the stack
           for( int i = 0; i < count; ++i )
               (yyval.expr_t)->bytecode << OP(OP_POP) << REG(EDX) << NIL;
-      ;}
+      }
+#line 2540 "parser.cpp"
     break;
 
-  case 66:
-
-/* Line 1455 of yacc.c  */
-#line 1028 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 66: /* func_call: IDENTIFIER LRB expression_list RRB  */
+#line 1082 "parser.y"
+           {
                // look for this function in the global scope
                symboltable::iterator sym;
                
                symboltable& table = interpreter->scopes[0];
-               sym = table.find(*(yyvsp[(1) - (4)].text_t));
+               sym = table.find(*(yyvsp[-3].text_t));
                   
-               nassert(0, "Undeclared function '" << *(yyvsp[(1) - (4)].text_t) << "'", sym == table.end());
-               assert(0, "Referenced symbol '" << *(yyvsp[(1) - (4)].text_t) << "' is not a function", sym->second->isfunc);
+               nassert(0, "Undeclared function '" << *(yyvsp[-3].text_t) << "'", sym == table.end());
+               assert(0, "Referenced symbol '" << *(yyvsp[-3].text_t) << "' is not a function", sym->second->isfunc);
                
                (yyval.symbol_t) = sym->second;
-               (yyval.symbol_t)->args = (yyvsp[(3) - (4)].exprlist_t);
+               (yyval.symbol_t)->args = (yyvsp[-1].exprlist_t);
 
-               interpreter->Deallocate((yyvsp[(1) - (4)].text_t));
-           ;}
+               interpreter->Deallocate((yyvsp[-3].text_t));
+           }
+#line 2560 "parser.cpp"
     break;
 
-  case 67:
-
-/* Line 1455 of yacc.c  */
-#line 1044 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 67: /* func_call: IDENTIFIER LRB RRB  */
+#line 1098 "parser.y"
+           {
                // look for this function in the global scope
                symboltable::iterator sym;
                
                symboltable& table = interpreter->scopes[0];
-               sym = table.find(*(yyvsp[(1) - (3)].text_t));
+               sym = table.find(*(yyvsp[-2].text_t));
                   
-               nassert(0, "Undeclared function '" << *(yyvsp[(1) - (3)].text_t) << "'", sym == table.end());
-               assert(0, "Referenced symbol '" << *(yyvsp[(1) - (3)].text_t) << "' is not a function", sym->second->isfunc);
+               nassert(0, "Undeclared function '" << *(yyvsp[-2].text_t) << "'", sym == table.end());
+               assert(0, "Referenced symbol '" << *(yyvsp[-2].text_t) << "' is not a function", sym->second->isfunc);
 
                (yyval.symbol_t) = sym->second;
                (yyval.symbol_t)->args = 0;
 
-               interpreter->Deallocate((yyvsp[(1) - (3)].text_t));
-           ;}
+               interpreter->Deallocate((yyvsp[-2].text_t));
+           }
+#line 2580 "parser.cpp"
     break;
 
-  case 68:
-
-/* Line 1455 of yacc.c  */
-#line 1062 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 68: /* expression_list: expr  */
+#line 1116 "parser.y"
+                 {
                      (yyval.exprlist_t) = interpreter->Allocate<exprlist>();
-                     (yyval.exprlist_t)->push_back((yyvsp[(1) - (1)].expr_t));
-                 ;}
+                     (yyval.exprlist_t)->push_back((yyvsp[0].expr_t));
+                 }
+#line 2589 "parser.cpp"
     break;
 
-  case 69:
-
-/* Line 1455 of yacc.c  */
-#line 1067 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
-                     (yyval.exprlist_t) = (yyvsp[(1) - (3)].exprlist_t);
-                     (yyval.exprlist_t)->push_back((yyvsp[(3) - (3)].expr_t));
-                 ;}
+  case 69: /* expression_list: expression_list COMMA expr  */
+#line 1121 "parser.y"
+                 {
+                     (yyval.exprlist_t) = (yyvsp[-2].exprlist_t);
+                     (yyval.exprlist_t)->push_back((yyvsp[0].expr_t));
+                 }
+#line 2598 "parser.cpp"
     break;
 
-  case 70:
-
-/* Line 1455 of yacc.c  */
-#line 1074 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 70: /* literal: NUMBER  */
+#line 1128 "parser.y"
+         {
              parser_out("literal -> NUMBER");
              (yyval.expr_t) = interpreter->Allocate<expression_desc>();
 
              (yyval.expr_t)->type = Type_Integer;
-             (yyval.expr_t)->value = *(yyvsp[(1) - (1)].text_t);
+             (yyval.expr_t)->value = atoi((yyvsp[0].text_t)->c_str());
              (yyval.expr_t)->address = UNKNOWN_ADDR;
              (yyval.expr_t)->constexpr = true;
 
-             interpreter->Deallocate((yyvsp[(1) - (1)].text_t));
-         ;}
+             interpreter->Deallocate((yyvsp[0].text_t));
+         }
+#line 2614 "parser.cpp"
     break;
 
-  case 71:
+  case 71: /* literal: REAL  */
+#line 1140 "parser.y"
+         {
+             parser_out("literal -> REAL");
+             (yyval.expr_t) = interpreter->Allocate<expression_desc>();
 
-/* Line 1455 of yacc.c  */
-#line 1088 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+             // the value holds the bits of the float
+             (yyval.expr_t)->type = Type_Float;
+             (yyval.expr_t)->value = Float_To_Bits((float)atof((yyvsp[0].text_t)->c_str()));
+             (yyval.expr_t)->address = UNKNOWN_ADDR;
+             (yyval.expr_t)->constexpr = true;
+
+             interpreter->Deallocate((yyvsp[0].text_t));
+         }
+#line 2631 "parser.cpp"
+    break;
+
+  case 72: /* variable: IDENTIFIER  */
+#line 1155 "parser.y"
+          {
               parser_out("variable -> IDENTIFIER");
               
               // look for this variable in the symbol table
@@ -2833,7 +2642,7 @@ yyreduce:
               for( int s = interpreter->current_scope; s >= 0; --s )
               {
                   symboltable& table = interpreter->scopes[s];
-                  sym = table.find(*(yyvsp[(1) - (1)].text_t));
+                  sym = table.find(*(yyvsp[0].text_t));
                   
                   if( sym != table.end() )
                   {
@@ -2842,137 +2651,120 @@ yyreduce:
                   }
               }
               
-              assert(0, "Undeclared identifier '" << *(yyvsp[(1) - (1)].text_t) << "'", found);
+              assert(0, "Undeclared identifier '" << *(yyvsp[0].text_t) << "'", found);
               (yyval.symbol_t) = sym->second;
 
-              interpreter->Deallocate((yyvsp[(1) - (1)].text_t));
-          ;}
+              interpreter->Deallocate((yyvsp[0].text_t));
+          }
+#line 2660 "parser.cpp"
     break;
 
-  case 72:
-
-/* Line 1455 of yacc.c  */
-#line 1115 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 73: /* typename: INT  */
+#line 1182 "parser.y"
+          {
               parser_out("typename -> INT");
               (yyval.type_t) = Type_Integer;
-          ;}
+          }
+#line 2669 "parser.cpp"
     break;
 
-  case 73:
+  case 74: /* typename: FLOAT  */
+#line 1187 "parser.y"
+          {
+              parser_out("typename -> FLOAT");
+              (yyval.type_t) = Type_Float;
+          }
+#line 2678 "parser.cpp"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 1120 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 75: /* typename: VOID  */
+#line 1192 "parser.y"
+          {
               parser_out("typename -> VOID");
               (yyval.type_t) = Type_Unknown;
-          ;}
+          }
+#line 2687 "parser.cpp"
     break;
 
-  case 74:
-
-/* Line 1455 of yacc.c  */
-#line 1127 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
-    {
+  case 76: /* string: QUOTE STRING QUOTE  */
+#line 1199 "parser.y"
+        {
             parser_out("string -> QUOTE STRING QUOTE");
-            (yyval.text_t) = (yyvsp[(2) - (3)].text_t);
-        ;}
+            (yyval.text_t) = (yyvsp[-1].text_t);
+        }
+#line 2696 "parser.cpp"
     break;
 
 
+#line 2700 "parser.cpp"
 
-/* Line 1455 of yacc.c  */
-#line 2886 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.cpp"
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-      {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (yymsg);
-	  }
-	else
-	  {
-	    yyerror (YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
-      }
-#endif
+      yyerror (&yylloc, interpreter, scanner, YY_("syntax error"));
     }
 
-  yyerror_range[0] = yylloc;
-
+  yyerror_range[1] = yylloc;
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
-	 error, discard it.  */
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval, &yylloc);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc, interpreter, scanner);
+          yychar = YYEMPTY;
+        }
     }
 
   /* Else will try to reuse lookahead token after shifting the error
@@ -2984,15 +2776,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  yyerror_range[0] = yylsp[1-yylen];
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -3005,44 +2795,45 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
-      yyerror_range[0] = *yylsp;
+      yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, interpreter, scanner);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
-  yyerror_range[1] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, (yyerror_range - 1), 2);
-  *++yylsp = yyloc;
+  yyerror_range[2] = yylloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -3053,58 +2844,59 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined(yyoverflow) || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (&yylloc, interpreter, scanner, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval, &yylloc);
-  /* Do not reclaim the symbols of the rule which action triggered
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, &yylloc, interpreter, scanner);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, interpreter, scanner);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
-
 
+  return yyresult;
+}
 
-/* Line 1675 of yacc.c  */
-#line 1133 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\myinterpreter/parser.y"
+#line 1205 "parser.y"
 
 
 #ifdef _MSC_VER
 #    pragma warning(pop)
 #endif
-
@@ -1,4 +1,8 @@
 %locations
+%pure-parser
+%parse-param {Interpreter* interpreter}
+%parse-param {void* scanner}
+%lex-param {void* scanner}
 
 %{
 
@@ -14,11 +18,6 @@
 #   pragma warning(disable : 4996)
 #endif
 
-int yylex();
-void yyerror(const char *s);
-
-Interpreter* interpreter = 0;
-
 extern std::string tostring(
     int value);
 
@@ -43,6 +42,11 @@ extern std::string& replace(
     symbol_type       type_t;
 }
 
+%{
+int yylex(YYSTYPE* lvalp, YYLTYPE* llocp, void* scanner);
+void yyerror(YYLTYPE* llocp, Interpreter* interpreter, void* scanner, const char* s);
+%}
+
 // common operators
 %token               QUOTE
 %token               LRB RRB
@@ -62,6 +66,7 @@ extern std::string& replace(
 
 // builtin types
 %token               INT
+%token               FLOAT
 %token               VOID
 
 // keywords
@@ -73,6 +78,7 @@ extern std::string& replace(
 
 // literals
 %token<text_t>       NUMBER
+%token<text_t>       REAL
 %token<text_t>       IDENTIFIER
 %token<text_t>       STRING
 
@@ -118,7 +124,6 @@ extern std::string& replace(
 program: function_list
          {
              parser_out("program -> function_list");
-             interpreter->entry = -1;
              
              for( symbollist::iterator it = $1->begin(); it != $1->end(); ++it )
              {
@@ -126,7 +131,8 @@ program: function_list
                      interpreter->entry = interpreter->program.size();
                  
                  (*it)->address = interpreter->program.size();
-                 interpreter->program << (*it)->bytecode;
+                 interpreter->program.splice((*it)->bytecode);
+                 interpreter->functions.push_back(*it);
              }
              
              nassert(0, "Unresolved external 'main'", interpreter->entry == -1);
@@ -152,6 +158,7 @@ function: function_header scope
 
               // build code
               $$ = $1;
+              $$->bytecode.mark(0, @1.first_line);
               
               if( $1->name == "main" )
               {
@@ -182,7 +189,7 @@ function: function_header scope
                       if( (*it)->type == Type_Return && (*it)->scope == 1 )
                           found = true;
                   
-                      $$->bytecode << (*it)->bytecode;
+                      $$->bytecode.splice((*it)->bytecode);
                       interpreter->Deallocate(*it);
                   }
               }
@@ -275,6 +282,8 @@ function_header: typename IDENTIFIER LRB RRB
                          // update address
                          (*it)->address = addr;
                          addr += 4;
+
+                         $$->params.push_back((*it)->type);
                      }
                      
                      interpreter->Deallocate($2);
@@ -315,6 +324,10 @@ statement_block: /* empty */
                  {
                      parser_out("statement_block -> statement_block statement SEMICOLON");
                      
+                     // for the profiler
+                     if( $2 )
+                         $2->bytecode.mark(0, @2.first_line);
+
                      $$ = $1;
                      $$->push_back($2);
                  }
@@ -322,6 +335,9 @@ statement_block: /* empty */
                  {
                      parser_out("statement_block -> statement_block control_block");
                      
+                     if( $2 )
+                         $2->bytecode.mark(0, @2.first_line);
+
                      $$ = $1;
                      $$->push_back($2);
                  }
@@ -343,7 +359,7 @@ statement: print
                parser_out("statement -> expr");
                
                $$ = interpreter->Allocate<statement_desc>();
-               $$->bytecode << $1->bytecode;
+               $$->bytecode.splice($1->bytecode);
                
                interpreter->Deallocate($1);
            }
@@ -370,6 +386,8 @@ statement: print
                parser_out("statement -> RETURN expr");
                symbol_desc* func = interpreter->current_func;
                
+               interpreter->Convert($2, func->type);
+
                nassert(0, "In function '" << func->name <<
                    "': Invalid return type", func->type != $2->type);
 
@@ -381,16 +399,15 @@ statement: print
                
                if( $2->constexpr )
                {
-                   int val = atoi($2->value.c_str());
-                   $$->bytecode << OP(OP_MOV_RS) << REG(EAX) << val;
+                   $$->bytecode << OP(OP_MOV_RS) << REG(EAX) << $2->value;
                }
                else if( $2->address == UNKNOWN_ADDR )
                {
-                   $$->bytecode << $2->bytecode;
+                   $$->bytecode.splice($2->bytecode);
                }
                else
                {
-                   $$->bytecode << $2->bytecode;
+                   $$->bytecode.splice($2->bytecode);
                    $$->bytecode << OP(OP_MOV_RM) << REG(EAX) << $2->address;
                }
                
@@ -415,29 +432,28 @@ control_block: conditional
 conditional: IF LRB expr RRB scope
              {
                  $$ = interpreter->Allocate<statement_desc>();
+                 interpreter->Condition($3);
                  
                  if( $3->constexpr )
                  {
-                     int val = atoi($3->value.c_str());
-                     
-                     if( val != 0 )
+                     // the branch is either compiled or dropped
+                     for( statlist::iterator it = $5->begin(); it != $5->end(); ++it )
                      {
-                         for( statlist::iterator it = $5->begin(); it != $5->end(); ++it )
-						 {
-							 if( *it )
-							 {
-								 $$->bytecode << (*it)->bytecode;
-								 interpreter->Deallocate(*it);
-							 }
-						 }
+                         if( *it )
+                         {
+                             if( $3->value != 0 )
+                                 $$->bytecode.splice((*it)->bytecode);
+
+                             interpreter->Deallocate(*it);
+                         }
                      }
                  }
                  else
                  {
-                     $$->bytecode << $3->bytecode;
+                     $$->bytecode.splice($3->bytecode);
                      
 					 if( $3->address != UNKNOWN_ADDR )
-						 $$->bytecode << OP(OP_MOV_RM) << OP(EAX) << $3->address;
+						 $$->bytecode << OP(OP_MOV_RM) << REG(EAX) << $3->address;
 	                 
 					 int off = 0;
 	                 
@@ -455,7 +471,7 @@ conditional: IF LRB expr RRB scope
 					 {
 						 if( *it )
 						 {
-							 $$->bytecode << (*it)->bytecode;
+							 $$->bytecode.splice((*it)->bytecode);
 							 interpreter->Deallocate(*it);
 						 }
 					 }
@@ -467,42 +483,35 @@ conditional: IF LRB expr RRB scope
            | IF LRB expr RRB scope ELSE scope
              {
                  $$ = interpreter->Allocate<statement_desc>();
+                 interpreter->Condition($3);
                  
                  if( $3->constexpr )
                  {
-                     int val = atoi($3->value.c_str());
-                     
-                     if( val != 0 )
+                     // only one of the branches is compiled
+                     statlist* taken = ($3->value != 0 ? $5 : $7);
+                     statlist* dead = ($3->value != 0 ? $7 : $5);
+
+                     for( statlist::iterator it = taken->begin(); it != taken->end(); ++it )
                      {
-                         // apply true branch
-                         for( statlist::iterator it = $5->begin(); it != $5->end(); ++it )
-						 {
-							 if( *it )
-							 {
-								 $$->bytecode << (*it)->bytecode;
-								 interpreter->Deallocate(*it);
-							 }
-						 }
+                         if( *it )
+                         {
+                             $$->bytecode.splice((*it)->bytecode);
+                             interpreter->Deallocate(*it);
+                         }
                      }
-                     else
+
+                     for( statlist::iterator it = dead->begin(); it != dead->end(); ++it )
                      {
-                         // apply false branch
-						 for( statlist::iterator it = $7->begin(); it != $7->end(); ++it )
-						 {
-							 if( *it )
-							 {
-								 $$->bytecode << (*it)->bytecode;
-								 interpreter->Deallocate(*it);
-							 }
-						 }
+                         if( *it )
+                             interpreter->Deallocate(*it);
                      }
                  }
                  else
                  {
-					 $$->bytecode << $3->bytecode;
+					 $$->bytecode.splice($3->bytecode);
 	                 
 					 if( $3->address != UNKNOWN_ADDR )
-						 $$->bytecode << OP(OP_MOV_RM) << OP(EAX) << $3->address;
+						 $$->bytecode << OP(OP_MOV_RM) << REG(EAX) << $3->address;
 	                 
 					 int off1 = 0;
 					 int off2 = 0;
@@ -528,7 +537,7 @@ conditional: IF LRB expr RRB scope
 					 {
 						 if( *it )
 						 {
-							 $$->bytecode << (*it)->bytecode;
+							 $$->bytecode.splice((*it)->bytecode);
 							 interpreter->Deallocate(*it);
 						 }
 					 }
@@ -540,7 +549,7 @@ conditional: IF LRB expr RRB scope
 					 {
 						 if( *it )
 						 {
-							 $$->bytecode << (*it)->bytecode;
+							 $$->bytecode.splice((*it)->bytecode);
 							 interpreter->Deallocate(*it);
 						 }
 					 }
@@ -555,42 +564,67 @@ conditional: IF LRB expr RRB scope
 while_loop: WHILE LRB expr RRB scope
             {
                 $$ = interpreter->Allocate<statement_desc>();
-                $$->bytecode << $3->bytecode;
-                
-                nassert(0, "Break statement not yet supported", $3->constexpr);
-                
-                int off = 0;
-                int loop = $3->bytecode.size();
-                
-                if( $3->address != UNKNOWN_ADDR )
-                {
-                    $$->bytecode << OP(OP_MOV_RM) << OP(EAX) << $3->address;
-                    loop += ENTRY_SIZE;
-                }
-                 
-                // calculate offset
-                for( statlist::iterator it = $5->begin(); it != $5->end(); ++it )
+                interpreter->Condition($3);
+
+                if( $3->constexpr )
                 {
-                    if( *it )
-                        off += (int)(*it)->bytecode.size();
+                    // while( 0 ) is dropped, anything else loops until a return
+                    int off = 0;
+
+                    for( statlist::iterator it = $5->begin(); it != $5->end(); ++it )
+                    {
+                        if( *it )
+                        {
+                            if( $3->value != 0 )
+                            {
+                                off += (int)(*it)->bytecode.size();
+                                $$->bytecode.splice((*it)->bytecode);
+                            }
+
+                            interpreter->Deallocate(*it);
+                        }
+                    }
+
+                    if( $3->value != 0 )
+                        $$->bytecode << OP(OP_JMP) << (int)-(off + (int)ENTRY_SIZE) << NIL;
                 }
-                
-                $$->bytecode << OP(OP_JZ) << REG(EAX) << (int)(off + ENTRY_SIZE);
-                
-                // jz and jmp
-                loop += (off + 2 * ENTRY_SIZE);
-                 
-                for( statlist::iterator it = $5->begin(); it != $5->end(); ++it )
+                else
                 {
-                    if( *it )
+                    $$->bytecode.splice($3->bytecode);
+
+                    int off = 0;
+                    int loop = $$->bytecode.size();
+
+                    if( $3->address != UNKNOWN_ADDR )
+                    {
+                        $$->bytecode << OP(OP_MOV_RM) << REG(EAX) << $3->address;
+                        loop += ENTRY_SIZE;
+                    }
+
+                    // calculate offset
+                    for( statlist::iterator it = $5->begin(); it != $5->end(); ++it )
                     {
-                        $$->bytecode << (*it)->bytecode;
-                        interpreter->Deallocate(*it);
+                        if( *it )
+                            off += (int)(*it)->bytecode.size();
                     }
+
+                    $$->bytecode << OP(OP_JZ) << REG(EAX) << (int)(off + ENTRY_SIZE);
+
+                    // jz and jmp
+                    loop += (off + 2 * ENTRY_SIZE);
+
+                    for( statlist::iterator it = $5->begin(); it != $5->end(); ++it )
+                    {
+                        if( *it )
+                        {
+                            $$->bytecode.splice((*it)->bytecode);
+                            interpreter->Deallocate(*it);
+                        }
+                    }
+
+                    $$->bytecode << OP(OP_JMP) << -loop << NIL;
                 }
-                
-                $$->bytecode << OP(OP_JMP) << -loop << NIL;
-                
+
                 interpreter->Deallocate($3);
                 interpreter->Deallocate($5);
             }
@@ -630,6 +664,9 @@ scope: scope_start statement_block RB
 scope_start: LB
              {
                  ++interpreter->current_scope;
+                 
+                 if( interpreter->current_scope >= interpreter->scopes.size() )
+                     interpreter->scopes.resize(interpreter->current_scope + 1);
              }
 ;
 
@@ -638,24 +675,35 @@ print: PRINT string
            parser_out("print -> PRINT string");
            
            $$ = interpreter->Allocate<statement_desc>();
-           $$->bytecode << OP(OP_PRINT_M) << ADDR($2) << REG(0);
+           $$->bytecode << OP(OP_PRINT_M) << (int)interpreter->strings.size() << REG(0);
+           
+           // code refers to strings by index
+           interpreter->strings.push_back(*$2);
+           interpreter->Deallocate($2);
        }
      | PRINT expr
        {
            parser_out("print -> PRINT expr");
            $$ = interpreter->Allocate<statement_desc>();
            
-           if( $2->address == UNKNOWN_ADDR )
+           unsigned char op = ($2->type == Type_Float ? OP_PRINT_F : OP_PRINT_R);
+           
+           if( $2->constexpr )
+           {
+               $$->bytecode << OP(OP_MOV_RS) << REG(EAX) << $2->value;
+               $$->bytecode << OP(op) << REG(EAX) << REG(0);
+           }
+           else if( $2->address == UNKNOWN_ADDR )
            {
                // result of an expression in EAX
-               $$->bytecode << $2->bytecode << OP(OP_PRINT_R) << REG(EAX) << REG(0);
+               $$->bytecode.splice($2->bytecode) << OP(op) << REG(EAX) << REG(0);
            }
            else
            {
                // variable on the stack
-               $$->bytecode << $2->bytecode;
+               $$->bytecode.splice($2->bytecode);
                $$->bytecode << OP(OP_MOV_RM) << REG(EAX) << $2->address;
-               $$->bytecode << OP(OP_PRINT_R) << REG(EAX) << REG(0);
+               $$->bytecode << OP(op) << REG(EAX) << REG(0);
            }
            
            interpreter->Deallocate($2);
@@ -706,22 +754,22 @@ declaration: typename init_declarator_list
 
                      if( expr )
                      {
+                         interpreter->Convert(expr, var->type);
+
                          if( expr->constexpr )
                          {
-                             int a = atoi(expr->value.c_str());
-
-                             $$->bytecode << OP(OP_MOV_RS) << REG(EAX) << a;
-                             $$->bytecode << expr->bytecode << OP(OP_MOV_MR) << var->address << REG(EAX);
+                             $$->bytecode << OP(OP_MOV_RS) << REG(EAX) << expr->value;
+                             $$->bytecode.splice(expr->bytecode) << OP(OP_MOV_MR) << var->address << REG(EAX);
                          }
                          else if( expr->address == UNKNOWN_ADDR )
                          {
                              // result of an expression in EAX
-                             $$->bytecode << expr->bytecode << OP(OP_MOV_MR) << var->address << REG(EAX);
+                             $$->bytecode.splice(expr->bytecode) << OP(OP_MOV_MR) << var->address << REG(EAX);
                          }
                          else
                          {
                              // variable on the stack
-                             $$->bytecode << expr->bytecode;
+                             $$->bytecode.splice(expr->bytecode);
                              $$->bytecode << OP(OP_MOV_RM) << REG(EAX) << expr->address;
                              $$->bytecode << OP(OP_MOV_MR) << var->address << REG(EAX);
                          }
@@ -792,23 +840,22 @@ assignment: or_level_expr
                 assert(0, "assignment -> lvalue = assignment: NULL == $3", $3);
 
                 $$ = $1;
+                interpreter->Convert($3, $1->type);
 
                 if( $3->constexpr )
                 {
-                    int a = atoi($3->value.c_str());
-
-                    $$->bytecode << OP(OP_MOV_RS) << REG(EAX) << a;
-                    $$->bytecode << $3->bytecode << OP(OP_MOV_MR) << $1->address << REG(EAX);
+                    $$->bytecode << OP(OP_MOV_RS) << REG(EAX) << $3->value;
+                    $$->bytecode.splice($3->bytecode) << OP(OP_MOV_MR) << $1->address << REG(EAX);
                 }
                 else if( $3->address == UNKNOWN_ADDR )
                 {
                     // result of an expression in EAX
-                    $$->bytecode << $3->bytecode << OP(OP_MOV_MR) << $1->address << REG(EAX);
+                    $$->bytecode.splice($3->bytecode) << OP(OP_MOV_MR) << $1->address << REG(EAX);
                 }
                 else
                 {
                     // variable on the stack
-                    $$->bytecode << $3->bytecode << OP(OP_MOV_MM) << $1->address << $3->address;
+                    $$->bytecode.splice($3->bytecode) << OP(OP_MOV_MM) << $1->address << $3->address;
                 }
                 
                 interpreter->Deallocate($3);
@@ -947,6 +994,7 @@ lvalue: variable
 
             $$->address = $1->address;
             $$->constexpr = false;
+            $$->type = $1->type;
         }
 ;
 
@@ -979,27 +1027,31 @@ term: LRB expr RRB
           $$->type = $1->type;
           
           expression_desc* expr;
-          int val;
           int count = 0;
           
           if( $1->args )
           {
+              size_t index = $1->args->size();
+
               for( exprlist::reverse_iterator it = $1->args->rbegin(); it != $1->args->rend(); ++it )
               {
                   expr = (*it);
                   
+                  // arguments are passed as the declared type
+                  if( --index < $1->params.size() )
+                      interpreter->Convert(expr, $1->params[index]);
+
                   if( expr->constexpr )
                   {
-                      val = atoi(expr->value.c_str());
-                      $$->bytecode << OP(OP_MOV_RS) << REG(EAX) << val;
+                      $$->bytecode << OP(OP_MOV_RS) << REG(EAX) << expr->value;
                   }
                   else if( expr->address == UNKNOWN_ADDR )
                   {
-                      $$->bytecode << expr->bytecode;
+                      $$->bytecode.splice(expr->bytecode);
                   }
                   else
                   {
-                      $$->bytecode << expr->bytecode;
+                      $$->bytecode.splice(expr->bytecode);
                       $$->bytecode << OP(OP_MOV_RM) << REG(EAX) << expr->address;
                   }
                   
@@ -1012,11 +1064,13 @@ term: LRB expr RRB
               interpreter->Deallocate($1->args);
           }
           
-          unresolved_reference* ref = interpreter->Allocate<unresolved_reference>();
-          ref->func = $1;
+          unresolved_reference ref;
+          ref.func = $1;
 
           $$->bytecode << OP(OP_PUSHADD) << REG(EIP) << (int)(ENTRY_SIZE);
-          $$->bytecode << OP(OP_JMP) << (int)UNKNOWN_ADDR << ADDR(ref);
+          $$->bytecode.relocate() << OP(OP_JMP) << (int)UNKNOWN_ADDR << (int)interpreter->references.size();
+
+          interpreter->references.push_back(ref);
           
           // clear the stack
           for( int i = 0; i < count; ++i )
@@ -1076,7 +1130,20 @@ literal: NUMBER
              $$ = interpreter->Allocate<expression_desc>();
 
              $$->type = Type_Integer;
-             $$->value = *$1;
+             $$->value = atoi($1->c_str());
+             $$->address = UNKNOWN_ADDR;
+             $$->constexpr = true;
+
+             interpreter->Deallocate($1);
+         }
+       | REAL
+         {
+             parser_out("literal -> REAL");
+             $$ = interpreter->Allocate<expression_desc>();
+
+             // the value holds the bits of the float
+             $$->type = Type_Float;
+             $$->value = Float_To_Bits((float)atof($1->c_str()));
              $$->address = UNKNOWN_ADDR;
              $$->constexpr = true;
 
@@ -1116,6 +1183,11 @@ typename: INT
               parser_out("typename -> INT");
               $$ = Type_Integer;
           }
+        | FLOAT
+          {
+              parser_out("typename -> FLOAT");
+              $$ = Type_Float;
+          }
         | VOID
           {
               parser_out("typename -> VOID");
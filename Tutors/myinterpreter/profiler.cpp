@@ -0,0 +1,220 @@
+
+#include "interpreter.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <set>
+
+#define MAX_PROFILE_LINES	20	// hottest lines in the flat profile
+
+struct opcode_name
+{
+	unsigned char opcode;
+	const char* name;
+};
+
+static const opcode_name opcodenames[] =
+{
+	{ OP_PRINT_R, "print_r" }, { OP_PRINT_M, "print_m" }, { OP_PRINT_F, "print_f" },
+	{ OP_PUSH, "push" }, { OP_PUSHADD, "pushadd" }, { OP_POP, "pop" },
+	{ OP_MOV_RS, "mov_rs" }, { OP_MOV_RR, "mov_rr" }, { OP_MOV_RM, "mov_rm" }, { OP_MOV_MR, "mov_mr" },
+	{ OP_MOV_MM, "mov_mm" }, { OP_MOV_MS, "mov_ms" }, { OP_ADD_MS, "add_ms" },
+	{ OP_AND_RS, "and_rs" }, { OP_AND_RR, "and_rr" }, { OP_OR_RS, "or_rs" }, { OP_OR_RR, "or_rr" }, { OP_NOT, "not" },
+	{ OP_SUB_RS, "sub_rs" }, { OP_SUB_RR, "sub_rr" }, { OP_ADD_RS, "add_rs" }, { OP_ADD_RR, "add_rr" },
+	{ OP_MUL_RS, "mul_rs" }, { OP_MUL_RR, "mul_rr" }, { OP_DIV_RS, "div_rs" }, { OP_DIV_RR, "div_rr" },
+	{ OP_MOD_RS, "mod_rs" }, { OP_MOD_RR, "mod_rr" }, { OP_NEG, "neg" },
+	{ OP_SETL_RS, "setl_rs" }, { OP_SETL_RR, "setl_rr" }, { OP_SETLE_RS, "setle_rs" }, { OP_SETLE_RR, "setle_rr" },
+	{ OP_SETG_RS, "setg_rs" }, { OP_SETG_RR, "setg_rr" }, { OP_SETGE_RS, "setge_rs" }, { OP_SETGE_RR, "setge_rr" },
+	{ OP_SETE_RS, "sete_rs" }, { OP_SETE_RR, "sete_rr" }, { OP_SETNE_RS, "setne_rs" }, { OP_SETNE_RR, "setne_rr" },
+	{ OP_JZ, "jz" }, { OP_JNZ, "jnz" }, { OP_JMP, "jmp" },
+	{ OP_SETL_JZ_RS, "setl_jz_rs" }, { OP_SETL_JZ_RR, "setl_jz_rr" }, { OP_SETLE_JZ_RS, "setle_jz_rs" }, { OP_SETLE_JZ_RR, "setle_jz_rr" },
+	{ OP_SETG_JZ_RS, "setg_jz_rs" }, { OP_SETG_JZ_RR, "setg_jz_rr" }, { OP_SETGE_JZ_RS, "setge_jz_rs" }, { OP_SETGE_JZ_RR, "setge_jz_rr" },
+	{ OP_SETE_JZ_RS, "sete_jz_rs" }, { OP_SETE_JZ_RR, "sete_jz_rr" }, { OP_SETNE_JZ_RS, "setne_jz_rs" }, { OP_SETNE_JZ_RR, "setne_jz_rr" },
+	{ OP_FSUB_RS, "fsub_rs" }, { OP_FSUB_RR, "fsub_rr" }, { OP_FADD_RS, "fadd_rs" }, { OP_FADD_RR, "fadd_rr" },
+	{ OP_FMUL_RS, "fmul_rs" }, { OP_FMUL_RR, "fmul_rr" }, { OP_FDIV_RS, "fdiv_rs" }, { OP_FDIV_RR, "fdiv_rr" },
+	{ OP_FNEG, "fneg" }, { OP_CVT_IF, "cvt_if" }, { OP_CVT_FI, "cvt_fi" },
+	{ OP_FSETL_RS, "fsetl_rs" }, { OP_FSETL_RR, "fsetl_rr" }, { OP_FSETLE_RS, "fsetle_rs" }, { OP_FSETLE_RR, "fsetle_rr" },
+	{ OP_FSETG_RS, "fsetg_rs" }, { OP_FSETG_RR, "fsetg_rr" }, { OP_FSETGE_RS, "fsetge_rs" }, { OP_FSETGE_RR, "fsetge_rr" },
+	{ OP_FSETE_RS, "fsete_rs" }, { OP_FSETE_RR, "fsete_rr" }, { OP_FSETNE_RS, "fsetne_rs" }, { OP_FSETNE_RR, "fsetne_rr" }
+};
+
+static std::string Opcode_Name(size_t opcode)
+{
+	for( size_t i = 0; i < sizeof(opcodenames) / sizeof(opcode_name); ++i )
+	{
+		if( opcodenames[i].opcode == opcode )
+			return opcodenames[i].name;
+	}
+
+	return "op_" + tostring((int)opcode);
+}
+
+template <typename count_type>
+static bool Sort_By_Count(const std::pair<count_type, int>& a, const std::pair<count_type, int>& b)
+{
+	return (a.first > b.first || (a.first == b.first && a.second < b.second));
+}
+
+std::string Interpreter::Function_Name(int address)
+{
+	for( symboltable::iterator it = scopes[0].begin(); it != scopes[0].end(); ++it )
+	{
+		if( it->second->isfunc && it->second->address == address )
+			return it->second->name;
+	}
+
+	// loaded images have no symbols
+	std::stringstream ss;
+	ss << "sub_" << std::hex << std::setw(4) << std::setfill('0') << address;
+
+	return ss.str();
+}
+
+int Interpreter::Source_Line(size_t off)
+{
+	// last mark at or before off
+	const bytestream::linetable& lines = program.lines();
+	bytestream::linetable::const_iterator it = std::upper_bound(
+		lines.begin(), lines.end(), std::make_pair(off, INT_MAX));
+
+	if( it == lines.begin() )
+		return 0;
+
+	return (it - 1)->second;
+}
+
+void Interpreter::PrintProfile()
+{
+	if( profile.instructions == 0 )
+	{
+		std::cout << "No profile for '" << progname << "', run it in Exec_Profile mode\n";
+		return;
+	}
+
+	std::cout << "Profile of '" << progname << "': " << profile.instructions << " instructions, " <<
+		profile.numsamples << " samples (every " << profile.interval << " instructions)\n";
+
+	std::cout << std::fixed << std::setprecision(1);
+
+	// functions (from the call stacks)
+	std::map<int, unsigned int> self;
+	std::map<int, unsigned int> total;
+	std::vector<std::pair<unsigned int, int> > order;
+
+	for( profile_desc::stackmap::iterator it = profile.stacks.begin(); it != profile.stacks.end(); ++it )
+	{
+		// recursive functions are counted once
+		std::set<int> seen(it->first.begin(), it->first.end());
+
+		for( std::set<int>::iterator jt = seen.begin(); jt != seen.end(); ++jt )
+			total[*jt] += it->second;
+
+		self[it->first.back()] += it->second;
+	}
+
+	for( std::map<int, unsigned int>::iterator it = total.begin(); it != total.end(); ++it )
+		order.push_back(std::make_pair(self[it->first], it->first));
+
+	std::sort(order.begin(), order.end(), Sort_By_Count<unsigned int>);
+
+	double numsamples = std::max<double>(profile.numsamples, 1);
+
+	std::cout << "\n   self%  total%  function\n";
+
+	for( size_t i = 0; i < order.size(); ++i )
+	{
+		std::cout << std::setw(8) << (order[i].first * 100.0 / numsamples) <<
+			std::setw(8) << (total[order[i].second] * 100.0 / numsamples) << "  " << Function_Name(order[i].second) << "\n";
+	}
+
+	// hottest source lines
+	std::map<int, unsigned long long> executions;
+	std::map<int, unsigned int> samples;
+	std::vector<std::pair<unsigned long long, int> > lines;
+	std::vector<std::string> source;
+	std::ifstream infile(progname.c_str());
+	std::string text;
+
+	while( std::getline(infile, text) )
+	{
+		text.erase(0, text.find_first_not_of(" \t"));
+		text.erase(text.find_last_not_of(" \t\r") + 1);
+
+		source.push_back(text);
+	}
+
+	for( size_t i = 0; i < profile.entries.size(); ++i )
+	{
+		int line = Source_Line(i * ENTRY_SIZE);
+
+		executions[line] += profile.entries[i];
+		samples[line] += profile.samples[i];
+	}
+
+	for( std::map<int, unsigned long long>::iterator it = executions.begin(); it != executions.end(); ++it )
+	{
+		if( it->second > 0 )
+			lines.push_back(std::make_pair(it->second, it->first));
+	}
+
+	std::sort(lines.begin(), lines.end(), Sort_By_Count<unsigned long long>);
+
+	if( lines.size() > MAX_PROFILE_LINES )
+		lines.resize(MAX_PROFILE_LINES);
+
+	std::cout << "\n    line  executions   samples  source\n";
+
+	for( size_t i = 0; i < lines.size(); ++i )
+	{
+		int line = lines[i].second;
+
+		std::cout << std::setw(8) << line << std::setw(12) << lines[i].first << std::setw(10) << samples[line] << "  ";
+
+		if( line > 0 && line <= (int)source.size() )
+			std::cout << source[line - 1] << "\n";
+		else
+			std::cout << "?\n";
+	}
+
+	// instruction mix
+	std::vector<std::pair<unsigned long long, int> > opcodes;
+
+	for( size_t i = 0; i < profile.opcodes.size(); ++i )
+	{
+		if( profile.opcodes[i] > 0 )
+			opcodes.push_back(std::make_pair((unsigned long long)profile.opcodes[i], (int)i));
+	}
+
+	std::sort(opcodes.begin(), opcodes.end(), Sort_By_Count<unsigned long long>);
+
+	std::cout << "\n  executions       %  opcode\n";
+
+	for( size_t i = 0; i < opcodes.size(); ++i )
+	{
+		std::cout << std::setw(12) << opcodes[i].first << std::setw(8) <<
+			(opcodes[i].first * 100.0 / (double)profile.instructions) << "  " << Opcode_Name(opcodes[i].second) << "\n";
+	}
+
+	std::cout.unsetf(std::ios::floatfield);
+	std::cout << std::setprecision(6);
+}
+
+bool Interpreter::SaveProfile(const std::string& file)
+{
+	// folded stacks (for flamegraph.pl and the like): main;foo;bar 42
+	assert(false, "Interpreter::SaveProfile(): No samples", profile.numsamples > 0);
+
+	std::ofstream outfile(file.c_str());
+	assert(false, "Interpreter::SaveProfile(): Could not create file", outfile);
+
+	for( profile_desc::stackmap::iterator it = profile.stacks.begin(); it != profile.stacks.end(); ++it )
+	{
+		for( size_t i = 0; i < it->first.size(); ++i )
+			outfile << (i > 0 ? ";" : "") << Function_Name(it->first[i]);
+
+		outfile << " " << it->second << "\n";
+	}
+
+	assert(false, "Interpreter::SaveProfile(): Could not write file", outfile);
+	return true;
+}
@@ -0,0 +1,47 @@
+
+int max(int a, int b)
+{
+	if( a < b ) {
+		return b;
+	}
+	
+	return a;
+}
+
+int sum(int n, int acc)
+{
+	if( n == 0 ) {
+		return acc;
+	}
+	
+	return sum(n - 1, acc + n);
+}
+
+int main()
+{
+	int i = 0;
+	int m = 0;
+	int s = 0;
+	
+	while( i < 100000 )
+	{
+		m = max(m, i % 1000);
+		++i;
+	}
+	
+	i = 0;
+	
+	while( i < 20 )
+	{
+		s = s + sum(5000, 0) % 1000;
+		++i;
+	}
+	
+	print "max: ";
+	print m;
+	print "\nsum: ";
+	print s;
+	print "\n";
+	
+	return 0;
+}
@@ -0,0 +1,30 @@
+
+int main()
+{
+	int verbose = 0;
+	int level = 3;
+	int i = 0;
+
+	if( verbose ) {
+		print "verbose output\n";
+	}
+
+	if( level > 2 && !verbose ) {
+		print "level is high\n";
+	} else {
+		print "level is low\n";
+	}
+
+	while( i < level ) {
+		if( verbose || level == 1 ) {
+			print "step ";
+		}
+
+		print i;
+		print "\n";
+
+		i = i + 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,13 @@
+int main()
+{
+	int a = 10;
+
+	print a / 2;
+	print "\n";
+
+	// the verifier reports this, the run stops here
+	print a % 0;
+	print "\n";
+
+	return 0;
+}
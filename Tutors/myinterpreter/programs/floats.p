@@ -0,0 +1,77 @@
+float square(float x)
+{
+	return x * x;
+}
+
+int mandelbrot(float cx, float cy, int limit)
+{
+	float x = 0.0;
+	float y = 0.0;
+	float t;
+	int i = 0;
+
+	while( i < limit && square(x) + square(y) <= 4 )
+	{
+		t = x * x - y * y + cx;
+		y = 2 * x * y + cy;
+		x = t;
+
+		++i;
+	}
+
+	return i;
+}
+
+float average(int sum, int count)
+{
+	return sum / (count * 1.0);
+}
+
+int main()
+{
+	float step = 0.0125;
+	int total = 0;
+	int row = 0;
+	int col;
+
+	while( row < 160 )
+	{
+		col = 0;
+
+		while( col < 240 )
+		{
+			total = total + mandelbrot(-2.0 + col * step, -1.0 + row * step, 100);
+			++col;
+		}
+
+		++row;
+	}
+
+	print "Mandelbrot iterations: ";
+	print total;
+	print "\n";
+
+	print "Average per point: ";
+	print average(total, 240 * 160);
+	print "\n";
+
+	// implicit conversions
+	float half = 7 / 2;
+	int whole = 2.75 * 4;
+
+	print "7 / 2 = ";
+	print half;
+	print ", 7 / 2.0 = ";
+	print 7 / 2.0;
+	print ", int(2.75 * 4) = ";
+	print whole;
+	print ", square(3) = ";
+	print square(3);
+	print "\n";
+
+	if( step && !(step > 1) ) {
+		print "step is a small nonzero number\n";
+	}
+
+	return 0;
+}
@@ -0,0 +1,20 @@
+int lkkt(int a, int b)
+{
+	return (a * b) / lnko(a, b);
+}
+
+int main()
+{
+	int a = 16;
+	int b = 28;
+	
+	print "The least common multiple of ";
+	print a;
+	print " and ";
+	print b;
+	print " is: ";
+	print lkkt(a, b);
+	print "\n";
+	
+	return 0;
+}
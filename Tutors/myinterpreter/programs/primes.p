@@ -0,0 +1,33 @@
+int is_prime(int n)
+{
+	int d = 2;
+	
+	while( d * d <= n )
+	{
+		if( n % d == 0 ) {
+			return 0;
+		}
+		
+		++d;
+	}
+	
+	return 1;
+}
+
+int main()
+{
+	int n = 2;
+	int count = 0;
+	
+	while( n < 100000 )
+	{
+		count = count + is_prime(n);
+		++n;
+	}
+	
+	print "Number of primes below 100000: ";
+	print count;
+	print "\n";
+	
+	return 0;
+}
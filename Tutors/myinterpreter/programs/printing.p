@@ -0,0 +1,15 @@
+int main()
+{
+	int i = 0;
+
+	// a million numbers, one per line
+	while( i < 1000000 )
+	{
+		print i - 500000;
+		print "\n";
+
+		++i;
+	}
+
+	return 0;
+}
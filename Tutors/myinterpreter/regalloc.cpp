@@ -0,0 +1,435 @@
+
+#include "interpreter.h"
+#include <algorithm>
+
+#define MAX_LOOP_DEPTH	4
+
+struct live_interval
+{
+	int offset;		// [EBP + offset]
+	int start;
+	int end;
+	int reg;
+	float weight;
+
+	live_interval()
+		: offset(0), start(INT_MAX), end(-1), reg(-1), weight(0) {}
+};
+
+typedef std::vector<live_interval> intervallist;
+
+static bool Sort_By_Start(const live_interval& a, const live_interval& b)
+{
+	return (a.start < b.start);
+}
+
+static bool Sort_By_Address(const symbol_desc* a, const symbol_desc* b)
+{
+	return (a->address < b->address);
+}
+
+static int Find_Slot(intervallist& slots, int offset)
+{
+	for( size_t i = 0; i < slots.size(); ++i )
+	{
+		if( slots[i].offset == offset )
+			return (int)i;
+	}
+
+	slots.push_back(live_interval());
+	slots.back().offset = offset;
+
+	return (int)slots.size() - 1;
+}
+
+static void Add_Reference(intervallist& slots, int offset, int index, float weight)
+{
+	live_interval& slot = slots[Find_Slot(slots, offset)];
+
+	slot.start = std::min(slot.start, index);
+	slot.end = std::max(slot.end, index);
+	slot.weight += weight;
+}
+
+static int Register_Of(const intervallist& slots, int offset)
+{
+	for( size_t i = 0; i < slots.size(); ++i )
+	{
+		if( slots[i].offset == offset )
+			return slots[i].reg;
+	}
+
+	return -1;
+}
+
+static void Allocate_Function(codelist& code, codelist& result, int start, int end, int numvregs, size_t& allocated, size_t& spilled)
+{
+	intervallist slots;
+	std::vector<int> depth(end - start, 0);
+	int prologue = -1;
+
+	// find the prologue (push EBP + mov EBP, ESP)
+	for( int i = start; i + 1 < end; ++i )
+	{
+		if( code[i].opcode == OP_PUSH && code[i].arg1 == EBP &&
+			code[i + 1].opcode == OP_MOV_RR && code[i + 1].arg1 == EBP && code[i + 1].arg2 == ESP )
+		{
+			prologue = i;
+			break;
+		}
+	}
+
+	if( prologue == -1 )
+	{
+		result.insert(result.end(), code.begin() + start, code.begin() + end);
+		return;
+	}
+
+	// loops are backward jumps
+	for( int i = start; i < end; ++i )
+	{
+		int target = code[i].target;
+
+		if( target >= start && target <= i )
+		{
+			for( int j = target; j <= i; ++j )
+				++depth[j - start];
+		}
+	}
+
+	// collect stack slots
+	for( int i = prologue + 2; i < end; ++i )
+	{
+		const code_entry& e = code[i];
+		float weight = (float)(1 << (3 * std::min(depth[i - start], MAX_LOOP_DEPTH)));
+
+		switch( e.opcode )
+		{
+		case OP_MOV_RM:
+			Add_Reference(slots, e.arg2, i, weight);
+			break;
+
+		case OP_MOV_MM:
+			Add_Reference(slots, e.arg2, i, weight);
+			Add_Reference(slots, e.arg1, i, weight);
+			break;
+
+		case OP_MOV_MR:
+		case OP_MOV_MS:
+		case OP_ADD_MS:
+			Add_Reference(slots, e.arg1, i, weight);
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	// arguments are live from the beginning
+	for( size_t i = 0; i < slots.size(); ++i )
+	{
+		if( slots[i].offset > 0 )
+			slots[i].start = prologue + 2;
+	}
+
+	// a slot used inside a loop is live in the whole loop
+	bool changed = true;
+
+	while( changed )
+	{
+		changed = false;
+
+		for( int i = start; i < end; ++i )
+		{
+			int target = code[i].target;
+
+			if( target < start || target > i )
+				continue;
+
+			for( size_t j = 0; j < slots.size(); ++j )
+			{
+				live_interval& slot = slots[j];
+
+				if( slot.start <= i && slot.end >= target && (slot.start > target || slot.end < i) )
+				{
+					slot.start = std::min(slot.start, target);
+					slot.end = std::max(slot.end, i);
+
+					changed = true;
+				}
+			}
+		}
+	}
+
+	// linear scan
+	std::vector<int> active;
+	std::vector<bool> used(numvregs, false);
+	std::vector<bool> saved(numvregs, false);
+
+	std::sort(slots.begin(), slots.end(), Sort_By_Start);
+
+	for( size_t i = 0; i < slots.size(); ++i )
+	{
+		live_interval& current = slots[i];
+
+		// expire old intervals
+		for( size_t j = 0; j < active.size(); )
+		{
+			if( slots[active[j]].end < current.start )
+			{
+				used[slots[active[j]].reg - FIRST_VREG] = false;
+				active.erase(active.begin() + j);
+			}
+			else
+				++j;
+		}
+
+		int reg = -1;
+
+		for( int j = 0; j < numvregs; ++j )
+		{
+			if( !used[j] )
+			{
+				reg = j;
+				break;
+			}
+		}
+
+		if( reg == -1 )
+		{
+			// spill the cheapest one
+			size_t cheapest = 0;
+
+			for( size_t j = 1; j < active.size(); ++j )
+			{
+				if( slots[active[j]].weight < slots[active[cheapest]].weight )
+					cheapest = j;
+			}
+
+			if( active.empty() || slots[active[cheapest]].weight >= current.weight )
+			{
+				++spilled;
+				continue;
+			}
+
+			live_interval& victim = slots[active[cheapest]];
+
+			reg = victim.reg - FIRST_VREG;
+			victim.reg = -1;
+
+			active.erase(active.begin() + cheapest);
+
+			++spilled;
+			--allocated;
+		}
+
+		current.reg = FIRST_VREG + reg;
+		used[reg] = true;
+		saved[reg] = true;
+
+		active.push_back((int)i);
+		++allocated;
+	}
+
+	// rewrite memory operands
+	int numsaved = 0;
+	bool locals = false;
+
+	for( int j = 0; j < numvregs; ++j )
+	{
+		if( saved[j] )
+			++numsaved;
+	}
+
+	for( int i = prologue + 2; i < end; ++i )
+	{
+		code_entry& e = code[i];
+		int reg1, reg2;
+
+		switch( e.opcode )
+		{
+		case OP_MOV_RM:
+			if( (reg2 = Register_Of(slots, e.arg2)) != -1 )
+			{
+				e.opcode = OP_MOV_RR;
+				e.arg2 = reg2;
+			}
+
+			break;
+
+		case OP_MOV_MR:
+			if( (reg1 = Register_Of(slots, e.arg1)) != -1 )
+			{
+				e.opcode = OP_MOV_RR;
+				e.arg1 = reg1;
+			}
+
+			break;
+
+		case OP_MOV_MM:
+			reg1 = Register_Of(slots, e.arg1);
+			reg2 = Register_Of(slots, e.arg2);
+
+			if( reg1 != -1 && reg2 != -1 )
+			{
+				e.opcode = OP_MOV_RR;
+				e.arg1 = reg1;
+				e.arg2 = reg2;
+			}
+			else if( reg1 != -1 )
+			{
+				e.opcode = OP_MOV_RM;
+				e.arg1 = reg1;
+			}
+			else if( reg2 != -1 )
+			{
+				e.opcode = OP_MOV_MR;
+				e.arg2 = reg2;
+			}
+
+			break;
+
+		case OP_MOV_MS:
+			if( (reg1 = Register_Of(slots, e.arg1)) != -1 )
+			{
+				e.opcode = OP_MOV_RS;
+				e.arg1 = reg1;
+			}
+
+			break;
+
+		case OP_ADD_MS:
+			if( (reg1 = Register_Of(slots, e.arg1)) != -1 )
+			{
+				e.opcode = OP_ADD_RS;
+				e.arg1 = reg1;
+			}
+
+			break;
+
+		default:
+			continue;
+		}
+
+		// saved registers are between the return address and EBP
+		switch( e.opcode )
+		{
+		case OP_MOV_RM:
+			locals |= (e.arg2 < 0);
+
+			if( e.arg2 > 0 )
+				e.arg2 += numsaved * 4;
+
+			break;
+
+		case OP_MOV_MR:
+		case OP_MOV_MS:
+		case OP_ADD_MS:
+			locals |= (e.arg1 < 0);
+
+			if( e.arg1 > 0 )
+				e.arg1 += numsaved * 4;
+
+			break;
+
+		case OP_MOV_MM:
+			locals |= (e.arg1 < 0 || e.arg2 < 0);
+
+			if( e.arg1 > 0 )
+				e.arg1 += numsaved * 4;
+
+			if( e.arg2 > 0 )
+				e.arg2 += numsaved * 4;
+
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	// emit the function
+	for( int i = start; i < end; ++i )
+	{
+		code_entry e = code[i];
+
+		if( !locals && (e.opcode == OP_SUB_RS || e.opcode == OP_ADD_RS) && e.arg1 == ESP )
+			e.removed = true;
+
+		if( i == prologue && numsaved > 0 )
+		{
+			// push callee saved registers
+			for( int j = 0; j < numvregs; ++j )
+			{
+				if( saved[j] )
+				{
+					result.push_back(code_entry(OP_PUSH, FIRST_VREG + j, NIL));
+
+					result.back().label = e.label;
+					result.back().line = e.line;
+					e.label = -1;
+				}
+			}
+		}
+
+		if( e.opcode == OP_POP && e.arg1 == EIP && numsaved > 0 && i > start &&
+			code[i - 1].opcode == OP_POP && code[i - 1].arg1 == EBP )
+		{
+			// pop them before returning
+			for( int j = numvregs - 1; j >= 0; --j )
+			{
+				if( saved[j] )
+				{
+					result.push_back(code_entry(OP_POP, FIRST_VREG + j, NIL));
+
+					result.back().label = e.label;
+					e.label = -1;
+				}
+			}
+		}
+
+		result.push_back(e);
+
+		if( i == prologue + 1 )
+		{
+			// load arguments
+			for( size_t j = 0; j < slots.size(); ++j )
+			{
+				if( slots[j].offset > 0 && slots[j].reg != -1 )
+					result.push_back(code_entry(OP_MOV_RM, slots[j].reg, slots[j].offset + numsaved * 4));
+			}
+		}
+	}
+}
+
+bool Interpreter::AllocateRegisters()
+{
+	// NOTE: call it once, before Link()
+	codelist code;
+	codelist result;
+	std::vector<symbol_desc*> funcs(functions.begin(), functions.end());
+	size_t allocated = 0;
+	size_t spilled = 0;
+	int numvregs = (int)numregisters - FIRST_VREG;
+
+	if( functions.empty() || numvregs <= 0 || !Decode(code) || code.empty() )
+		return false;
+
+	std::sort(funcs.begin(), funcs.end(), Sort_By_Address);
+
+	if( !funcs.empty() )
+		result.insert(result.end(), code.begin(), code.begin() + funcs[0]->address / ENTRY_SIZE);
+
+	for( size_t i = 0; i < funcs.size(); ++i )
+	{
+		int start = funcs[i]->address / ENTRY_SIZE;
+		int end = (i + 1 < funcs.size() ? funcs[i + 1]->address / ENTRY_SIZE : (int)code.size());
+
+		Allocate_Function(code, result, start, end, numvregs, allocated, spilled);
+	}
+
+	Encode(result);
+
+	std::cout << "Register allocator: " << allocated << " variables in registers, " << spilled << " spilled\n";
+	return true;
+}
@@ -1,19 +1,24 @@
 
 #include "interpreter.h"
-#include <iostream>
 
-extern Interpreter* interpreter;
+void Interpreter::Print_Reg(int arg1, int arg2)
+{
+	running->output.Write(running->registers[arg1]);
+}
 
-void Interpreter::Print_Reg(void* arg1, void* arg2)
+void Interpreter::Print_Memory(int arg1, int arg2)
 {
-	int reg = reinterpret_cast<int>(arg1);
-	std::cout << interpreter->registers[reg];
+	running->output.Write(running->program->strings[arg1]);
 }
 
-void Interpreter::Print_Memory(void* arg1, void* arg2)
+void Interpreter::Print_Float(int arg1, int arg2)
 {
-	std::string* str = reinterpret_cast<std::string*>(arg1);
+	running->output.Write(Bits_To_Float(running->registers[arg1]));
+}
 
-	if( str )
-		std::cout << *str;
+void Interpreter::Flush_Output()
+{
+	// keeps the program output before the error messages
+	if( running )
+		running->output.Flush();
 }
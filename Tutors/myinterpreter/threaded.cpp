@@ -0,0 +1,861 @@
+
+#include "interpreter.h"
+#include <cstring>
+
+// GCC and clang can jump to label addresses, the rest
+// of the world gets a switch over the predecoded handlers
+#if defined(__GNUC__)
+#	define THREADED_GOTO
+#endif
+
+#ifdef THREADED_GOTO
+#	define HANDLER(x)	&&lbl_##x
+#	define TARGET(x)	lbl_##x:
+#	define DISPATCH()	goto *ip->handler
+#else
+#	define HANDLER(x)	(const void*)(size_t)(x)
+#	define TARGET(x)	case x:
+#	define DISPATCH()	goto dispatch
+#endif
+
+#define NEXT()			{ ++ip; DISPATCH(); }
+#define SET_JZ()		{ ++ip; if( REG1 == 0 ) { ip = (const instruction*)ip->arg2.p; DISPATCH(); } NEXT(); }
+#define REG1			reg[ip->arg1.i]
+#define REG2			reg[ip->arg2.i]
+#define MEM(o)			*((int*)(stk + reg[EBP] + (o)))
+
+enum handler_id
+{
+	H_HALT = 0,
+	H_NOP,
+	H_SPECIAL,
+	H_PUSH,
+	H_PUSHI,	// push constant (return address)
+	H_PUSHADD,
+	H_POP,
+	H_RET,		// pop EIP
+	H_MOV_RS,
+	H_MOV_RR,
+	H_MOV_RM,
+	H_MOV_MR,
+	H_MOV_MM,
+	H_MOV_MS,
+	H_ADD_MS,
+	H_AND_RS,
+	H_AND_RR,
+	H_OR_RS,
+	H_OR_RR,
+	H_NOT,
+	H_SUB_RS,
+	H_SUB_RR,
+	H_ADD_RS,
+	H_ADD_RR,
+	H_MUL_RS,
+	H_MUL_RR,
+	H_DIV_RS,
+	H_DIV_RR,
+	H_MOD_RS,
+	H_MOD_RR,
+	H_NEG,
+	H_SETL_RS,
+	H_SETL_RR,
+	H_SETLE_RS,
+	H_SETLE_RR,
+	H_SETG_RS,
+	H_SETG_RR,
+	H_SETGE_RS,
+	H_SETGE_RR,
+	H_SETE_RS,
+	H_SETE_RR,
+	H_SETNE_RS,
+	H_SETNE_RR,
+	H_FSUB_RS,
+	H_FSUB_RR,
+	H_FADD_RS,
+	H_FADD_RR,
+	H_FMUL_RS,
+	H_FMUL_RR,
+	H_FDIV_RS,
+	H_FDIV_RR,
+	H_FNEG,
+	H_CVT_IF,
+	H_CVT_FI,
+	H_FSETL_RS,
+	H_FSETL_RR,
+	H_FSETLE_RS,
+	H_FSETLE_RR,
+	H_FSETG_RS,
+	H_FSETG_RR,
+	H_FSETGE_RS,
+	H_FSETGE_RR,
+	H_FSETE_RS,
+	H_FSETE_RR,
+	H_FSETNE_RS,
+	H_FSETNE_RR,
+	H_JZ,
+	H_JNZ,
+	H_JMP,
+	H_SETL_JZ_RS,
+	H_SETL_JZ_RR,
+	H_SETLE_JZ_RS,
+	H_SETLE_JZ_RR,
+	H_SETG_JZ_RS,
+	H_SETG_JZ_RR,
+	H_SETGE_JZ_RS,
+	H_SETGE_JZ_RR,
+	H_SETE_JZ_RS,
+	H_SETE_JZ_RR,
+	H_SETNE_JZ_RS,
+	H_SETNE_JZ_RR,
+
+	NUM_HANDLERS
+};
+
+static int Handler_Index(unsigned char opcode)
+{
+	switch( opcode )
+	{
+	case OP_PUSH:		return H_PUSH;
+	case OP_PUSHADD:	return H_PUSHADD;
+	case OP_POP:		return H_POP;
+	case OP_MOV_RS:		return H_MOV_RS;
+	case OP_MOV_RR:		return H_MOV_RR;
+	case OP_MOV_RM:		return H_MOV_RM;
+	case OP_MOV_MR:		return H_MOV_MR;
+	case OP_MOV_MM:		return H_MOV_MM;
+	case OP_MOV_MS:		return H_MOV_MS;
+	case OP_ADD_MS:		return H_ADD_MS;
+	case OP_AND_RS:		return H_AND_RS;
+	case OP_AND_RR:		return H_AND_RR;
+	case OP_OR_RS:		return H_OR_RS;
+	case OP_OR_RR:		return H_OR_RR;
+	case OP_NOT:		return H_NOT;
+	case OP_SUB_RS:		return H_SUB_RS;
+	case OP_SUB_RR:		return H_SUB_RR;
+	case OP_ADD_RS:		return H_ADD_RS;
+	case OP_ADD_RR:		return H_ADD_RR;
+	case OP_MUL_RS:		return H_MUL_RS;
+	case OP_MUL_RR:		return H_MUL_RR;
+	case OP_DIV_RS:		return H_DIV_RS;
+	case OP_DIV_RR:		return H_DIV_RR;
+	case OP_MOD_RS:		return H_MOD_RS;
+	case OP_MOD_RR:		return H_MOD_RR;
+	case OP_NEG:		return H_NEG;
+	case OP_SETL_RS:	return H_SETL_RS;
+	case OP_SETL_RR:	return H_SETL_RR;
+	case OP_SETLE_RS:	return H_SETLE_RS;
+	case OP_SETLE_RR:	return H_SETLE_RR;
+	case OP_SETG_RS:	return H_SETG_RS;
+	case OP_SETG_RR:	return H_SETG_RR;
+	case OP_SETGE_RS:	return H_SETGE_RS;
+	case OP_SETGE_RR:	return H_SETGE_RR;
+	case OP_SETE_RS:	return H_SETE_RS;
+	case OP_SETE_RR:	return H_SETE_RR;
+	case OP_SETNE_RS:	return H_SETNE_RS;
+	case OP_SETNE_RR:	return H_SETNE_RR;
+	case OP_FSUB_RS:	return H_FSUB_RS;
+	case OP_FSUB_RR:	return H_FSUB_RR;
+	case OP_FADD_RS:	return H_FADD_RS;
+	case OP_FADD_RR:	return H_FADD_RR;
+	case OP_FMUL_RS:	return H_FMUL_RS;
+	case OP_FMUL_RR:	return H_FMUL_RR;
+	case OP_FDIV_RS:	return H_FDIV_RS;
+	case OP_FDIV_RR:	return H_FDIV_RR;
+	case OP_FNEG:		return H_FNEG;
+	case OP_CVT_IF:		return H_CVT_IF;
+	case OP_CVT_FI:		return H_CVT_FI;
+	case OP_FSETL_RS:	return H_FSETL_RS;
+	case OP_FSETL_RR:	return H_FSETL_RR;
+	case OP_FSETLE_RS:	return H_FSETLE_RS;
+	case OP_FSETLE_RR:	return H_FSETLE_RR;
+	case OP_FSETG_RS:	return H_FSETG_RS;
+	case OP_FSETG_RR:	return H_FSETG_RR;
+	case OP_FSETGE_RS:	return H_FSETGE_RS;
+	case OP_FSETGE_RR:	return H_FSETGE_RR;
+	case OP_FSETE_RS:	return H_FSETE_RS;
+	case OP_FSETE_RR:	return H_FSETE_RR;
+	case OP_FSETNE_RS:	return H_FSETNE_RS;
+	case OP_FSETNE_RR:	return H_FSETNE_RR;
+	case OP_JZ:			return H_JZ;
+	case OP_JNZ:		return H_JNZ;
+	case OP_JMP:		return H_JMP;
+	case OP_SETL_JZ_RS:		return H_SETL_JZ_RS;
+	case OP_SETL_JZ_RR:		return H_SETL_JZ_RR;
+	case OP_SETLE_JZ_RS:	return H_SETLE_JZ_RS;
+	case OP_SETLE_JZ_RR:	return H_SETLE_JZ_RR;
+	case OP_SETG_JZ_RS:		return H_SETG_JZ_RS;
+	case OP_SETG_JZ_RR:		return H_SETG_JZ_RR;
+	case OP_SETGE_JZ_RS:	return H_SETGE_JZ_RS;
+	case OP_SETGE_JZ_RR:	return H_SETGE_JZ_RR;
+	case OP_SETE_JZ_RS:		return H_SETE_JZ_RS;
+	case OP_SETE_JZ_RR:		return H_SETE_JZ_RR;
+	case OP_SETNE_JZ_RS:	return H_SETNE_JZ_RS;
+	case OP_SETNE_JZ_RR:	return H_SETNE_JZ_RR;
+
+	default:
+		break;
+	}
+
+	return H_NOP;
+}
+
+bool Interpreter::Predecode(const void* const* handlers)
+{
+	size_t bytesize = program.size();
+	size_t count = bytesize / ENTRY_SIZE;
+
+	char* bytecode = program.data();
+	char* ptr;
+
+	instruction* ins;
+	unsigned char opcode;
+	int index, arg1, arg2, target;
+
+	assert(false, "Interpreter::Predecode(): Program size is not a multiple of ENTRY_SIZE", (bytesize % ENTRY_SIZE) == 0);
+	assert(false, "Interpreter::Predecode(): Invalid entry point", (entry >= 0 && (entry % ENTRY_SIZE) == 0));
+
+	// last one is a halt, so jumps out of the program need no checks
+	decoded.resize(count + 1);
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		ptr = (bytecode + i * ENTRY_SIZE);
+		ins = &decoded[i];
+
+		opcode = *((unsigned char*)ptr);
+		arg1 = ARG1_INT(ptr);
+		arg2 = ARG2_INT(ptr);
+
+		ins->opcode = opcode;
+		ins->arg1.i = arg1;
+		ins->arg2.i = arg2;
+
+		if( opcode < 0x20 )
+		{
+			nassert(false, "Interpreter::Predecode(): Unknown special statement", opcode >= NUM_SPECIAL);
+
+			ins->handler = handlers[H_SPECIAL];
+
+			continue;
+		}
+
+		index = Handler_Index(opcode);
+
+		switch( opcode )
+		{
+		case OP_PUSH:
+		case OP_PUSHADD:
+			// the return address is known in advance
+			if( arg1 == EIP )
+			{
+				index = H_PUSHI;
+				ins->arg1.i = (int)((i + 1) * ENTRY_SIZE) + (opcode == OP_PUSHADD ? arg2 : 0);
+			}
+			break;
+
+		case OP_POP:
+			if( arg1 == EIP )
+				index = H_RET;
+			break;
+
+		case OP_MOV_RR:
+			nassert(false, "Interpreter::Predecode(): Can't predecode write to EIP", arg1 == EIP);
+
+			if( arg2 == EIP )
+			{
+				index = H_MOV_RS;
+				ins->arg2.i = (int)((i + 1) * ENTRY_SIZE);
+			}
+			break;
+
+		case OP_JZ:
+		case OP_JNZ:
+		case OP_JMP:
+			target = (int)((i + 1) * ENTRY_SIZE) + (opcode == OP_JMP ? arg1 : arg2);
+
+			nassert(false, "Interpreter::Predecode(): Jump before program start", target < 0);
+			nassert(false, "Interpreter::Predecode(): Misaligned jump target", (target % ENTRY_SIZE) != 0);
+
+			if( (size_t)target > bytesize )
+				target = (int)bytesize;
+
+			if( opcode == OP_JMP )
+				ins->arg1.p = &decoded[target / ENTRY_SIZE];
+			else
+				ins->arg2.p = &decoded[target / ENTRY_SIZE];
+
+			break;
+
+		case OP_MOV_RM:
+			nassert(false, "Interpreter::Predecode(): Can't predecode write to EIP", arg1 == EIP);
+			break;
+
+		case OP_MOV_MR:
+		case OP_MOV_MM:
+			nassert(false, "Interpreter::Predecode(): Can't predecode access to EIP", opcode == OP_MOV_MR && arg2 == EIP);
+			break;
+
+		case OP_AND_RR:
+		case OP_OR_RR:
+		case OP_SUB_RR:
+		case OP_ADD_RR:
+		case OP_MUL_RR:
+		case OP_DIV_RR:
+		case OP_MOD_RR:
+		case OP_SETL_RR:
+		case OP_SETLE_RR:
+		case OP_SETG_RR:
+		case OP_SETGE_RR:
+		case OP_SETE_RR:
+		case OP_SETNE_RR:
+		case OP_FSUB_RR:
+		case OP_FADD_RR:
+		case OP_FMUL_RR:
+		case OP_FDIV_RR:
+		case OP_FSETL_RR:
+		case OP_FSETLE_RR:
+		case OP_FSETG_RR:
+		case OP_FSETGE_RR:
+		case OP_FSETE_RR:
+		case OP_FSETNE_RR:
+		case OP_SETL_JZ_RR:
+		case OP_SETLE_JZ_RR:
+		case OP_SETG_JZ_RR:
+		case OP_SETGE_JZ_RR:
+		case OP_SETE_JZ_RR:
+		case OP_SETNE_JZ_RR:
+			// EIP is not kept in the register file while running
+			nassert(false, "Interpreter::Predecode(): Can't predecode arithmetic on EIP", arg1 == EIP || arg2 == EIP);
+			break;
+
+		default:
+			nassert(false, "Interpreter::Predecode(): Can't predecode arithmetic on EIP", index != H_NOP && arg1 == EIP);
+			break;
+		}
+
+		if( index >= H_SETL_JZ_RS )
+		{
+			char* next = ptr + ENTRY_SIZE;
+
+			nassert(false, "Interpreter::Predecode(): Fused instruction must be followed by jz",
+				(i + 1) >= count || *((unsigned char*)next) != OP_JZ || ARG1_INT(next) != arg1);
+		}
+
+		ins->handler = handlers[index];
+	}
+
+	decoded[count].handler = handlers[H_HALT];
+	decoded[count].opcode = 0xff;
+	decoded[count].arg1.i = decoded[count].arg2.i = 0;
+
+	return true;
+}
+
+bool Interpreter::Run_Threaded(vm_context& ctx)
+{
+	int* registers = ctx.registers;
+	char* stack = ctx.stack;
+
+	static const void* handlers[NUM_HANDLERS] =
+	{
+		HANDLER(H_HALT),
+		HANDLER(H_NOP),
+		HANDLER(H_SPECIAL),
+		HANDLER(H_PUSH),
+		HANDLER(H_PUSHI),
+		HANDLER(H_PUSHADD),
+		HANDLER(H_POP),
+		HANDLER(H_RET),
+		HANDLER(H_MOV_RS),
+		HANDLER(H_MOV_RR),
+		HANDLER(H_MOV_RM),
+		HANDLER(H_MOV_MR),
+		HANDLER(H_MOV_MM),
+		HANDLER(H_MOV_MS),
+		HANDLER(H_ADD_MS),
+		HANDLER(H_AND_RS),
+		HANDLER(H_AND_RR),
+		HANDLER(H_OR_RS),
+		HANDLER(H_OR_RR),
+		HANDLER(H_NOT),
+		HANDLER(H_SUB_RS),
+		HANDLER(H_SUB_RR),
+		HANDLER(H_ADD_RS),
+		HANDLER(H_ADD_RR),
+		HANDLER(H_MUL_RS),
+		HANDLER(H_MUL_RR),
+		HANDLER(H_DIV_RS),
+		HANDLER(H_DIV_RR),
+		HANDLER(H_MOD_RS),
+		HANDLER(H_MOD_RR),
+		HANDLER(H_NEG),
+		HANDLER(H_SETL_RS),
+		HANDLER(H_SETL_RR),
+		HANDLER(H_SETLE_RS),
+		HANDLER(H_SETLE_RR),
+		HANDLER(H_SETG_RS),
+		HANDLER(H_SETG_RR),
+		HANDLER(H_SETGE_RS),
+		HANDLER(H_SETGE_RR),
+		HANDLER(H_SETE_RS),
+		HANDLER(H_SETE_RR),
+		HANDLER(H_SETNE_RS),
+		HANDLER(H_SETNE_RR),
+		HANDLER(H_FSUB_RS),
+		HANDLER(H_FSUB_RR),
+		HANDLER(H_FADD_RS),
+		HANDLER(H_FADD_RR),
+		HANDLER(H_FMUL_RS),
+		HANDLER(H_FMUL_RR),
+		HANDLER(H_FDIV_RS),
+		HANDLER(H_FDIV_RR),
+		HANDLER(H_FNEG),
+		HANDLER(H_CVT_IF),
+		HANDLER(H_CVT_FI),
+		HANDLER(H_FSETL_RS),
+		HANDLER(H_FSETL_RR),
+		HANDLER(H_FSETLE_RS),
+		HANDLER(H_FSETLE_RR),
+		HANDLER(H_FSETG_RS),
+		HANDLER(H_FSETG_RR),
+		HANDLER(H_FSETGE_RS),
+		HANDLER(H_FSETGE_RR),
+		HANDLER(H_FSETE_RS),
+		HANDLER(H_FSETE_RR),
+		HANDLER(H_FSETNE_RS),
+		HANDLER(H_FSETNE_RR),
+		HANDLER(H_JZ),
+		HANDLER(H_JNZ),
+		HANDLER(H_JMP),
+		HANDLER(H_SETL_JZ_RS),
+		HANDLER(H_SETL_JZ_RR),
+		HANDLER(H_SETLE_JZ_RS),
+		HANDLER(H_SETLE_JZ_RR),
+		HANDLER(H_SETG_JZ_RS),
+		HANDLER(H_SETG_JZ_RR),
+		HANDLER(H_SETGE_JZ_RS),
+		HANDLER(H_SETGE_JZ_RR),
+		HANDLER(H_SETE_JZ_RS),
+		HANDLER(H_SETE_JZ_RR),
+		HANDLER(H_SETNE_JZ_RS),
+		HANDLER(H_SETNE_JZ_RR)
+	};
+
+	// first run predecodes, the others wait for it
+	prepareguard.Lock();
+
+	bool ready = (!decoded.empty() || Predecode(handlers));
+
+	if( !ready )
+		decoded.clear();
+
+	prepareguard.Unlock();
+
+	if( !ready )
+	{
+		warn("Interpreter::Run(): Predecoding failed, falling back to switch dispatch");
+		return Run_Switch(ctx);
+	}
+
+	memset(registers, 0, numregisters * sizeof(int));
+
+	registers[EBP] = STACK_SIZE;
+	registers[ESP] = STACK_SIZE;
+
+	int* reg = registers;
+	char* stk = stack;
+	const instruction* code = &decoded[0];
+	const instruction* ip = code + (entry / ENTRY_SIZE);
+	size_t bytesize = program.size();
+	size_t stackdepth = 0;
+	int value;
+
+#ifdef THREADED_GOTO
+	DISPATCH();
+#else
+dispatch:
+	switch( (size_t)ip->handler )
+	{
+#endif
+
+	TARGET(H_SPECIAL)
+		(*op_special[ip->opcode])(ip->arg1.i, ip->arg2.i);
+		NEXT();
+
+	TARGET(H_PUSH)
+		nassert(false, "EXCEPTION: Stack overflow", reg[ESP] < 4);
+
+		reg[ESP] -= 4;
+		*((int*)(stk + reg[ESP])) = REG1;
+
+		++stackdepth;
+		NEXT();
+
+	TARGET(H_PUSHI)
+		nassert(false, "EXCEPTION: Stack overflow", reg[ESP] < 4);
+
+		reg[ESP] -= 4;
+		*((int*)(stk + reg[ESP])) = ip->arg1.i;
+
+		++stackdepth;
+		NEXT();
+
+	TARGET(H_PUSHADD)
+		nassert(false, "EXCEPTION: Stack overflow", reg[ESP] < 4);
+
+		reg[ESP] -= 4;
+		*((int*)(stk + reg[ESP])) = REG1 + ip->arg2.i;
+
+		++stackdepth;
+		NEXT();
+
+	TARGET(H_POP)
+		nassert(false, "EXCEPTION: Stack underflow", stackdepth == 0);
+
+		REG1 = *((int*)(stk + reg[ESP]));
+		reg[ESP] += 4;
+
+		--stackdepth;
+		NEXT();
+
+	TARGET(H_RET)
+		nassert(false, "EXCEPTION: Stack underflow", stackdepth == 0);
+
+		value = *((int*)(stk + reg[ESP]));
+		reg[ESP] += 4;
+
+		--stackdepth;
+
+		// same as the switch loop: anything outside the code stops execution
+		if( value < 0 || (size_t)value >= bytesize )
+			goto halt;
+
+		ip = code + (value / ENTRY_SIZE);
+		DISPATCH();
+
+	TARGET(H_MOV_RS)
+		REG1 = ip->arg2.i;
+		NEXT();
+
+	TARGET(H_MOV_RR)
+		REG1 = REG2;
+		NEXT();
+
+	TARGET(H_MOV_RM)
+		REG1 = MEM(ip->arg2.i);
+		NEXT();
+
+	TARGET(H_MOV_MR)
+		MEM(ip->arg1.i) = REG2;
+		NEXT();
+
+	TARGET(H_MOV_MM)
+		MEM(ip->arg1.i) = MEM(ip->arg2.i);
+		NEXT();
+
+	TARGET(H_MOV_MS)
+		MEM(ip->arg1.i) = ip->arg2.i;
+		NEXT();
+
+	TARGET(H_ADD_MS)
+		MEM(ip->arg1.i) += ip->arg2.i;
+		NEXT();
+
+	TARGET(H_AND_RS)
+		REG1 = (REG1 && ip->arg2.i);
+		NEXT();
+
+	TARGET(H_AND_RR)
+		REG1 = (REG1 && REG2);
+		NEXT();
+
+	TARGET(H_OR_RS)
+		REG1 = (REG1 || ip->arg2.i);
+		NEXT();
+
+	TARGET(H_OR_RR)
+		REG1 = (REG1 || REG2);
+		NEXT();
+
+	TARGET(H_NOT)
+		REG1 = (REG1 == 0);
+		NEXT();
+
+	TARGET(H_SUB_RS)
+		REG1 -= ip->arg2.i;
+		NEXT();
+
+	TARGET(H_SUB_RR)
+		REG1 -= REG2;
+		NEXT();
+
+	TARGET(H_ADD_RS)
+		REG1 += ip->arg2.i;
+		NEXT();
+
+	TARGET(H_ADD_RR)
+		REG1 += REG2;
+		NEXT();
+
+	TARGET(H_MUL_RS)
+		REG1 *= ip->arg2.i;
+		NEXT();
+
+	TARGET(H_MUL_RR)
+		REG1 *= REG2;
+		NEXT();
+
+	TARGET(H_DIV_RS)
+		nassert(false, "EXCEPTION: Division by zero", ip->arg2.i == 0);
+
+		REG1 /= ip->arg2.i;
+		NEXT();
+
+	TARGET(H_DIV_RR)
+		nassert(false, "EXCEPTION: Division by zero", REG2 == 0);
+
+		REG1 /= REG2;
+		NEXT();
+
+	TARGET(H_MOD_RS)
+		nassert(false, "EXCEPTION: Division by zero", ip->arg2.i == 0);
+
+		REG1 %= ip->arg2.i;
+		NEXT();
+
+	TARGET(H_MOD_RR)
+		nassert(false, "EXCEPTION: Division by zero", REG2 == 0);
+
+		REG1 %= REG2;
+		NEXT();
+
+	TARGET(H_NEG)
+		REG1 = -REG1;
+		NEXT();
+
+	TARGET(H_SETL_RS)
+		REG1 = (REG1 < ip->arg2.i);
+		NEXT();
+
+	TARGET(H_SETL_RR)
+		REG1 = (REG1 < REG2);
+		NEXT();
+
+	TARGET(H_SETLE_RS)
+		REG1 = (REG1 <= ip->arg2.i);
+		NEXT();
+
+	TARGET(H_SETLE_RR)
+		REG1 = (REG1 <= REG2);
+		NEXT();
+
+	TARGET(H_SETG_RS)
+		REG1 = (REG1 > ip->arg2.i);
+		NEXT();
+
+	TARGET(H_SETG_RR)
+		REG1 = (REG1 > REG2);
+		NEXT();
+
+	TARGET(H_SETGE_RS)
+		REG1 = (REG1 >= ip->arg2.i);
+		NEXT();
+
+	TARGET(H_SETGE_RR)
+		REG1 = (REG1 >= REG2);
+		NEXT();
+
+	TARGET(H_SETE_RS)
+		REG1 = (REG1 == ip->arg2.i);
+		NEXT();
+
+	TARGET(H_SETE_RR)
+		REG1 = (REG1 == REG2);
+		NEXT();
+
+	TARGET(H_SETNE_RS)
+		REG1 = (REG1 != ip->arg2.i);
+		NEXT();
+
+	TARGET(H_SETNE_RR)
+		REG1 = (REG1 != REG2);
+		NEXT();
+
+	TARGET(H_FSUB_RS)
+		REG1 = FLOAT_OP(REG1, -, ip->arg2.i);
+		NEXT();
+
+	TARGET(H_FSUB_RR)
+		REG1 = FLOAT_OP(REG1, -, REG2);
+		NEXT();
+
+	TARGET(H_FADD_RS)
+		REG1 = FLOAT_OP(REG1, +, ip->arg2.i);
+		NEXT();
+
+	TARGET(H_FADD_RR)
+		REG1 = FLOAT_OP(REG1, +, REG2);
+		NEXT();
+
+	TARGET(H_FMUL_RS)
+		REG1 = FLOAT_OP(REG1, *, ip->arg2.i);
+		NEXT();
+
+	TARGET(H_FMUL_RR)
+		REG1 = FLOAT_OP(REG1, *, REG2);
+		NEXT();
+
+	TARGET(H_FDIV_RS)
+		REG1 = FLOAT_OP(REG1, /, ip->arg2.i);
+		NEXT();
+
+	TARGET(H_FDIV_RR)
+		REG1 = FLOAT_OP(REG1, /, REG2);
+		NEXT();
+
+	TARGET(H_FNEG)
+		REG1 ^= INT_MIN;
+		NEXT();
+
+	TARGET(H_CVT_IF)
+		REG1 = Float_To_Bits((float)REG1);
+		NEXT();
+
+	TARGET(H_CVT_FI)
+		REG1 = (int)Bits_To_Float(REG1);
+		NEXT();
+
+	TARGET(H_FSETL_RS)
+		REG1 = FLOAT_CMP(REG1, <, ip->arg2.i);
+		NEXT();
+
+	TARGET(H_FSETL_RR)
+		REG1 = FLOAT_CMP(REG1, <, REG2);
+		NEXT();
+
+	TARGET(H_FSETLE_RS)
+		REG1 = FLOAT_CMP(REG1, <=, ip->arg2.i);
+		NEXT();
+
+	TARGET(H_FSETLE_RR)
+		REG1 = FLOAT_CMP(REG1, <=, REG2);
+		NEXT();
+
+	TARGET(H_FSETG_RS)
+		REG1 = FLOAT_CMP(REG1, >, ip->arg2.i);
+		NEXT();
+
+	TARGET(H_FSETG_RR)
+		REG1 = FLOAT_CMP(REG1, >, REG2);
+		NEXT();
+
+	TARGET(H_FSETGE_RS)
+		REG1 = FLOAT_CMP(REG1, >=, ip->arg2.i);
+		NEXT();
+
+	TARGET(H_FSETGE_RR)
+		REG1 = FLOAT_CMP(REG1, >=, REG2);
+		NEXT();
+
+	TARGET(H_FSETE_RS)
+		REG1 = FLOAT_CMP(REG1, ==, ip->arg2.i);
+		NEXT();
+
+	TARGET(H_FSETE_RR)
+		REG1 = FLOAT_CMP(REG1, ==, REG2);
+		NEXT();
+
+	TARGET(H_FSETNE_RS)
+		REG1 = FLOAT_CMP(REG1, !=, ip->arg2.i);
+		NEXT();
+
+	TARGET(H_FSETNE_RR)
+		REG1 = FLOAT_CMP(REG1, !=, REG2);
+		NEXT();
+
+	TARGET(H_JZ)
+		if( REG1 == 0 )
+		{
+			ip = (const instruction*)ip->arg2.p;
+			DISPATCH();
+		}
+
+		NEXT();
+
+	TARGET(H_JNZ)
+		if( REG1 != 0 )
+		{
+			ip = (const instruction*)ip->arg2.p;
+			DISPATCH();
+		}
+
+		NEXT();
+
+	TARGET(H_JMP)
+		ip = (const instruction*)ip->arg1.p;
+		DISPATCH();
+
+	TARGET(H_SETL_JZ_RS)
+		REG1 = (REG1 < ip->arg2.i);
+		SET_JZ();
+
+	TARGET(H_SETL_JZ_RR)
+		REG1 = (REG1 < REG2);
+		SET_JZ();
+
+	TARGET(H_SETLE_JZ_RS)
+		REG1 = (REG1 <= ip->arg2.i);
+		SET_JZ();
+
+	TARGET(H_SETLE_JZ_RR)
+		REG1 = (REG1 <= REG2);
+		SET_JZ();
+
+	TARGET(H_SETG_JZ_RS)
+		REG1 = (REG1 > ip->arg2.i);
+		SET_JZ();
+
+	TARGET(H_SETG_JZ_RR)
+		REG1 = (REG1 > REG2);
+		SET_JZ();
+
+	TARGET(H_SETGE_JZ_RS)
+		REG1 = (REG1 >= ip->arg2.i);
+		SET_JZ();
+
+	TARGET(H_SETGE_JZ_RR)
+		REG1 = (REG1 >= REG2);
+		SET_JZ();
+
+	TARGET(H_SETE_JZ_RS)
+		REG1 = (REG1 == ip->arg2.i);
+		SET_JZ();
+
+	TARGET(H_SETE_JZ_RR)
+		REG1 = (REG1 == REG2);
+		SET_JZ();
+
+	TARGET(H_SETNE_JZ_RS)
+		REG1 = (REG1 != ip->arg2.i);
+		SET_JZ();
+
+	TARGET(H_SETNE_JZ_RR)
+		REG1 = (REG1 != REG2);
+		SET_JZ();
+
+	TARGET(H_NOP)
+		NEXT();
+
+	TARGET(H_HALT)
+		goto halt;
+
+#ifndef THREADED_GOTO
+	default:
+		goto halt;
+	}
+#endif
+
+halt:
+	registers[EIP] = (int)((ip - code) * ENTRY_SIZE);
+	return true;
+}
@@ -31,13 +31,13 @@ enum unary_expr
 struct expression_desc
 {
 	bytestream	bytecode;
-	std::string   value;
+	int		   value;		// if constexpr
 	int		   type;
 	int		   address;
 	bool		  constexpr;
 
 	expression_desc()
-		: address(0), constexpr(false) {}
+		: value(0), type(Type_Unknown), address(0), constexpr(false) {}
 };
 
 struct declaration_desc
@@ -68,6 +68,7 @@ struct symbol_desc
 	std::string  name;
 	bytestream   bytecode;
 	exprlist*	args;
+	std::vector<int> params;	// argument types (functions)
 
 	int		  address;
 	int		  type;
@@ -88,10 +89,64 @@ struct unresolved_reference
 		: func(0), offset(0) {}
 };
 
+// editable form of the program (for the optimizer passes)
+struct code_entry
+{
+	unsigned char opcode;
+	int arg1;
+	int arg2;
+	int label;		// original index (-1 if inserted)
+	int target;		// label of the jump target (-1 if none)
+	int line;		// source line (0 if inserted)
+	bool barrier;	// somebody jumps here
+	bool removed;
+
+	code_entry()
+		: opcode(0), arg1(0), arg2(0), label(-1), target(-1), line(0), barrier(false), removed(false) {}
+
+	code_entry(unsigned char op, int a1, int a2)
+		: opcode(op), arg1(a1), arg2(a2), label(-1), target(-1), line(0), barrier(false), removed(false) {}
+};
+
+// what the optimizer knows about a register or local
+struct constant_desc
+{
+	int value;
+	int writes;
+	bool known;
+
+	constant_desc()
+		: value(0), writes(0), known(false) {}
+};
+
+// what profiled runs collected
+struct profile_desc
+{
+	typedef std::vector<int> callstack;
+	typedef std::map<callstack, unsigned int> stackmap;
+
+	std::vector<unsigned int> opcodes;	// executions per opcode
+	std::vector<unsigned int> entries;	// executions per entry
+	std::vector<unsigned int> samples;	// samples per entry
+	stackmap stacks;					// samples per call stack (function addresses, outermost first)
+	callstack frames;					// while running
+	unsigned long long instructions;
+	unsigned int numsamples;
+	unsigned int interval;
+	unsigned int countdown;
+	bool calling;						// the last instruction pushed a return address
+
+	profile_desc()
+		: instructions(0), numsamples(0), interval(0), countdown(0), calling(false) {}
+};
+
 typedef std::list<symbol_desc*> symbollist;
 typedef std::list<statement_desc*> statlist;
 typedef std::map<std::string, symbol_desc*> symboltable;
 typedef std::vector<symboltable> scopetable;
+typedef std::vector<code_entry> codelist;
+typedef std::vector<unresolved_reference> referencelist;
+typedef std::map<int, constant_desc> constantmap;
 
 #endif
 
@@ -35,6 +35,10 @@ public:
 
 	void clear();
 	void erase(void* ptr);
+
+	inline size_t size() const {
+		return values.size();
+	}
 	
 	template <typename value_type>
 	void insert(value_type* ptr) {
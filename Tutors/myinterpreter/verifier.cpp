@@ -0,0 +1,482 @@
+
+#include "interpreter.h"
+#include <algorithm>
+
+#define UNKNOWN_FRAME	INT_MIN
+
+#define REG_ARG1		1
+#define REG_ARG2		2
+#define WRITES_ARG1		4
+#define INVALID_OPCODE	-1
+
+// what the abstract interpreter knows before an entry (depths are bytes
+// below the return address of the function being verified)
+struct frame_state
+{
+	typedef std::vector<std::pair<int, int> > savelist;
+
+	int depth;			// -4 in the entry function (it pushes its own)
+	int frame;			// depth EBP points to
+	savelist saved;		// (depth, frame) of pushed EBP values
+	bool visited;
+
+	frame_state()
+		: depth(0), frame(UNKNOWN_FRAME), visited(false) {}
+
+	bool operator ==(const frame_state& other) const {
+		return (depth == other.depth && frame == other.frame && saved == other.saved);
+	}
+
+	void Drop(int newdepth) {
+		// slots below ESP are gone
+		while( !saved.empty() && saved.back().first > newdepth )
+			saved.pop_back();
+
+		depth = newdepth;
+	}
+};
+
+struct function_info
+{
+	int address;
+	int startdepth;
+	int maxdepth;	// deepest push
+	int argbytes;	// used above the return address
+};
+
+struct call_site
+{
+	int callee;
+	int limit;		// bytes the callee can reach above its return address
+};
+
+typedef std::vector<frame_state> statelist;
+
+static int Operands(unsigned char opcode)
+{
+	switch( opcode )
+	{
+	case OP_PRINT_R:
+	case OP_PRINT_F:
+	case OP_PUSH:
+	case OP_PUSHADD:
+	case OP_JZ:
+	case OP_JNZ:
+		return REG_ARG1;
+
+	case OP_PRINT_M:
+	case OP_MOV_MM:
+	case OP_MOV_MS:
+	case OP_ADD_MS:
+	case OP_JMP:
+		return 0;
+
+	case OP_MOV_MR:
+		return REG_ARG2;
+
+	case OP_POP:
+	case OP_MOV_RS:
+	case OP_MOV_RM:
+	case OP_NOT:
+	case OP_NEG:
+	case OP_AND_RS:
+	case OP_OR_RS:
+	case OP_SUB_RS:
+	case OP_ADD_RS:
+	case OP_MUL_RS:
+	case OP_DIV_RS:
+	case OP_MOD_RS:
+	case OP_SETL_RS:
+	case OP_SETLE_RS:
+	case OP_SETG_RS:
+	case OP_SETGE_RS:
+	case OP_SETE_RS:
+	case OP_SETNE_RS:
+	case OP_FSUB_RS:
+	case OP_FADD_RS:
+	case OP_FMUL_RS:
+	case OP_FDIV_RS:
+	case OP_FNEG:
+	case OP_CVT_IF:
+	case OP_CVT_FI:
+	case OP_FSETL_RS:
+	case OP_FSETLE_RS:
+	case OP_FSETG_RS:
+	case OP_FSETGE_RS:
+	case OP_FSETE_RS:
+	case OP_FSETNE_RS:
+		return REG_ARG1|WRITES_ARG1;
+
+	case OP_MOV_RR:
+	case OP_AND_RR:
+	case OP_OR_RR:
+	case OP_SUB_RR:
+	case OP_ADD_RR:
+	case OP_MUL_RR:
+	case OP_DIV_RR:
+	case OP_MOD_RR:
+	case OP_SETL_RR:
+	case OP_SETLE_RR:
+	case OP_SETG_RR:
+	case OP_SETGE_RR:
+	case OP_SETE_RR:
+	case OP_SETNE_RR:
+	case OP_FSUB_RR:
+	case OP_FADD_RR:
+	case OP_FMUL_RR:
+	case OP_FDIV_RR:
+	case OP_FSETL_RR:
+	case OP_FSETLE_RR:
+	case OP_FSETG_RR:
+	case OP_FSETGE_RR:
+	case OP_FSETE_RR:
+	case OP_FSETNE_RR:
+		return REG_ARG1|REG_ARG2|WRITES_ARG1;
+
+	default:
+		break;
+	}
+
+	if( opcode >= OP_SETL_JZ_RS && opcode <= OP_SETNE_JZ_RR )
+		return ((opcode & 1) ? REG_ARG1|REG_ARG2|WRITES_ARG1 : REG_ARG1|WRITES_ARG1);
+
+	return INVALID_OPCODE;
+}
+
+static bool Is_Fused(unsigned char opcode)
+{
+	return (opcode >= OP_SETL_JZ_RS && opcode <= OP_SETNE_JZ_RR);
+}
+
+static bool Access(const frame_state& s, function_info& f, int off, bool write)
+{
+	// [EBP + off] must be above ESP, and must not overwrite a return address or a saved EBP
+	if( s.frame == UNKNOWN_FRAME )
+		return false;
+
+	int addr = off - s.frame;
+
+	if( addr < -s.depth )
+		return false;
+
+	if( write )
+	{
+		if( addr > -4 && addr < 4 )
+			return false;
+
+		for( size_t i = 0; i < s.saved.size(); ++i )
+		{
+			if( addr > -s.saved[i].first - 4 && addr < -s.saved[i].first + 4 )
+				return false;
+		}
+	}
+
+	if( addr > 0 )
+		f.argbytes = std::max(f.argbytes, addr);
+
+	return true;
+}
+
+verify_result Interpreter::Verify()
+{
+	// NOTE: called by the first Run() in Exec_Switch mode (or explicitly after Link())
+	size_t bytesize = program.size();
+	size_t count = bytesize / ENTRY_SIZE;
+	char* bytecode = program.data();
+	char* ptr;
+
+	verified = Verify_Failed;
+	stackneed = STACK_SIZE;
+
+	assert(Verify_Failed, "Interpreter::Verify(): Program size is not a multiple of ENTRY_SIZE", (bytesize % ENTRY_SIZE) == 0);
+	assert(Verify_Failed, "Interpreter::Verify(): Invalid entry point", entry >= 0 && (size_t)entry < bytesize && (entry % ENTRY_SIZE) == 0);
+
+	// well-formedness (required by both paths)
+	for( size_t i = 0; i < count; ++i )
+	{
+		ptr = (bytecode + i * ENTRY_SIZE);
+
+		unsigned char opcode = *((unsigned char*)ptr);
+		int arg1 = ARG1_INT(ptr);
+		int arg2 = ARG2_INT(ptr);
+		int operands = Operands(opcode);
+
+		assert(Verify_Failed, "Interpreter::Verify(): Unknown opcode at " << i * ENTRY_SIZE, operands != INVALID_OPCODE);
+
+		if( operands & REG_ARG1 )
+			assert(Verify_Failed, "Interpreter::Verify(): Invalid register at " << i * ENTRY_SIZE, arg1 >= 0 && (size_t)arg1 < numregisters);
+
+		if( operands & REG_ARG2 )
+			assert(Verify_Failed, "Interpreter::Verify(): Invalid register at " << i * ENTRY_SIZE, arg2 >= 0 && (size_t)arg2 < numregisters);
+
+		if( opcode == OP_PRINT_M )
+			assert(Verify_Failed, "Interpreter::Verify(): Invalid string at " << i * ENTRY_SIZE, arg1 >= 0 && (size_t)arg1 < strings.size());
+
+		if( Is_Fused(opcode) )
+		{
+			const char* next = ptr + ENTRY_SIZE;
+
+			assert(Verify_Failed, "Interpreter::Verify(): Fused compare without jz at " << i * ENTRY_SIZE,
+				i + 1 < count && *((unsigned char*)next) == OP_JZ && ARG1_INT(next) == arg1);
+		}
+
+		if( opcode == OP_JZ || opcode == OP_JNZ || (opcode == OP_JMP && arg1 != UNKNOWN_ADDR) )
+		{
+			// leaving the code stops the program, but it must not land inside an entry
+			int off = (opcode == OP_JMP ? arg1 : arg2) % (int)ENTRY_SIZE;
+			assert(Verify_Failed, "Interpreter::Verify(): Misaligned jump at " << i * ENTRY_SIZE, off == 0);
+		}
+	}
+
+	verified = Verify_Checked;
+
+	// stack balance and frame bounds, function by function
+	std::vector<function_info> funcs;
+	std::vector<call_site> calls;
+	std::map<int, size_t> index;
+	statelist states;
+	std::vector<size_t> worklist;
+
+	function_info first = { entry, -4, 0, 0 };
+
+	funcs.push_back(first);
+	index[entry] = 0;
+
+	for( size_t n = 0; n < funcs.size(); ++n )
+	{
+		// funcs can grow meanwhile
+		function_info f = funcs[n];
+
+		states.assign(count, frame_state());
+		worklist.clear();
+
+		states[f.address / ENTRY_SIZE].depth = f.startdepth;
+		states[f.address / ENTRY_SIZE].visited = true;
+		worklist.push_back(f.address / ENTRY_SIZE);
+
+		while( !worklist.empty() )
+		{
+			size_t i = worklist.back();
+			worklist.pop_back();
+
+			frame_state s = states[i];
+			ptr = (bytecode + i * ENTRY_SIZE);
+
+			unsigned char opcode = *((unsigned char*)ptr);
+			int arg1 = ARG1_INT(ptr);
+			int arg2 = ARG2_INT(ptr);
+			int operands = Operands(opcode);
+
+			size_t next[2] = { i + 1, count };
+			bool ok = true;
+
+			if( (operands & WRITES_ARG1) && opcode != OP_POP && (arg1 == ESP || arg1 == EBP || arg1 == EIP) )
+			{
+				// only the calling convention can touch these
+				if( opcode == OP_MOV_RR && arg1 == EBP && arg2 == ESP )
+				{
+					s.frame = s.depth;
+				}
+				else if( opcode == OP_MOV_RR && arg1 == ESP && arg2 == EBP && s.frame != UNKNOWN_FRAME && s.frame <= s.depth )
+				{
+					s.Drop(s.frame);
+				}
+				else if( (opcode == OP_SUB_RS || opcode == OP_ADD_RS) && arg1 == ESP )
+				{
+					// allocate or free locals
+					int newdepth = (opcode == OP_SUB_RS ? s.depth + arg2 : s.depth - arg2);
+
+					if( newdepth < f.startdepth )
+						ok = false;
+					else if( newdepth > s.depth )
+						s.depth = newdepth;
+					else
+						s.Drop(newdepth);
+				}
+				else
+				{
+					ok = false;
+				}
+			}
+
+			switch( opcode )
+			{
+			case OP_PUSH:
+				if( arg1 == EBP )
+					s.saved.push_back(std::make_pair(s.depth + 4, s.frame));
+
+				s.depth += 4;
+				break;
+
+			case OP_PUSHADD: {
+				// pushadd EIP + jmp is a call, the callee pops the return address
+				const char* jmp = ptr + ENTRY_SIZE;
+				int target = (int)((i + 2) * ENTRY_SIZE) + ARG1_INT(jmp);
+
+				ok = (arg1 == EIP && arg2 == (int)ENTRY_SIZE && i + 1 < count && *((unsigned char*)jmp) == OP_JMP &&
+					ARG1_INT(jmp) != UNKNOWN_ADDR && target >= 0 && (size_t)target < bytesize && target != entry);
+
+				if( !ok )
+					break;
+
+				call_site site = { target, s.depth - (s.saved.empty() ? 0 : s.saved.back().first) };
+				calls.push_back(site);
+
+				if( index.find(target) == index.end() )
+				{
+					function_info callee = { target, 0, 0, 0 };
+
+					index[target] = funcs.size();
+					funcs.push_back(callee);
+				}
+
+				f.maxdepth = std::max(f.maxdepth, s.depth + 4);
+				next[0] = i + 2;
+				} break;
+
+			case OP_POP:
+				if( arg1 == EIP )
+				{
+					// return
+					ok = (s.depth == 0);
+					next[0] = count;
+				}
+				else if( s.depth < 4 )
+				{
+					ok = false;
+				}
+				else if( arg1 == EBP )
+				{
+					if( !s.saved.empty() && s.saved.back().first == s.depth )
+						s.frame = s.saved.back().second;
+					else
+						s.frame = UNKNOWN_FRAME;
+
+					s.Drop(s.depth - 4);
+				}
+				else
+				{
+					s.Drop(s.depth - 4);
+				}
+
+				break;
+
+			case OP_MOV_RM:
+				ok = Access(s, f, arg2, false);
+				break;
+
+			case OP_MOV_MR:
+			case OP_MOV_MS:
+			case OP_ADD_MS:
+				ok = Access(s, f, arg1, true);
+				break;
+
+			case OP_MOV_MM:
+				ok = Access(s, f, arg1, true) && Access(s, f, arg2, false);
+				break;
+
+			case OP_DIV_RS:
+			case OP_MOD_RS:
+				if( arg2 == 0 )
+				{
+					// not a stack problem, the checked run will raise it
+					int line = Source_Line(i * ENTRY_SIZE);
+
+					if( line > 0 )
+					{
+						warn("Interpreter::Verify(): Division by constant zero at line " << line << ", running with checks");
+					}
+					else
+					{
+						warn("Interpreter::Verify(): Division by constant zero at " << i * ENTRY_SIZE << ", running with checks");
+					}
+
+					return verified;
+				}
+
+				break;
+
+			case OP_JZ:
+			case OP_JNZ:
+				next[1] = (size_t)((int)((i + 1) * ENTRY_SIZE) + arg2) / ENTRY_SIZE;
+				break;
+
+			case OP_JMP:
+				ok = (arg1 != UNKNOWN_ADDR);
+				next[0] = (size_t)((int)((i + 1) * ENTRY_SIZE) + arg1) / ENTRY_SIZE;
+				break;
+
+			default:
+				if( Is_Fused(opcode) )
+				{
+					// the jz is executed with it
+					next[0] = i + 2;
+					next[1] = (size_t)((int)((i + 2) * ENTRY_SIZE) + ARG2_INT(ptr + ENTRY_SIZE)) / ENTRY_SIZE;
+				}
+
+				break;
+			}
+
+			if( !ok || s.depth > STACK_SIZE )
+			{
+				warn("Interpreter::Verify(): Can't prove stack safety at " << i * ENTRY_SIZE << ", running with checks");
+				return verified;
+			}
+
+			f.maxdepth = std::max(f.maxdepth, s.depth);
+
+			// anything outside the code stops the program
+			for( int k = 0; k < 2; ++k )
+			{
+				if( next[k] >= count )
+					continue;
+
+				frame_state& t = states[next[k]];
+
+				if( !t.visited )
+				{
+					t = s;
+					t.visited = true;
+
+					worklist.push_back(next[k]);
+				}
+				else if( !(t == s) )
+				{
+					warn("Interpreter::Verify(): Stack is not balanced at " << next[k] * ENTRY_SIZE << ", running with checks");
+					return verified;
+				}
+			}
+		}
+
+		funcs[n] = f;
+	}
+
+	// arguments must be pushed by the caller
+	for( size_t i = 0; i < calls.size(); ++i )
+	{
+		const function_info& callee = funcs[index[calls[i].callee]];
+
+		if( callee.argbytes > calls[i].limit )
+		{
+			warn("Interpreter::Verify(): Function at " << callee.address << " reads more arguments than pushed, running with checks");
+			return verified;
+		}
+	}
+
+	if( funcs[0].argbytes > 0 || funcs[0].maxdepth > STACK_SIZE - 4 )
+	{
+		warn("Interpreter::Verify(): Entry function doesn't fit, running with checks");
+		return verified;
+	}
+
+	// a call needs room for the return address and the deepest frame
+	int maxframe = 0;
+
+	for( size_t i = 1; i < funcs.size(); ++i )
+		maxframe = std::max(maxframe, funcs[i].maxdepth);
+
+	stackneed = 4 + maxframe;
+	verified = Verify_Passed;
+
+	return verified;
+}
@@ -3,6 +3,12 @@
 #define _FUNCTIONAL_HPP_
 
 #include <iostream>
+#include <utility>
+#include <algorithm>
+
+#if !defined(_MSC_VER) || (_MSC_VER >= 1700)
+#	include <type_traits>
+#endif
 
 #define myerror(r, e, x) { if( !(x) ) { std::cout << "* MYSTL ERROR: " << e << "\n"; return r; } }
 #define mynerror(r, e, x) { if( (x) ) { std::cout << "* MYSTL ERROR: " << e << "\n"; return r; } }
@@ -16,6 +22,41 @@ namespace mystl
 			return a < b;
 		}
 	};
+
+	// neighbours in a sorted range are equivalent if the first is not less
+	template <typename T, typename compare>
+	struct sorted_equivalent
+	{
+		compare comp;
+
+		sorted_equivalent(const compare& c)
+			: comp(c) {}
+
+		inline bool operator ()(const T& a, const T& b) const {
+			return !comp(a, b);
+		}
+	};
+
+	// compile time flag, overloads on true_type/false_type select the implementation
+	template <bool flag>
+	struct bool_constant
+	{
+		static const bool value = flag;
+	};
+
+	typedef bool_constant<true> true_type;
+	typedef bool_constant<false> false_type;
+
+	// can be relocated with memmove (no copy constructor or destructor to run)
+	template <typename T>
+	struct is_trivially_copyable
+#if defined(_MSC_VER) && (_MSC_VER < 1700)
+		: bool_constant<__has_trivial_copy(T) && __has_trivial_destructor(T)>
+#else
+		: bool_constant<std::is_trivially_copyable<T>::value>
+#endif
+	{
+	};
 }
 
 #endif
@@ -3,10 +3,12 @@
 #define _LIST_HPP_
 
 #include "functional.hpp"
+#include "pool.hpp"
+#include <new>
 
 namespace mystl
 {
-	template <typename value_type>
+	template <typename value_type, typename allocator = default_allocator>
 	class list
 	{
 	protected:
@@ -15,11 +17,32 @@ namespace mystl
 			value_type value;
 			link* next;
 			link* prev;
+
+			link()
+				: value(), next(0), prev(0) {}
+
+			link(const value_type& v)
+				: value(v), next(0), prev(0) {}
 		};
 
+		typedef typename allocator::template pool<link> node_pool;
+
+		node_pool nodes;
+		link sentinel;	// not allocated, empty lists cost nothing
 		link* head;
 		size_t mysize;
 
+		link* _create(const value_type& value);
+		void _destroy(link* node);
+		void _attach(link* chain);
+		link* _adopt(list& other, link* first, link* last);
+
+		static void _unlink(link* first, link* last);
+		static void _relink(link* pos, link* first, link* last);
+
+		template <typename compare>
+		static link* _merge(link* a, link* b, compare comp);
+
 	public:
 		typedef value_type value_type;
 
@@ -44,6 +67,18 @@ namespace mystl
 		iterator insert(const iterator& pos, const value_type& value);
 		iterator erase(iterator& pos);
 
+		void splice(const iterator& pos, list& other);
+		void splice(const iterator& pos, list& other, const iterator& it);
+		void splice(const iterator& pos, list& other, const iterator& first, const iterator& last);
+		void merge(list& other);
+		void sort();
+
+		template <typename compare>
+		void merge(list& other, compare comp);
+
+		template <typename compare>
+		void sort(compare comp);
+
 		inline value_type& front() {
 			myerror(head->value, "list::front(): container is empty", mysize > 0);
 			return head->next->value;
@@ -94,19 +129,19 @@ namespace mystl
 
 namespace mystl
 {
-	template <typename value_type>
-	list<value_type>::list()
+	template <typename value_type, typename allocator>
+	list<value_type, allocator>::list()
 	{
-		head = new link();
+		head = &sentinel;
 
 		head->next = head->prev = head;
 		mysize = 0;
 	}
 
-	template <typename value_type>
-	list<value_type>::list(size_t size, const value_type& value)
+	template <typename value_type, typename allocator>
+	list<value_type, allocator>::list(size_t size, const value_type& value)
 	{
-		head = new link();
+		head = &sentinel;
 
 		head->next = head->prev = head;
 		mysize = 0;
@@ -114,10 +149,10 @@ namespace mystl
 		resize(size, value);
 	}
 
-	template <typename value_type>
-	list<value_type>::list(const list& other)
+	template <typename value_type, typename allocator>
+	list<value_type, allocator>::list(const list& other)
 	{
-		head = new link();
+		head = &sentinel;
 
 		head->next = head->prev = head;
 		mysize = 0;
@@ -125,20 +160,14 @@ namespace mystl
 		operator =(other);
 	}
 
-	template <typename value_type>
-	list<value_type>::~list()
+	template <typename value_type, typename allocator>
+	list<value_type, allocator>::~list()
 	{
-		if( head )
-		{
-			clear();
-
-			delete head;
-			head = NULL;
-		}
+		clear();
 	}
 
-	template <typename value_type>
-	list<value_type>& list<value_type>::operator =(const list<value_type>& other)
+	template <typename value_type, typename allocator>
+	list<value_type, allocator>& list<value_type, allocator>::operator =(const list<value_type, allocator>& other)
 	{
 		if( &other == this )
 			return *this;
@@ -151,41 +180,39 @@ namespace mystl
 		return *this;
 	}
 
-	template <typename value_type>
-	void list<value_type>::push_back(const value_type& item)
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::push_back(const value_type& item)
 	{
 		link* last = head->prev;
 
-		last->next = new link();
+		last->next = _create(item);
 		last->next->prev = last;
 		last->next->next = head;
-		last->next->value = item;
 
 		head->prev = last->next;
 		++mysize;
 	}
 
-	template <typename value_type>
-	void list<value_type>::push_front(const value_type& item)
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::push_front(const value_type& item)
 	{
 		link* first = head->next;
 
-		head->next = new link();
+		head->next = _create(item);
 		head->next->prev = head;
 		head->next->next = first;
-		head->next->value = item;
 
 		first->prev = head->next;
 		++mysize;
 	}
 
-	template <typename value_type>
-	void list<value_type>::pop_front()
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::pop_front()
 	{
 		myerror(, "list::pop_front(): container is empty", mysize > 0);
 
 		link* second = head->next->next;
-		delete head->next;
+		_destroy(head->next);
 
 		head->next = second;
 		second->prev = head;
@@ -193,8 +220,8 @@ namespace mystl
 		--mysize;
 	}
 
-	template <typename value_type>
-	void list<value_type>::pop_back()
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::pop_back()
 	{
 		myerror(, "list::pop_back(): container is empty", mysize > 0);
 
@@ -202,13 +229,13 @@ namespace mystl
 		head->prev = last->prev;
 
 		last->prev->next = head;
-		delete last;
+		_destroy(last);
 
 		--mysize;
 	}
 
-	template <typename value_type>
-	void list<value_type>::resize(size_t newsize, const value_type& value)
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::resize(size_t newsize, const value_type& value)
 	{
 		if( mysize < newsize )
 		{
@@ -222,8 +249,8 @@ namespace mystl
 		}
 	}
 
-	template <typename value_type>
-	void list<value_type>::clear()
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::clear()
 	{
 		link* q = head->next;
 		link* p;
@@ -232,15 +259,15 @@ namespace mystl
 		{
 			p = q;
 			q = q->next;
-			delete p;
+			_destroy(p);
 		}
 
 		head->next = head->prev = head;
 		mysize = 0;
 	}
 
-	template <typename value_type>
-	void list<value_type>::remove(const value_type& value)
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::remove(const value_type& value)
 	{
 		link *p, *r;
 
@@ -254,7 +281,7 @@ namespace mystl
 				p->next = r;
 				r->prev = p;
 
-				delete q;
+				_destroy(q);
 				q = p;
 
 				--mysize;
@@ -262,26 +289,25 @@ namespace mystl
 		}
 	}
 
-	template <typename value_type>
-	typename list<value_type>::iterator list<value_type>::insert(const iterator& pos, const value_type& value)
+	template <typename value_type, typename allocator>
+	typename list<value_type, allocator>::iterator list<value_type, allocator>::insert(const iterator& pos, const value_type& value)
 	{
 		mynerror(end(), "list::insert(): iterator invalid", pos.container != this);
 
 		link* q = pos.ptr->prev;
 
-		q->next = new link();
+		q->next = _create(value);
 		q->next->next = pos.ptr;
 		q->next->prev = q;
 
 		pos.ptr->prev = q->next;
-		q->next->value = value;
 
 		++mysize;
 		return iterator(this, q->next);
 	}
 
-	template <typename value_type>
-	typename list<value_type>::iterator list<value_type>::erase(iterator& pos)
+	template <typename value_type, typename allocator>
+	typename list<value_type, allocator>::iterator list<value_type, allocator>::erase(iterator& pos)
 	{
 		myerror(end(), "list::erase(): container is empty", mysize > 0);
 		mynerror(end(), "list::erase(): iterator invalid", pos.container != this);
@@ -293,12 +319,273 @@ namespace mystl
 		p->next = q;
 		q->prev = p;
 
-		delete pos.ptr;
+		_destroy(pos.ptr);
 		pos.ptr = head;
 
 		--mysize;
 		return iterator(this, q);
 	}
+
+	template <typename value_type, typename allocator>
+	typename list<value_type, allocator>::link* list<value_type, allocator>::_create(const value_type& value)
+	{
+		link* node = nodes.allocate();
+		new(node) link(value);
+
+		return node;
+	}
+
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::_destroy(link* node)
+	{
+		node->~link();
+		nodes.deallocate(node);
+	}
+
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::_unlink(link* first, link* last)
+	{
+		// [first, last] is cut out, its own links are left as they were
+		first->prev->next = last->next;
+		last->next->prev = first->prev;
+	}
+
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::_relink(link* pos, link* first, link* last)
+	{
+		// puts [first, last] before pos
+		first->prev = pos->prev;
+		last->next = pos;
+
+		pos->prev->next = first;
+		pos->prev = last;
+	}
+
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::_attach(link* chain)
+	{
+		// chain is null terminated and only linked forward
+		link* prev = head;
+
+		for( link* q = chain; q != 0; q = q->next )
+		{
+			q->prev = prev;
+			prev->next = q;
+			prev = q;
+		}
+
+		prev->next = head;
+		head->prev = prev;
+	}
+
+	template <typename value_type, typename allocator>
+	typename list<value_type, allocator>::link* list<value_type, allocator>::_adopt(list& other, link* first, link* last)
+	{
+		// NOTE: nodes of another pool can't be relinked, [first, last) is replaced with copies from ours
+		link* ret = last;
+
+		for( link* q = first; q != last; )
+		{
+			link* copy = _create(q->value);
+			link* next = q->next;
+
+			copy->prev = q->prev;
+			copy->next = next;
+
+			q->prev->next = copy;
+			next->prev = copy;
+
+			if( q == first )
+				ret = copy;
+
+			other._destroy(q);
+			q = next;
+		}
+
+		return ret;
+	}
+
+	template <typename value_type, typename allocator>
+	template <typename compare>
+	typename list<value_type, allocator>::link* list<value_type, allocator>::_merge(link* a, link* b, compare comp)
+	{
+		// merges two null terminated chains, on equality a comes first
+		link* result = 0;
+		link** tail = &result;
+
+		while( a && b )
+		{
+			if( comp(b->value, a->value) )
+			{
+				*tail = b;
+				b = b->next;
+			}
+			else
+			{
+				*tail = a;
+				a = a->next;
+			}
+
+			tail = &(*tail)->next;
+		}
+
+		*tail = (a ? a : b);
+		return result;
+	}
+
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::splice(const iterator& pos, list& other)
+	{
+		// moves every element of other before pos
+		mynerror(, "list::splice(): iterator invalid", pos.container != this);
+
+		if( &other == this || other.mysize == 0 )
+			return;
+
+		if( !nodes.compatible(other.nodes) )
+			_adopt(other, other.head->next, other.head);
+
+		link* first = other.head->next;
+		link* last = other.head->prev;
+
+		_unlink(first, last);
+		_relink(pos.ptr, first, last);
+
+		mysize += other.mysize;
+		other.mysize = 0;
+	}
+
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::splice(const iterator& pos, list& other, const iterator& it)
+	{
+		mynerror(, "list::splice(): iterator invalid", pos.container != this);
+		mynerror(, "list::splice(): iterator invalid", it.container != &other || it.ptr == other.head);
+
+		link* node = it.ptr;
+
+		if( node == pos.ptr || node->next == pos.ptr )
+			return;
+
+		if( !nodes.compatible(other.nodes) )
+			node = _adopt(other, node, node->next);
+
+		_unlink(node, node);
+		_relink(pos.ptr, node, node);
+
+		--other.mysize;
+		++mysize;
+	}
+
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::splice(const iterator& pos, list& other, const iterator& first, const iterator& last)
+	{
+		// NOTE: O(N) between different lists, the size has to be counted
+		mynerror(, "list::splice(): iterator invalid", pos.container != this);
+		mynerror(, "list::splice(): iterator invalid", first.container != &other || last.container != &other);
+
+		link* begin = first.ptr;
+		link* end = last.ptr;
+		size_t count = 0;
+
+		if( begin == end )
+			return;
+
+		if( &other != this )
+		{
+			for( link* q = begin; q != end; q = q->next )
+				++count;
+
+			if( !nodes.compatible(other.nodes) )
+				begin = _adopt(other, begin, end);
+		}
+
+		link* back = end->prev;
+
+		_unlink(begin, back);
+		_relink(pos.ptr, begin, back);
+
+		other.mysize -= count;
+		mysize += count;
+	}
+
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::merge(list& other)
+	{
+		merge(other, default_less<value_type>());
+	}
+
+	template <typename value_type, typename allocator>
+	template <typename compare>
+	void list<value_type, allocator>::merge(list& other, compare comp)
+	{
+		// both lists must be sorted; stable, relinks the nodes
+		if( &other == this || other.mysize == 0 )
+			return;
+
+		if( !nodes.compatible(other.nodes) )
+			_adopt(other, other.head->next, other.head);
+
+		head->prev->next = 0;
+		other.head->prev->next = 0;
+
+		_attach(_merge(head->next, other.head->next, comp));
+
+		mysize += other.mysize;
+
+		other.head->next = other.head->prev = other.head;
+		other.mysize = 0;
+	}
+
+	template <typename value_type, typename allocator>
+	void list<value_type, allocator>::sort()
+	{
+		sort(default_less<value_type>());
+	}
+
+	template <typename value_type, typename allocator>
+	template <typename compare>
+	void list<value_type, allocator>::sort(compare comp)
+	{
+		// bottom-up merge sort on the nodes: runs[i] is a sorted chain of 2^i elements
+		link* runs[sizeof(size_t) * 8];
+		size_t numruns = 0;
+
+		if( mysize < 2 )
+			return;
+
+		head->prev->next = 0;
+
+		for( link* q = head->next; q != 0; )
+		{
+			link* carry = q;
+			size_t i = 0;
+
+			q = q->next;
+			carry->next = 0;
+
+			// runs hold earlier elements than carry, keep them first
+			for( ; i < numruns && runs[i] != 0; ++i )
+			{
+				carry = _merge(runs[i], carry, comp);
+				runs[i] = 0;
+			}
+
+			if( i == numruns )
+				++numruns;
+
+			runs[i] = carry;
+		}
+
+		link* result = 0;
+
+		for( size_t i = 0; i < numruns; ++i )
+		{
+			if( runs[i] )
+				result = _merge(runs[i], result, comp);
+		}
+
+		_attach(result);
+	}
 }
 
 #endif
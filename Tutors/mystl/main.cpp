@@ -1,6 +1,10 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <list>
+#include <algorithm>
+#include <ctime>
 
 #define _CRTDBG_MAP_ALLOC
 #include <cstdlib>
@@ -13,6 +17,9 @@
 #define ASSERT(x)			{ if( !(x) ) { std::cout << "ASSERTION FAILED: " << #x << "\n"; } }
 #define SECTION(x)			std::cout << "\n\n" << x << "\n---------------------------------\n\n";
 
+// destroyed after main(), the shared slabs must still be there
+static mystl::list<int, mystl::shared_pool_allocator> staticlist;
+
 template <typename container_t>
 void write(const std::string& name, const container_t& cont)
 {
@@ -24,6 +31,66 @@ void write(const std::string& name, const container_t& cont)
 	std::cout << "\n";
 }
 
+template <typename container_t>
+void sort(container_t& cont)
+{
+	cont.sort();
+}
+
+void sort(std::vector<int>& cont)
+{
+	std::sort(cont.begin(), cont.end());
+}
+
+template <typename container_t>
+void benchmark(const std::string& name, const std::vector<int>& values)
+{
+	container_t cont;
+	container_t other;
+	clock_t start;
+	clock_t elapsed[3];
+	volatile int sum = 0;	// so that the loop isn't optimized out
+
+	// push/pop churn
+	start = clock();
+
+	for( int round = 0; round < 20; ++round )
+	{
+		for( size_t i = 0; i < values.size(); ++i )
+			cont.push_back(values[i]);
+
+		while( !cont.empty() )
+			cont.pop_back();
+	}
+
+	elapsed[0] = clock() - start;
+
+	// iteration (another container allocates in between)
+	for( size_t i = 0; i < values.size(); ++i )
+	{
+		cont.push_back(values[i]);
+		other.push_back(values[i]);
+	}
+
+	start = clock();
+
+	for( int round = 0; round < 20; ++round )
+	{
+		for( typename container_t::const_iterator it = cont.begin(); it != cont.end(); ++it )
+			sum += *it;
+	}
+
+	elapsed[1] = clock() - start;
+	start = clock();
+
+	sort(cont);
+
+	elapsed[2] = clock() - start;
+
+	std::cout << name << ": churn " << (elapsed[0] * 1000 / CLOCKS_PER_SEC) << " ms, iterate "
+		<< (elapsed[1] * 1000 / CLOCKS_PER_SEC) << " ms, sort " << (elapsed[2] * 1000 / CLOCKS_PER_SEC) << " ms\n";
+}
+
 int main()
 {
 	{
@@ -303,6 +370,65 @@ int main()
 		}
 	}
 
+	{
+		SECTION("list: splice, merge & sort");
+
+		mystl::list<int, mystl::pool_allocator> l1, l2;
+
+		for( int i = 0; i < 6; ++i )
+		{
+			l1.push_back((i * 7) % 10);
+			l2.push_back((i * 3) % 8);
+		}
+
+		write("l1", l1);
+		write("l2", l2);
+
+		DEBUG_METHOD(l1.sort());
+		DEBUG_METHOD(l2.sort());
+		write("l1", l1);
+		write("l2", l2);
+
+		DEBUG_METHOD(l1.merge(l2));
+		ASSERT(l1.size() == 12 && l2.empty());
+		write("l1", l1);
+
+		DEBUG_METHOD(l2.splice(l2.begin(), l1, l1.begin()));
+		DEBUG_METHOD(l2.splice(l2.end(), l1));
+		ASSERT(l1.empty() && l2.size() == 12);
+		write("l2", l2);
+	}
+
+	{
+		SECTION("list: shared pool");
+
+		mystl::list<int, mystl::shared_pool_allocator> l3;
+
+		for( int i = 0; i < 10; ++i )
+		{
+			staticlist.push_back(i);
+			l3.push_back(i * i);
+		}
+
+		write("staticlist", staticlist);
+		write("l3", l3);
+		ASSERT(staticlist.size() == 10 && l3.size() == 10);
+	}
+
+	{
+		SECTION("list: benchmark");
+
+		std::vector<int> values(100000);
+
+		for( size_t i = 0; i < values.size(); ++i )
+			values[i] = rand() % 1000;
+
+		benchmark<std::vector<int> >("std::vector", values);
+		benchmark<std::list<int> >("std::list", values);
+		benchmark<mystl::list<int> >("mystl::list", values);
+		benchmark<mystl::list<int, mystl::pool_allocator> >("mystl::list + pool", values);
+	}
+
 	std::cout << "\n";
 	_CrtDumpMemoryLeaks();
 
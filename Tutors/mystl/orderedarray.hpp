@@ -3,10 +3,15 @@
 #define _ORDEREDARRAY_HPP_
 
 #include "functional.hpp"
+#include "searchlayout.hpp"
+#include <cstdlib>
+#include <cstring>
+
+#define ORDEREDARRAY_MIN_CAPACITY	8
 
 namespace mystl
 {
-	template <typename value_type, typename compare = default_less<value_type> >
+	template <typename value_type, typename compare = default_less<value_type>, typename layout = sorted_layout>
 	class orderedarray
 	{
 	private:
@@ -14,7 +19,24 @@ namespace mystl
 		size_t mycap;
 		size_t mysize;
 
+		mutable typename layout::template index<value_type, compare> myindex;
+
 		size_t _find(const value_type& value) const;
+		size_t _lookup(const value_type& value) const;
+		void _grow(size_t mincap);
+		void _open(size_t index);
+		void _open(size_t index, true_type);
+		void _open(size_t index, false_type);
+		void _close(size_t index);
+		void _close(size_t index, true_type);
+		void _close(size_t index, false_type);
+		void _rotate(size_t index, true_type);
+		void _rotate(size_t index, false_type);
+		void _realloc(size_t newcap, true_type);
+		void _realloc(size_t newcap, false_type);
+		void _copy(const value_type* other, true_type);
+		void _copy(const value_type* other, false_type);
+		void _unique();
 
 	public:
 		static const size_t npos = 0xffffffff;
@@ -23,9 +45,20 @@ namespace mystl
 
 		orderedarray();
 		orderedarray(const orderedarray& other);
+		orderedarray(orderedarray&& other);
 		~orderedarray();
 
 		bool insert(const value_type& value);
+		bool insert(value_type&& value);
+
+		template <typename arg_type>
+		bool emplace(arg_type&& arg);
+
+		template <typename iterator_type>
+		void assign(iterator_type first, iterator_type last);
+
+		template <typename iterator_type>
+		void insert(iterator_type first, iterator_type last);
 
 		void erase(const value_type& value);
 		void erase_at(size_t index);
@@ -39,6 +72,7 @@ namespace mystl
 		size_t upper_bound(const value_type& value) const;
 
 		orderedarray& operator =(const orderedarray& other);
+		orderedarray& operator =(orderedarray&& other);
 	
 		inline const value_type& operator [](size_t index) const {
 			return data[index];
@@ -55,20 +89,20 @@ namespace mystl
 		// uncommon methods
 		void _fastcopy(const orderedarray& other);
 
-		template <typename T, typename U>
-		friend std::ostream& operator <<(std::ostream& os, const orderedarray<T, U>& oa);
+		template <typename T, typename U, typename V>
+		friend std::ostream& operator <<(std::ostream& os, const orderedarray<T, U, V>& oa);
 	};
 
-	template <typename value_type, typename compare>
-	orderedarray<value_type, compare>::orderedarray()
+	template <typename value_type, typename compare, typename layout>
+	orderedarray<value_type, compare, layout>::orderedarray()
 	{
 		data = 0;
 		mysize = 0;
 		mycap = 0;
 	}
 	
-	template <typename value_type, typename compare>
-	orderedarray<value_type, compare>::orderedarray(const orderedarray& other)
+	template <typename value_type, typename compare, typename layout>
+	orderedarray<value_type, compare, layout>::orderedarray(const orderedarray& other)
 	{
 		data = 0;
 		mysize = 0;
@@ -76,15 +110,28 @@ namespace mystl
 
 		this->operator =(other);
 	}
+
+	template <typename value_type, typename compare, typename layout>
+	orderedarray<value_type, compare, layout>::orderedarray(orderedarray&& other)
+	{
+		data = other.data;
+		mysize = other.mysize;
+		mycap = other.mycap;
+
+		other.data = 0;
+		other.mysize = 0;
+		other.mycap = 0;
+		other.myindex.invalidate();
+	}
 	
-	template <typename value_type, typename compare>
-	orderedarray<value_type, compare>::~orderedarray()
+	template <typename value_type, typename compare, typename layout>
+	orderedarray<value_type, compare, layout>::~orderedarray()
 	{
 		destroy();
 	}
 	
-	template <typename value_type, typename compare>
-	size_t orderedarray<value_type, compare>::_find(const value_type& value) const
+	template <typename value_type, typename compare, typename layout>
+	size_t orderedarray<value_type, compare, layout>::_find(const value_type& value) const
 	{
 		size_t low = 0;
 		size_t high = mysize;
@@ -104,100 +151,270 @@ namespace mystl
 	
 		return low;
 	}
+
+	template <typename value_type, typename compare, typename layout>
+	size_t orderedarray<value_type, compare, layout>::_lookup(const value_type& value) const
+	{
+		// same as _find(), but through the search index (if any)
+		size_t i = myindex.search(data, mysize, value, comp);
+		return (i == layout::template index<value_type, compare>::npos ? _find(value) : i);
+	}
 	
-	template <typename value_type, typename compare>
-	bool orderedarray<value_type, compare>::insert(const value_type& value)
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_grow(size_t mincap)
 	{
-		size_t i = 0;
+		// geometric, N inserts reallocate only O(log N) times
+		if( mycap < mincap )
+			reserve(std::max<size_t>(mincap, std::max<size_t>(mycap * 2, ORDEREDARRAY_MIN_CAPACITY)));
+	}
 
-		reserve(mysize + 1);
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_open(size_t index)
+	{
+		// moves [index, mysize) up by one, data[index] is left unconstructed
+		if( index < mysize )
+			_open(index, is_trivially_copyable<value_type>());
+	}
 
-		if( mysize > 0 )
-		{
-			i = _find(value);
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_open(size_t index, true_type)
+	{
+		memmove(data + index + 1, data + index, (mysize - index) * sizeof(value_type));
+	}
 
-			if( i < mysize && !(comp(data[i], value) || comp(value, data[i])) )
-				return false;
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_open(size_t index, false_type)
+	{
+		new(data + mysize) value_type(std::move(data[mysize - 1]));
 
-			size_t count = (mysize - i);
-			new(data + mysize) value_type();
+		for( size_t j = mysize - 1; j > index; --j )
+			data[j] = std::move(data[j - 1]);
 
-			for( size_t j = count; j > 0; --j )
-				data[i + j] = data[i + j - 1];
-		}
-		else
-			new(data) value_type();
+		(data + index)->~value_type();
+	}
+
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_close(size_t index)
+	{
+		// destroys data[index] and moves the rest down by one
+		_close(index, is_trivially_copyable<value_type>());
+		--mysize;
+	}
+
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_close(size_t index, true_type)
+	{
+		memmove(data + index, data + index + 1, ((mysize - index) - 1) * sizeof(value_type));
+	}
+
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_close(size_t index, false_type)
+	{
+		size_t count = (mysize - index) - 1;
+
+		for( size_t j = 0; j < count; ++j )
+			data[index + j] = std::move(data[index + j + 1]);
 
-		data[i] = value;
+		(data + index + count)->~value_type();
+	}
+
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_rotate(size_t index, true_type)
+	{
+		// moves data[mysize] to data[index], [index, mysize) goes up by one
+		char tmp[sizeof(value_type)];
+
+		memcpy(tmp, data + mysize, sizeof(value_type));
+		memmove(data + index + 1, data + index, (mysize - index) * sizeof(value_type));
+		memcpy(data + index, tmp, sizeof(value_type));
+	}
+
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_rotate(size_t index, false_type)
+	{
+		value_type tmp(std::move(data[mysize]));
+
+		for( size_t j = mysize; j > index; --j )
+			data[j] = std::move(data[j - 1]);
+
+		data[index] = std::move(tmp);
+	}
+
+	template <typename value_type, typename compare, typename layout>
+	bool orderedarray<value_type, compare, layout>::insert(const value_type& value)
+	{
+		// search first, value might be one of our elements
+		size_t i = _find(value);
+
+		if( i < mysize && !(comp(data[i], value) || comp(value, data[i])) )
+			return false;
+
+		myindex.invalidate();
+
+		_grow(mysize + 1);
+		_open(i);
+
+		new(data + i) value_type(value);
 		++mysize;
 
 		return true;
 	}
+
+	template <typename value_type, typename compare, typename layout>
+	bool orderedarray<value_type, compare, layout>::insert(value_type&& value)
+	{
+		size_t i = _find(value);
+
+		if( i < mysize && !(comp(data[i], value) || comp(value, data[i])) )
+			return false;
+
+		myindex.invalidate();
+
+		_grow(mysize + 1);
+		_open(i);
+
+		new(data + i) value_type(std::move(value));
+		++mysize;
+
+		return true;
+	}
+
+	template <typename value_type, typename compare, typename layout>
+	template <typename arg_type>
+	bool orderedarray<value_type, compare, layout>::emplace(arg_type&& arg)
+	{
+		// NOTE: one constructor argument (no variadic templates in VC10), it must not refer into the array
+		myindex.invalidate();
+		_grow(mysize + 1);
+
+		value_type* value = (data + mysize);
+		new(value) value_type(std::forward<arg_type>(arg));
+
+		size_t i = _find(*value);
+
+		if( i < mysize && !(comp(data[i], *value) || comp(*value, data[i])) )
+		{
+			value->~value_type();
+			return false;
+		}
+
+		if( i < mysize )
+			_rotate(i, is_trivially_copyable<value_type>());
+
+		++mysize;
+		return true;
+	}
 	
-	template <typename value_type, typename compare>
-	void orderedarray<value_type, compare>::erase(const value_type& value)
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_unique()
 	{
-		size_t i = find(value);
+		// removes neighbouring duplicates, the first one stays
+		value_type* end = std::unique(data, data + mysize, sorted_equivalent<value_type, compare>(comp));
+		size_t newsize = (size_t)(end - data);
 
-		if( i != npos )
+		for( size_t i = newsize; i < mysize; ++i )
+			(data + i)->~value_type();
+
+		mysize = newsize;
+	}
+
+	template <typename value_type, typename compare, typename layout>
+	template <typename iterator_type>
+	void orderedarray<value_type, compare, layout>::assign(iterator_type first, iterator_type last)
+	{
+		// O(N log N) instead of N inserts
+		clear();
+		insert(first, last);
+	}
+
+	template <typename value_type, typename compare, typename layout>
+	template <typename iterator_type>
+	void orderedarray<value_type, compare, layout>::insert(iterator_type first, iterator_type last)
+	{
+		// NOTE: forward iterators, not into the array; append, sort the new part, then merge
+		size_t oldsize = mysize;
+
+		myindex.invalidate();
+		_grow(mysize + std::distance(first, last));
+
+		for( ; first != last; ++first )
 		{
-			size_t count = (mysize - i) - 1;
+			new(data + mysize) value_type(*first);
+			++mysize;
+		}
 
-			for( size_t j = 0; j < count; ++j )
-				data[i + j] = data[i + j + 1];
+		// stable, so that the first of equal values stays (like with insert())
+		std::stable_sort(data + oldsize, data + mysize, comp);
+
+		if( oldsize > 0 )
+			std::inplace_merge(data, data + oldsize, data + mysize, comp);
+
+		_unique();
+	}
+	
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::erase(const value_type& value)
+	{
+		size_t i = find(value);
 
-			(data + i + count)->~value_type();
-			--mysize;
+		if( i != npos )
+		{
+			myindex.invalidate();
+			_close(i);
 
 			if( mysize == 0 )
 				clear();
 		}
 	}
 	
-	template <typename value_type, typename compare>
-	void orderedarray<value_type, compare>::erase_at(size_t index)
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::erase_at(size_t index)
 	{
 		if( index < mysize )
 		{
-			size_t count = (mysize - index) - 1;
-
-			for( size_t j = 0; j < count; ++j )
-				data[index + j] = data[index + j + 1];
-
-			(data + index + count)->~value_type();
-			--mysize;
+			myindex.invalidate();
+			_close(index);
 
 			if( mysize == 0 )
 				clear();
 		}
 	}
 
-	template <typename value_type, typename compare>
-	void orderedarray<value_type, compare>::reserve(size_t newcap)
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::reserve(size_t newcap)
 	{
 		if( mycap < newcap )
 		{
-			size_t diff = newcap - mycap;
-			diff = std::max<size_t>(diff, 10);
+			_realloc(newcap, is_trivially_copyable<value_type>());
+			mycap = newcap;
+		}
+	}
 
-			value_type* newdata = (value_type*)malloc((mycap + diff) * sizeof(value_type));
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_realloc(size_t newcap, true_type)
+	{
+		data = (value_type*)realloc(data, newcap * sizeof(value_type));
+	}
 
-			for( size_t i = 0; i < mysize; ++i )
-				new(newdata + i) value_type(data[i]);
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_realloc(size_t newcap, false_type)
+	{
+		value_type* newdata = (value_type*)malloc(newcap * sizeof(value_type));
 
-			for( size_t i = 0; i < mysize; ++i )
-				(data + i)->~value_type();
+		for( size_t i = 0; i < mysize; ++i )
+		{
+			new(newdata + i) value_type(std::move(data[i]));
+			(data + i)->~value_type();
+		}
 
-			if( data )
-				free(data);
+		if( data )
+			free(data);
 
-			data = newdata;
-			mycap = mycap + diff;
-		}
+		data = newdata;
 	}
 	
-	template <typename value_type, typename compare>
-	void orderedarray<value_type, compare>::destroy()
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::destroy()
 	{
 		if( data )
 		{
@@ -210,23 +427,26 @@ namespace mystl
 		data = 0;
 		mysize = 0;
 		mycap = 0;
+
+		myindex.destroy();
 	}
 	
-	template <typename value_type, typename compare>
-	void orderedarray<value_type, compare>::clear()
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::clear()
 	{
 		for( size_t i = 0; i < mysize; ++i )
 			(data + i)->~value_type();
 
 		mysize = 0;
+		myindex.invalidate();
 	}
 	
-	template <typename value_type, typename compare>
-	size_t orderedarray<value_type, compare>::find(const value_type& value) const
+	template <typename value_type, typename compare, typename layout>
+	size_t orderedarray<value_type, compare, layout>::find(const value_type& value) const
 	{
 		if( mysize > 0 )
 		{
-			size_t ind = _find(value);
+			size_t ind = _lookup(value);
 
 			if( ind < mysize )
 			{
@@ -238,15 +458,15 @@ namespace mystl
 		return npos;
 	}
 
-	template <typename value_type, typename compare>
-	size_t orderedarray<value_type, compare>::lower_bound(const value_type& value) const
+	template <typename value_type, typename compare, typename layout>
+	size_t orderedarray<value_type, compare, layout>::lower_bound(const value_type& value) const
 	{
 		// returns the first that is not greater
 		if( mysize > 0 )
 		{
-			size_t ind = _find(value);
+			size_t ind = _lookup(value);
 
-			if( !(comp(data[ind], value) || comp(value, data[ind])) )
+			if( ind < mysize && !(comp(data[ind], value) || comp(value, data[ind])) )
 				return ind;
 			else if( ind > 0 )
 				return ind - 1;
@@ -255,32 +475,63 @@ namespace mystl
 		return npos;
 	}
 
-	template <typename value_type, typename compare>
-	size_t orderedarray<value_type, compare>::upper_bound(const value_type& value) const
+	template <typename value_type, typename compare, typename layout>
+	size_t orderedarray<value_type, compare, layout>::upper_bound(const value_type& value) const
 	{
 		// returns the first that is not smaller
-		return _find(value);
+		return _lookup(value);
 	}
 	
-	template <typename value_type, typename compare>
-	orderedarray<value_type, compare>& orderedarray<value_type, compare>::operator =(const orderedarray& other)
+	template <typename value_type, typename compare, typename layout>
+	orderedarray<value_type, compare, layout>& orderedarray<value_type, compare, layout>::operator =(const orderedarray& other)
 	{
 		if( &other == this )
 			return *this;
 
 		clear();
 
-		reserve(other.mycap);
+		reserve(other.mysize);
 		mysize = other.mysize;
 
+		_copy(other.data, is_trivially_copyable<value_type>());
+		return *this;
+	}
+
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_copy(const value_type* other, true_type)
+	{
+		memcpy(data, other, mysize * sizeof(value_type));
+	}
+
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_copy(const value_type* other, false_type)
+	{
 		for( size_t i = 0; i < mysize; ++i )
-			new(data + i) value_type(other.data[i]);
+			new(data + i) value_type(other[i]);
+	}
+
+	template <typename value_type, typename compare, typename layout>
+	orderedarray<value_type, compare, layout>& orderedarray<value_type, compare, layout>::operator =(orderedarray&& other)
+	{
+		if( &other == this )
+			return *this;
+
+		destroy();
+
+		data = other.data;
+		mysize = other.mysize;
+		mycap = other.mycap;
+
+		other.data = 0;
+		other.mysize = 0;
+		other.mycap = 0;
+		other.myindex.invalidate();
 
 		return *this;
 	}
 
-	template <typename value_type, typename compare>
-	void orderedarray<value_type, compare>::_fastcopy(const orderedarray& other)
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::_fastcopy(const orderedarray& other)
 	{
 		if( &other != this )
 		{
@@ -288,11 +539,12 @@ namespace mystl
 			mysize = other.mysize;
 
 			memcpy(data, other.data, mysize * sizeof(value_type));
+			myindex.invalidate();
 		}
 	}
 
-	template <typename value_type, typename compare>
-	void orderedarray<value_type, compare>::swap(orderedarray& other)
+	template <typename value_type, typename compare, typename layout>
+	void orderedarray<value_type, compare, layout>::swap(orderedarray& other)
 	{
 		if( &other == this )
 			return;
@@ -300,10 +552,13 @@ namespace mystl
 		std::swap(mycap, other.mycap);
 		std::swap(mysize, other.mysize);
 		std::swap(data, other.data);
+
+		myindex.invalidate();
+		other.myindex.invalidate();
 	}
 
-	template <typename value_type, typename compare>
-	std::ostream& operator <<(std::ostream& os, const orderedarray<value_type, compare>& oa)
+	template <typename value_type, typename compare, typename layout>
+	std::ostream& operator <<(std::ostream& os, const orderedarray<value_type, compare, layout>& oa)
 	{
 		for( size_t i = 0; i < oa.size(); ++i )
 			os << oa[i] << " ";
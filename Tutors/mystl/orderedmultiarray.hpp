@@ -3,10 +3,11 @@
 #define _ORDEREDMULTIARRAY_HPP_
 
 #include "functional.hpp"
+#include "searchlayout.hpp"
 
 namespace mystl
 {
-	template <typename value_type, typename compare = default_less<value_type> >
+	template <typename value_type, typename compare = default_less<value_type>, typename layout = sorted_layout>
 	class orderedmultiarray
 	{
 	private:
@@ -14,10 +15,13 @@ namespace mystl
 		size_t mycap;
 		size_t mysize;
 
+		mutable typename layout::template index<value_type, compare> myindex;
+
 		size_t _find(const value_type& value) const;
+		size_t _lookup(const value_type& value) const;
 
 	public:
-		typedef qpair<size_t, size_t> pairii;
+		typedef std::pair<size_t, size_t> pairii;
 		static const size_t npos = 0xffffffff;
 
 		compare comp;
@@ -28,6 +32,12 @@ namespace mystl
 
 		size_t insert(const value_type& value);
 
+		template <typename iterator_type>
+		void assign(iterator_type first, iterator_type last);
+
+		template <typename iterator_type>
+		void insert(iterator_type first, iterator_type last);
+
 		void erase(const value_type& value);
 		void reserve(size_t newcap);
 		void destroy();
@@ -51,16 +61,16 @@ namespace mystl
 		}
 	};
 
-	template <typename value_type, typename compare>
-	orderedmultiarray<value_type, compare>::orderedmultiarray()
+	template <typename value_type, typename compare, typename layout>
+	orderedmultiarray<value_type, compare, layout>::orderedmultiarray()
 	{
 		data = 0;
 		mysize = 0;
 		mycap = 0;
 	}
 	
-	template <typename value_type, typename compare>
-	orderedmultiarray<value_type, compare>::orderedmultiarray(const orderedmultiarray& other)
+	template <typename value_type, typename compare, typename layout>
+	orderedmultiarray<value_type, compare, layout>::orderedmultiarray(const orderedmultiarray& other)
 	{
 		data = 0;
 		mysize = 0;
@@ -69,14 +79,14 @@ namespace mystl
 		this->operator =(other);
 	}
 	
-	template <typename value_type, typename compare>
-	orderedmultiarray<value_type, compare>::~orderedmultiarray()
+	template <typename value_type, typename compare, typename layout>
+	orderedmultiarray<value_type, compare, layout>::~orderedmultiarray()
 	{
 		destroy();
 	}
 	
-	template <typename value_type, typename compare>
-	size_t orderedmultiarray<value_type, compare>::_find(const value_type& value) const
+	template <typename value_type, typename compare, typename layout>
+	size_t orderedmultiarray<value_type, compare, layout>::_find(const value_type& value) const
 	{
 		size_t low = 0;
 		size_t high = mysize;
@@ -96,12 +106,21 @@ namespace mystl
 	
 		return low;
 	}
+
+	template <typename value_type, typename compare, typename layout>
+	size_t orderedmultiarray<value_type, compare, layout>::_lookup(const value_type& value) const
+	{
+		// same as _find(), but through the search index (if any)
+		size_t i = myindex.search(data, mysize, value, comp);
+		return (i == layout::template index<value_type, compare>::npos ? _find(value) : i);
+	}
 	
-	template <typename value_type, typename compare>
-	size_t orderedmultiarray<value_type, compare>::insert(const value_type& value)
+	template <typename value_type, typename compare, typename layout>
+	size_t orderedmultiarray<value_type, compare, layout>::insert(const value_type& value)
 	{
 		size_t i = 0;
 
+		myindex.invalidate();
 		reserve(mysize + 1);
 
 		if( mysize > 0 )
@@ -124,13 +143,46 @@ namespace mystl
 		return i;
 	}
 	
-	template <typename value_type, typename compare>
-	void orderedmultiarray<value_type, compare>::erase(const value_type& value)
+	template <typename value_type, typename compare, typename layout>
+	template <typename iterator_type>
+	void orderedmultiarray<value_type, compare, layout>::assign(iterator_type first, iterator_type last)
+	{
+		// O(N log N) instead of N inserts
+		clear();
+		insert(first, last);
+	}
+
+	template <typename value_type, typename compare, typename layout>
+	template <typename iterator_type>
+	void orderedmultiarray<value_type, compare, layout>::insert(iterator_type first, iterator_type last)
+	{
+		// NOTE: forward iterators, not into the array; append, sort the new part, then merge
+		size_t oldsize = mysize;
+
+		myindex.invalidate();
+		reserve(mysize + std::distance(first, last));
+
+		for( ; first != last; ++first )
+		{
+			new(data + mysize) value_type(*first);
+			++mysize;
+		}
+
+		std::sort(data + oldsize, data + mysize, comp);
+
+		if( oldsize > 0 )
+			std::inplace_merge(data, data + oldsize, data + mysize, comp);
+	}
+	
+	template <typename value_type, typename compare, typename layout>
+	void orderedmultiarray<value_type, compare, layout>::erase(const value_type& value)
 	{
 		pairii p = equal_range(value);
 
 		if( p.first != npos )
 		{
+			myindex.invalidate();
+
 			size_t count = (mysize - p.second);
 
 			for( size_t j = 0; j < count; ++j )
@@ -146,8 +198,8 @@ namespace mystl
 		}
 	}
 	
-	template <typename value_type, typename compare>
-	void orderedmultiarray<value_type, compare>::reserve(size_t newcap)
+	template <typename value_type, typename compare, typename layout>
+	void orderedmultiarray<value_type, compare, layout>::reserve(size_t newcap)
 	{
 		if( mycap < newcap )
 		{
@@ -170,8 +222,8 @@ namespace mystl
 		}
 	}
 	
-	template <typename value_type, typename compare>
-	void orderedmultiarray<value_type, compare>::destroy()
+	template <typename value_type, typename compare, typename layout>
+	void orderedmultiarray<value_type, compare, layout>::destroy()
 	{
 		if( data )
 		{
@@ -184,30 +236,34 @@ namespace mystl
 		data = 0;
 		mysize = 0;
 		mycap = 0;
+
+		myindex.destroy();
 	}
 	
-	template <typename value_type, typename compare>
-	void orderedmultiarray<value_type, compare>::clear()
+	template <typename value_type, typename compare, typename layout>
+	void orderedmultiarray<value_type, compare, layout>::clear()
 	{
 		for( size_t i = 0; i < mysize; ++i )
 			(data + i)->~value_type();
 
 		mysize = 0;
+		myindex.invalidate();
 	}
 	
-	template <typename value_type, typename compare>
-	void orderedmultiarray<value_type, compare>::pop_back()
+	template <typename value_type, typename compare, typename layout>
+	void orderedmultiarray<value_type, compare, layout>::pop_back()
 	{
 		if( mysize > 0 )
 		{
+			myindex.invalidate();
 			--mysize;
 			(data + mysize)->~value_type();
 		}
 	}
 
-	template <typename value_type, typename compare>
-	typename orderedmultiarray<value_type, compare>::pairii
-	orderedmultiarray<value_type, compare>::equal_range(const value_type& value) const
+	template <typename value_type, typename compare, typename layout>
+	typename orderedmultiarray<value_type, compare, layout>::pairii
+	orderedmultiarray<value_type, compare, layout>::equal_range(const value_type& value) const
 	{
 		pairii range;
 
@@ -216,7 +272,7 @@ namespace mystl
 
 		if( mysize > 0 )
 		{
-			range.first = _find(value);
+			range.first = _lookup(value);
 
 			if( range.first < mysize )
 			{
@@ -254,20 +310,20 @@ namespace mystl
 		return range;
 	}
 	
-	template <typename value_type, typename compare>
-	size_t orderedmultiarray<value_type, compare>::find(const value_type& value) const
+	template <typename value_type, typename compare, typename layout>
+	size_t orderedmultiarray<value_type, compare, layout>::find(const value_type& value) const
 	{
 		return lower_bound(value);
 	}
 	
-	template <typename value_type, typename compare>
-	size_t orderedmultiarray<value_type, compare>::lower_bound(const value_type& value) const
+	template <typename value_type, typename compare, typename layout>
+	size_t orderedmultiarray<value_type, compare, layout>::lower_bound(const value_type& value) const
 	{
 		// returns the first that is greater or equal
 		if( mysize == 0 )
 			return 0;
 
-		size_t ind = _find(value);
+		size_t ind = _lookup(value);
 
 		if( ind < mysize )
 		{
@@ -295,14 +351,14 @@ namespace mystl
 		return npos;
 	}
 	
-	template <typename value_type, typename compare>
-	size_t orderedmultiarray<value_type, compare>::upper_bound(const value_type& value) const
+	template <typename value_type, typename compare, typename layout>
+	size_t orderedmultiarray<value_type, compare, layout>::upper_bound(const value_type& value) const
 	{
 		// returns the first that is greater
 		if( mysize == 0 )
 			return 0;
 
-		size_t ind = _find(value);
+		size_t ind = _lookup(value);
 
 		if( ind < mysize )
 		{
@@ -332,8 +388,8 @@ namespace mystl
 		return npos;
 	}
 	
-	template <typename value_type, typename compare>
-	orderedmultiarray<value_type, compare>& orderedmultiarray<value_type, compare>::operator =(const orderedmultiarray& other)
+	template <typename value_type, typename compare, typename layout>
+	orderedmultiarray<value_type, compare, layout>& orderedmultiarray<value_type, compare, layout>::operator =(const orderedmultiarray& other)
 	{
 		if( &other == this )
 			return *this;
@@ -349,8 +405,8 @@ namespace mystl
 		return *this;
 	}
 	
-	template <typename value_type, typename compare>
-	std::ostream& operator <<(std::ostream& os, orderedmultiarray<value_type, compare>& oa)
+	template <typename value_type, typename compare, typename layout>
+	std::ostream& operator <<(std::ostream& os, orderedmultiarray<value_type, compare, layout>& oa)
 	{
 		for( size_t i = 0; i < oa.size(); ++i )
 			os << oa.data[i] << " ";
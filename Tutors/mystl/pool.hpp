@@ -0,0 +1,166 @@
+#ifndef _POOL_HPP_
+#define _POOL_HPP_
+
+#include <cstdlib>
+
+#define POOL_FIRST_SLAB		64
+#define POOL_MAX_SLAB		4096
+
+namespace mystl
+{
+	// fixed size blocks carved out of growing slabs, freed blocks are reused first
+	template <typename T>
+	class slab_pool
+	{
+	private:
+		union block
+		{
+			block* next;
+			double align;
+			char data[sizeof(T)];
+		};
+
+		struct slab
+		{
+			slab* next;
+			slab* align;	// blocks start on 8 bytes on 32 bit too
+			// blocks follow
+		};
+
+		slab* slabs;
+		block* freelist;
+		size_t slabsize;
+
+		slab_pool(const slab_pool&);
+		slab_pool& operator =(const slab_pool&);
+
+		void _grow()
+		{
+			slab* s = (slab*)malloc(sizeof(slab) + slabsize * sizeof(block));
+			block* first = (block*)(s + 1);
+
+			s->next = slabs;
+			slabs = s;
+
+			// in address order, so consecutive allocations are neighbours
+			for( size_t i = 0; i < slabsize - 1; ++i )
+				first[i].next = &first[i + 1];
+
+			first[slabsize - 1].next = freelist;
+			freelist = first;
+
+			if( slabsize < POOL_MAX_SLAB )
+				slabsize *= 2;
+		}
+
+	public:
+		slab_pool()
+			: slabs(0), freelist(0), slabsize(POOL_FIRST_SLAB) {}
+
+		~slab_pool()
+		{
+			// NOTE: doesn't call destructors, the owner must have deallocated everything
+			while( slabs )
+			{
+				slab* next = slabs->next;
+
+				free(slabs);
+				slabs = next;
+			}
+		}
+
+		inline T* allocate()
+		{
+			if( !freelist )
+				_grow();
+
+			block* b = freelist;
+			freelist = b->next;
+
+			return (T*)b;
+		}
+
+		inline void deallocate(T* ptr)
+		{
+			block* b = (block*)ptr;
+
+			b->next = freelist;
+			freelist = b;
+		}
+	};
+
+	// one heap allocation per node
+	struct default_allocator
+	{
+		template <typename T>
+		class pool
+		{
+		public:
+			inline T* allocate() {
+				return (T*)::operator new(sizeof(T));
+			}
+
+			inline void deallocate(T* ptr) {
+				::operator delete(ptr);
+			}
+
+			inline bool compatible(const pool&) const {
+				return true;
+			}
+		};
+	};
+
+	// every container has its own slabs, freed with the container
+	struct pool_allocator
+	{
+		template <typename T>
+		class pool
+		{
+		private:
+			slab_pool<T> slabs;
+
+		public:
+			inline T* allocate() {
+				return slabs.allocate();
+			}
+
+			inline void deallocate(T* ptr) {
+				slabs.deallocate(ptr);
+			}
+
+			inline bool compatible(const pool& other) const {
+				return (this == &other);
+			}
+		};
+	};
+
+	// one set of slabs for every container of the same node type
+	// NOTE: not thread safe, the slabs are never released (containers with static storage duration can outlive any static)
+	struct shared_pool_allocator
+	{
+		template <typename T>
+		class pool
+		{
+		private:
+			static slab_pool<T>& _instance() {
+				static slab_pool<T>* slabs = new slab_pool<T>();
+				return *slabs;
+			}
+
+		public:
+			inline T* allocate() {
+				return _instance().allocate();
+			}
+
+			inline void deallocate(T* ptr) {
+				_instance().deallocate(ptr);
+			}
+
+			inline bool compatible(const pool&) const {
+				return true;
+			}
+		};
+	};
+}
+
+#endif
@@ -0,0 +1,173 @@
+#ifndef _SEARCHLAYOUT_HPP_
+#define _SEARCHLAYOUT_HPP_
+
+#include <vector>
+#include <xmmintrin.h>
+
+#ifdef _MSC_VER
+#	include <intrin.h>
+#endif
+
+// a lookup after this many others since the last modification rebuilds the index (size / 2^N)
+#define EYTZINGER_REBUILD_SHIFT	4
+
+namespace mystl
+{
+	inline unsigned long trailing_zeros(size_t x)
+	{
+		// x must not be zero
+#ifdef _MSC_VER
+		unsigned long ret;
+
+#	ifdef _WIN64
+		_BitScanForward64(&ret, x);
+#	else
+		_BitScanForward(&ret, x);
+#	endif
+
+		return ret;
+#else
+		return (unsigned long)__builtin_ctzll((unsigned long long)x);
+#endif
+	}
+
+	inline unsigned long highest_bit(size_t x)
+	{
+		// x must not be zero
+#ifdef _MSC_VER
+		unsigned long ret;
+
+#	ifdef _WIN64
+		_BitScanReverse64(&ret, x);
+#	else
+		_BitScanReverse(&ret, x);
+#	endif
+
+		return ret;
+#else
+		return 63 - (unsigned long)__builtin_clzll((unsigned long long)x);
+#endif
+	}
+
+	// default: binary search on the sorted array itself
+	struct sorted_layout
+	{
+		template <typename value_type, typename compare>
+		class index
+		{
+		public:
+			static const size_t npos = 0xffffffff;
+
+			inline void invalidate() {
+			}
+
+			inline void destroy() {
+			}
+
+			inline size_t search(const value_type*, size_t, const value_type&, const compare&) {
+				return npos;
+			}
+		};
+	};
+
+	// keeps a copy of the keys in BFS order (children of k are 2k and 2k + 1), so the
+	// top of the tree shares cache lines and the next levels can be prefetched
+	struct eytzinger_layout
+	{
+		template <typename value_type, typename compare>
+		class index
+		{
+		private:
+			// nodes in one cache line, a power of two
+			static const size_t blocksize =
+				(sizeof(value_type) <= 4 ? 16 :
+				(sizeof(value_type) <= 8 ? 8 :
+				(sizeof(value_type) <= 16 ? 4 :
+				(sizeof(value_type) <= 32 ? 2 : 1))));
+
+			std::vector<value_type> keys;	// keys[0] is unused
+			size_t lookups;
+			size_t lastlevel;				// depth of the (partial) last level
+			size_t lastcount;				// nodes on it
+			bool valid;
+
+			size_t _rank(size_t k) const
+			{
+				// position of node k in the sorted array; as if the tree was complete,
+				// minus the missing last level nodes that would come before it
+				size_t depth = highest_bit(k);
+				size_t rank = ((2 * (k - ((size_t)1 << depth)) + 1) << (lastlevel - depth)) - 1;
+				size_t before = (rank + 1) / 2;
+
+				return rank - (before > lastcount ? before - lastcount : 0);
+			}
+
+		public:
+			static const size_t npos = 0xffffffff;
+
+			index()
+				: lookups(0), lastlevel(0), lastcount(0), valid(false) {}
+
+			inline void invalidate()
+			{
+				lookups = 0;
+				valid = false;
+			}
+
+			void destroy()
+			{
+				std::vector<value_type>().swap(keys);
+
+				invalidate();
+			}
+
+			void rebuild(const value_type* data, size_t size)
+			{
+				lastlevel = highest_bit(size);
+				lastcount = size - (((size_t)1 << lastlevel) - 1);
+
+				keys.clear();
+				keys.reserve(size + 1);
+				keys.push_back(data[0]);
+
+				for( size_t k = 1; k <= size; ++k )
+					keys.push_back(data[_rank(k)]);
+
+				valid = true;
+			}
+
+			size_t search(const value_type* data, size_t size, const value_type& value, const compare& comp)
+			{
+				// returns the first that is not less, or npos if there is no index (yet)
+				if( size == 0 )
+					return npos;
+
+				if( !valid )
+				{
+					// NOTE: a batch of modifications doesn't rebuild on every lookup in between
+					if( ++lookups <= (size >> EYTZINGER_REBUILD_SHIFT) )
+						return npos;
+
+					rebuild(data, size);
+				}
+
+				const value_type* nodes = &keys[0];
+				size_t k = 1;
+
+				while( k <= size )
+				{
+					// the 16th (8th...) descendant of k is in one cache line
+					_mm_prefetch((const char*)(nodes + k * blocksize), _MM_HINT_T0);
+					k = 2 * k + (size_t)comp(nodes[k], value);
+				}
+
+				// cancel the right turns after the last left turn
+				k >>= trailing_zeros(~k) + 1;
+
+				return (k == 0 ? size : _rank(k));
+			}
+		};
+	};
+}
+
+#endif
@@ -1,6 +1,11 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <ctime>
+#include <cstdio>
 
 #define _CRTDBG_MAP_ALLOC
 #include <crtdbg.h>
@@ -29,6 +34,130 @@ struct test_struct
 	}
 };
 
+template <typename value_type>
+void Benchmark(const char* name, const std::vector<value_type>& values)
+{
+	// build a sorted set one by one, then look up every value
+	mystl::orderedarray<value_type> oa;
+	mystl::orderedarray<value_type> bulk;
+	std::set<value_type> set;
+	std::vector<value_type> vec;
+	size_t found[4] = { 0, 0, 0, 0 };
+	clock_t elapsed[4][2];
+	clock_t start;
+
+	start = clock();
+
+	for( size_t i = 0; i < values.size(); ++i )
+		oa.insert(values[i]);
+
+	elapsed[0][0] = clock() - start;
+	start = clock();
+
+	for( size_t i = 0; i < values.size(); ++i )
+		found[0] += (oa.find(values[i]) != mystl::orderedarray<value_type>::npos);
+
+	elapsed[0][1] = clock() - start;
+	start = clock();
+
+	for( size_t i = 0; i < values.size(); ++i )
+		set.insert(values[i]);
+
+	elapsed[1][0] = clock() - start;
+	start = clock();
+
+	for( size_t i = 0; i < values.size(); ++i )
+		found[1] += (set.find(values[i]) != set.end());
+
+	elapsed[1][1] = clock() - start;
+	start = clock();
+
+	// all at once
+	vec = values;
+
+	std::sort(vec.begin(), vec.end());
+	vec.erase(std::unique(vec.begin(), vec.end()), vec.end());
+
+	elapsed[2][0] = clock() - start;
+	start = clock();
+
+	for( size_t i = 0; i < values.size(); ++i )
+		found[2] += std::binary_search(vec.begin(), vec.end(), values[i]);
+
+	elapsed[2][1] = clock() - start;
+	start = clock();
+
+	// same, but sorted by the container
+	bulk.assign(values.begin(), values.end());
+
+	elapsed[3][0] = clock() - start;
+	start = clock();
+
+	for( size_t i = 0; i < values.size(); ++i )
+		found[3] += (bulk.find(values[i]) != mystl::orderedarray<value_type>::npos);
+
+	elapsed[3][1] = clock() - start;
+
+	const char* names[] = { "orderedarray", "std::set", "std::vector + sort", "orderedarray::assign" };
+
+	std::cout << name << ", " << values.size() << " values (" << oa.size() << " unique):\n";
+
+	for( int i = 0; i < 4; ++i )
+	{
+		std::cout << "  " << names[i] << ": insert " << (elapsed[i][0] * 1000 / CLOCKS_PER_SEC) << " ms, find "
+			<< (elapsed[i][1] * 1000 / CLOCKS_PER_SEC) << " ms" << (found[i] == values.size() ? "" : " (MISMATCH)") << "\n";
+	}
+
+	if( oa.size() != set.size() || oa.size() != vec.size() || oa.size() != bulk.size() )
+		std::cout << "  size mismatch!\n";
+}
+
+template <typename layout>
+double Benchmark_Lookup(const std::vector<int>& keys, const std::vector<int>& queries, size_t& found)
+{
+	mystl::orderedarray<int, mystl::default_less<int>, layout> oa;
+	clock_t start;
+
+	oa.assign(keys.begin(), keys.end());
+	found = 0;
+
+	// first lookup builds the index
+	oa.find(queries[0]);
+	start = clock();
+
+	for( size_t i = 0; i < queries.size(); ++i )
+		found += (oa.find(queries[i]) != oa.npos);
+
+	return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / queries.size();
+}
+
+void Benchmark_Layouts()
+{
+	// random lookups in growing tables, half of them hit
+	std::vector<int> keys;
+	std::vector<int> queries(2000000);
+	size_t found[2];
+	double elapsed[2];
+
+	std::cout << "\nLookup (ns per find), sorted vs. eytzinger layout:\n";
+
+	for( size_t count = 1000; count <= 10000000; count *= 10 )
+	{
+		keys.resize(count);
+
+		for( size_t i = 0; i < count; ++i )
+			keys[i] = (int)(i * 2);
+
+		for( size_t i = 0; i < queries.size(); ++i )
+			queries[i] = (int)((((size_t)rand() << 15) | rand()) % (count * 2));
+
+		elapsed[0] = Benchmark_Lookup<mystl::sorted_layout>(keys, queries, found[0]);
+		elapsed[1] = Benchmark_Lookup<mystl::eytzinger_layout>(keys, queries, found[1]);
+
+		printf("  %8u keys: %6.1f vs. %6.1f%s\n", (unsigned int)count, elapsed[0], elapsed[1], (found[0] == found[1] ? "" : " (MISMATCH)"));
+	}
+}
+
 int main()
 {
 	{
@@ -166,6 +295,30 @@ int main()
         a2.erase(10);
     }
 
+    {
+        std::vector<int> ints(50000);
+        std::vector<std::string> strings(20000);
+        char buff[32];
+
+        srand(1234);
+
+        for( size_t i = 0; i < ints.size(); ++i )
+            ints[i] = (int)(((unsigned int)rand() << 15) ^ (unsigned int)rand());
+
+        for( size_t i = 0; i < strings.size(); ++i )
+        {
+            sprintf(buff, "item_%08u", ((unsigned int)rand() << 15) ^ (unsigned int)rand());
+            strings[i] = buff;
+        }
+
+        std::cout << "\n";
+
+        Benchmark("int", ints);
+        Benchmark("std::string", strings);
+
+        Benchmark_Layouts();
+    }
+
     // memory leakek
     _CrtDumpMemoryLeaks();
 
@@ -1,37 +1,21 @@
 //=============================================================================================================
-#include "interpreter.h"
-#include "parser.hpp"
+#include "../myinterpreter/interpreter.h"
+#include "lexer.cpp"
+#include "parser.cpp"
 
-extern int yyflex();
-extern char* yytext;
-extern Interpreter* interpreter;
-
-std::string& replace(std::string& out, const std::string& what, const std::string& with, const std::string& instr)
-{
-    size_t pos = instr.find(what);
-    out = instr;
-
-    while( pos != std::string::npos )
-    {
-        out.replace(pos, what.length(), with);
-        pos = out.find(what, pos + with.length());
-    }
-
-    return out;
-}
+// NOTE: only the front end lives here, the VM is the one in myinterpreter
 //=============================================================================================================
-int yylex()
+int yylex(YYSTYPE* lvalp, YYLTYPE* llocp, void* scanner)
 {
-    int ret = yyflex();
+    int ret = yyflex(lvalp, llocp, scanner);
 
     switch( ret )
     {
     case NUMBER:
     case IDENTIFIER:
     case STRING:
-        yylval.text_t = new std::string(yytext);
-        replace(*yylval.text_t, "\\n", "\n", yytext);
-        interpreter->garbage.push_back(yylval.text_t);
+        lvalp->text_t = yyget_extra(scanner)->Allocate<std::string>();
+        replace(*lvalp->text_t, "\\n", "\n", yyget_text(scanner));
         break;
 
     default:
@@ -41,8 +25,25 @@ int yylex()
     return ret;
 }
 //=============================================================================================================
-void yyerror(const char *s)
+void yyerror(YYLTYPE* llocp, Interpreter* interpreter, void* scanner, const char* s)
+{
+    std::cout << "* ERROR: ln " << llocp->first_line << ": " << s << "\n";
+}
+//=============================================================================================================
+int Interpreter::Parse_Buffer(char* buffer, size_t size)
 {
-    std::cout << "* ERROR: ln " << yylloc.first_line << ": " << s << "\n";
+    yyscan_t scanner = 0;
+
+    nassert(1, "Interpreter::Parse_Buffer(): Could not create scanner", yylex_init_extra(this, &scanner) != 0);
+
+    YY_BUFFER_STATE state = yy_scan_buffer(buffer, size, scanner);
+    yyset_lineno(1, scanner);
+
+    int ret = yyparse(this, scanner);
+
+    yy_delete_buffer(state, scanner);
+    yylex_destroy(scanner);
+
+    return ret;
 }
 //=============================================================================================================
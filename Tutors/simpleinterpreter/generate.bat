@@ -1,4 +1,7 @@
 @echo off
+REM lexer.l needs flex 2.5.35 or newer (reentrant, bison-bridge)
+REM parser.y needs bison 2.4.1 or newer (pure parser, several parse-params)
+
 ..\..\flex\bin\flex -olexer.cpp lexer.l
 
 REM bisonnak sajnos kell az m4 ezert hulyulni kell
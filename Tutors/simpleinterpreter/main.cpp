@@ -1,6 +1,6 @@
 
 #include <iostream>
-#include "interpreter.h"
+#include "../myinterpreter/interpreter.h"
 
 #define _CRTDBG_MAP_ALLOC
 #include <crtdbg.h>
@@ -9,10 +9,17 @@ int main()
 {
 	{
 		Interpreter ip;
-		ip.Compile("../simpleinterpreter/programs/helloworld.p");
 
-		std::cout << "\n";
-		ip.Run();
+		if( ip.Compile("../simpleinterpreter/programs/helloworld.p") && ip.Link() )
+		{
+			std::cout << "\n";
+			ip.Disassemble();
+
+			// same engines as myinterpreter
+			std::cout << "\n";
+			ip.SetExecutionMode(Exec_Threaded);
+			ip.Run();
+		}
 	}
 
 	_CrtDumpMemoryLeaks();
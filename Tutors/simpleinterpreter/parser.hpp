@@ -1,23 +1,22 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* A Bison parser, made by GNU Bison 2.4.1.  */
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton interface for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -28,70 +27,86 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
 
-/* Tokens.  */
+#ifndef YY_YY_PARSER_HPP_INCLUDED
+# define YY_YY_PARSER_HPP_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     QUOTE = 258,
-     LRB = 259,
-     RRB = 260,
-     LB = 261,
-     RB = 262,
-     LSB = 263,
-     RSB = 264,
-     SEMICOLON = 265,
-     EQ = 266,
-     COMMA = 267,
-     PRINT = 268,
-     INT = 269,
-     NUMBER = 270,
-     IDENTIFIER = 271,
-     STRING = 272
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    QUOTE = 258,                   /* QUOTE  */
+    LRB = 259,                     /* LRB  */
+    RRB = 260,                     /* RRB  */
+    LB = 261,                      /* LB  */
+    RB = 262,                      /* RB  */
+    LSB = 263,                     /* LSB  */
+    RSB = 264,                     /* RSB  */
+    SEMICOLON = 265,               /* SEMICOLON  */
+    EQ = 266,                      /* EQ  */
+    COMMA = 267,                   /* COMMA  */
+    PRINT = 268,                   /* PRINT  */
+    INT = 269,                     /* INT  */
+    NUMBER = 270,                  /* NUMBER  */
+    IDENTIFIER = 271,              /* IDENTIFIER  */
+    STRING = 272                   /* STRING  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
-
-
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-
-/* Line 1676 of yacc.c  */
-#line 25 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\simpleinterpreter/parser.y"
+#line 24 "parser.y"
 
     std::string* text_t;
 
+#line 85 "parser.hpp"
 
-
-/* Line 1676 of yacc.c  */
-#line 75 "C:\\Windows.old\\Users\\Asylum\\Documents\\Save\\Projects\\C++\\Tutors\\simpleinterpreter/parser.hpp"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
-extern YYSTYPE yylval;
-
+/* Location type.  */
 #if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE
+typedef struct YYLTYPE YYLTYPE;
+struct YYLTYPE
 {
   int first_line;
   int first_column;
   int last_line;
   int last_column;
-} YYLTYPE;
-# define yyltype YYLTYPE /* obsolescent; will be withdrawn */
+};
 # define YYLTYPE_IS_DECLARED 1
 # define YYLTYPE_IS_TRIVIAL 1
 #endif
 
-extern YYLTYPE yylloc;
 
+
+
+int yyparse (Interpreter* interpreter, void* scanner);
+
+
+#endif /* !YY_YY_PARSER_HPP_INCLUDED  */
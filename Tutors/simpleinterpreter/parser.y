@@ -1,8 +1,12 @@
 %locations
+%pure-parser
+%parse-param {Interpreter* interpreter}
+%parse-param {void* scanner}
+%lex-param {void* scanner}
 
 %{
 
-#include "interpreter.h"
+#include "../myinterpreter/interpreter.h"
 
 #ifdef _MSC_VER
 #   pragma warning(push)
@@ -14,11 +18,6 @@
 #   pragma warning(disable : 4996)
 #endif
 
-int yylex();
-void yyerror(const char *s);
-
-Interpreter* interpreter = 0;
-
 %}
 
 %union
@@ -26,6 +25,11 @@ Interpreter* interpreter = 0;
     std::string* text_t;
 }
 
+%{
+int yylex(YYSTYPE* lvalp, YYLTYPE* llocp, void* scanner);
+void yyerror(YYLTYPE* llocp, Interpreter* interpreter, void* scanner, const char* s);
+%}
+
 %token             QUOTE
 %token             LRB
 %token             RRB
@@ -50,18 +54,63 @@ Interpreter* interpreter = 0;
 program: function
          {
              parser_out("program -> function");
+
+             symbol_desc* func = interpreter->current_func;
+
+             if( func->name == "main" )
+                 interpreter->entry = interpreter->program.size();
+
+             func->address = interpreter->program.size();
+             interpreter->program.splice(func->bytecode);
+             interpreter->functions.push_back(func);
+
+             interpreter->current_func = 0;
+             nassert(0, "Unresolved external 'main'", interpreter->entry == -1);
          }
 ;
 
 function: function_header LB function_body RB
           {
               parser_out("function -> function_header LB function_body RB");
+
+              // there is no return statement, functions return 0
+              bytestream& code = interpreter->current_func->bytecode;
+
+              code << OP(OP_MOV_RS) << REG(EAX) << (int)0;
+              code << OP(OP_MOV_RR) << REG(ESP) << REG(EBP);
+              code << OP(OP_POP) << REG(EBP) << NIL;
+              code << OP(OP_POP) << REG(EIP) << NIL;
           }
 ;
 
 function_header: typename IDENTIFIER LRB argument_list RRB
                  {
                      parser_out("function_header -> typename IDENTIFIER LRB argument_list RRB");
+
+                     symbol_desc* func = interpreter->Allocate<symbol_desc>();
+
+                     func->name = *$2;
+                     func->type = Type_Integer;
+                     func->isfunc = true;
+                     func->address = UNKNOWN_ADDR;
+
+                     interpreter->scopes[0][*$2] = func;
+                     interpreter->current_func = func;
+                     interpreter->Deallocate($2);
+
+                     // same frame as in myinterpreter, main returns to CODE_SIZE
+                     bytestream& code = func->bytecode;
+
+                     code.mark(0, @2.first_line);
+
+                     if( func->name == "main" )
+                     {
+                         code << OP(OP_MOV_RS) << REG(EAX) << (int)CODE_SIZE;
+                         code << OP(OP_PUSH) << REG(EAX) << NIL;
+                     }
+
+                     code << OP(OP_PUSH) << REG(EBP) << NIL;
+                     code << OP(OP_MOV_RR) << REG(EBP) << REG(ESP);
                  }
 ;
 
@@ -99,7 +148,15 @@ statement: print
 print: PRINT string
        {
            parser_out("print -> PRINT string");
-           interpreter->AddCodeEntry(OP_PRINT, interpreter->Allocate<std::string>($2), 0);
+
+           // code refers to strings by index
+           bytestream& code = interpreter->current_func->bytecode;
+
+           code.mark(code.size(), @1.first_line);
+           code << OP(OP_PRINT_M) << (int)interpreter->strings.size() << REG(0);
+
+           interpreter->strings.push_back(*$2);
+           interpreter->Deallocate($2);
        }
 ;
 